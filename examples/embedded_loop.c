@@ -0,0 +1,47 @@
+#include "sdl_graphs.h"
+#include <math.h>
+
+#define N 500
+
+int main(int argc, char* argv[]) {
+    if (!SDL_Init(SDL_INIT_VIDEO) || TTF_Init() < 0) {
+        return -1;
+    }
+
+    Figure* fig = subplots("Simulation", 800, 600, 1);
+    figure_set_vsync(fig, 1); // Let the display pace the loop
+
+    float x[N], y[N];
+    for (int i = 0; i < N; i++) {
+        x[i] = i * 0.02f;
+        y[i] = 0.0f;
+    }
+    plot(&fig->axes[0], x, y, N, (SDL_Color){50, 100, 255, 255});
+    fig->axes[0].y_min = -1.0f;
+    fig->axes[0].y_max = 1.0f;
+    set_title(&fig->axes[0], "Host-driven loop");
+
+    // The application owns the loop: step the simulation, then draw
+    float t = 0.0f;
+    SDL_Event event;
+    while (!figure_should_close(fig)) {
+        while (SDL_PollEvent(&event)) {
+            figure_handle_event(fig, &event);
+        }
+
+        t += 0.016f;
+        for (int i = 0; i < N; i++) {
+            y[i] = sinf(x[i] * 2.0f - t * 3.0f) * expf(-x[i] * 0.2f);
+        }
+        figure_mark_dirty(fig); // y changed in place: refresh the hover index and batches
+
+        figure_render(fig);
+    }
+
+    // Unlike show(), tear-down is up to the host
+    destroy_figure(fig);
+
+    TTF_Quit();
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "sdl_graphs.h"
+#include "sdl_figure_manager.h"
+#include <math.h>
+
+int main(int argc, char* argv[]) {
+    if (!SDL_Init(SDL_INIT_VIDEO) || TTF_Init() < 0) {
+        return -1;
+    }
+
+    static float x[200], y[3][200];
+    for (int i = 0; i < 200; i++) {
+        x[i] = i * 0.05f;
+        y[0][i] = sinf(x[i]);
+        y[1][i] = cosf(x[i]);
+        y[2][i] = sinf(x[i]) * cosf(2.0f * x[i]);
+    }
+
+    const char* titles[] = {"Channel A", "Channel B", "Channel C"};
+    SDL_Color colors[] = {{255, 50, 50, 255}, {50, 100, 255, 255}, {50, 200, 50, 255}};
+
+    // Three independent windows, one event loop
+    FigureManager* mgr = create_figure_manager();
+    for (int i = 0; i < 3; i++) {
+        Figure* fig = subplots(titles[i], 500, 350, 1);
+        plot(&fig->axes[0], x, y[i], 200, colors[i]);
+        set_grid(&fig->axes[0], true);
+        manager_add(mgr, fig);
+    }
+
+    manager_run(mgr); // Returns once every window is closed
+    destroy_figure_manager(mgr);
+
+    TTF_Quit();
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "sdl_graphs.h"
+#include "sdl_stream.h"
+#include <math.h>
+
+static SDL_AtomicInt keep_running;
+
+// Simulated acquisition thread: 1 kHz samples pushed in blocks of 10
+static int acquire(void* data) {
+    SeriesStream* stream = (SeriesStream*)data;
+    float x[10], y[10];
+    int n = 0;
+    while (SDL_GetAtomicInt(&keep_running)) {
+        for (int i = 0; i < 10; i++, n++) {
+            x[i] = n * 0.001f;
+            y[i] = sinf(n * 0.01f) + 0.1f * sinf(n * 0.37f);
+        }
+        stream_push(stream, x, y, 10);
+        SDL_Delay(10);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (!SDL_Init(SDL_INIT_VIDEO) || TTF_Init() < 0) {
+        return -1;
+    }
+
+    Figure* fig = subplots("Live Acquisition", 800, 600, 1);
+    SeriesStream* stream = plot_stream(&fig->axes[0], 5000, (SDL_Color){50, 200, 50, 255});
+    set_title(&fig->axes[0], "Last 5 seconds");
+    set_grid(&fig->axes[0], true);
+
+    SDL_SetAtomicInt(&keep_running, 1);
+    SDL_Thread* producer = SDL_CreateThread(acquire, "acquire", stream);
+
+    // Drive the figure ourselves so the producer can be stopped before tear-down
+    SDL_Event event;
+    while (!figure_should_close(fig)) {
+        while (SDL_PollEvent(&event)) {
+            figure_handle_event(fig, &event);
+        }
+        figure_render(fig); // Drains whatever the producer pushed since last frame
+        SDL_Delay(16);
+    }
+
+    SDL_SetAtomicInt(&keep_running, 0);
+    SDL_WaitThread(producer, NULL);
+    destroy_figure(fig);
+
+    TTF_Quit();
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "sdl_graphs.h"
+#include <math.h>
+
+int main(int argc, char* argv[]) {
+    if (!SDL_Init(SDL_INIT_VIDEO) || TTF_Init() < 0) {
+        return -1;
+    }
+
+    Figure* fig = subplots("Telemetry", 1000, 600, 1);
+
+    // Six hours of samples, one per minute, starting 2024-03-01 09:00:00 UTC
+    const double start = 1709283600.0;
+    float t[360], temp[360];
+    for (int i = 0; i < 360; i++) {
+        t[i] = i * 60.0f;  // Seconds since 'start'
+        temp[i] = 20.0f + 5.0f * sinf(i / 45.0f);
+    }
+
+    plot(&fig->axes[0], t, temp, 360, (SDL_Color){255, 120, 0, 255});
+    set_xaxis_time(&fig->axes[0], start); // Ticks read 09:00, 10:00, ...
+    set_title(&fig->axes[0], "Cabinet Temperature");
+    set_xlabel(&fig->axes[0], "Time (UTC)");
+    set_grid(&fig->axes[0], true);
+
+    show(fig);
+
+    TTF_Quit();
+    SDL_Quit();
+    return 0;
+}
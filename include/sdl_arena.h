@@ -0,0 +1,39 @@
+#ifndef SDL_ARENA_H
+#define SDL_ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Default size of the first arena block (grows to the observed peak on reset)
+#define ARENA_DEFAULT_BLOCK_SIZE (256 * 1024)
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next; // Older block (blocks form a stack, newest first)
+    size_t size;             // Usable bytes in this block
+    size_t used;             // Bytes handed out from this block
+} ArenaBlock;
+
+// The "FrameArena" - a bump allocator for per-frame scratch memory
+typedef struct FrameArena {
+    ArenaBlock* head;
+    size_t block_size;  // Minimum size for newly allocated blocks
+    // Statistics
+    size_t bytes_used;  // Bytes handed out since the last reset
+    size_t peak_bytes;  // Highest bytes_used seen over the arena's lifetime
+    size_t capacity;    // Total bytes currently reserved across all blocks
+    int block_count;
+    int overflow_count; // Number of times a frame outgrew the reserved blocks
+    unsigned long frame_count;
+} FrameArena;
+
+void arena_init(FrameArena* arena, size_t block_size);
+void* arena_alloc(FrameArena* arena, size_t size);
+void arena_reset(FrameArena* arena);
+void arena_destroy(FrameArena* arena);
+void arena_print_stats(const FrameArena* arena);
+
+// Convenience wrapper: arena_alloc_array(arena, SDL_FPoint, n)
+#define arena_alloc_array(arena, type, n) ((type*)arena_alloc((arena), sizeof(type) * (size_t)(n)))
+
+#endif
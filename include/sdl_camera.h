@@ -0,0 +1,32 @@
+#ifndef SDL_CAMERA_H
+#define SDL_CAMERA_H
+
+#include "sdl_graphs.h"
+
+// Pixels around a 3D axes' rect kept in its cached image (room for axis labels)
+#define CAMERA_CACHE_MARGIN 64.0f
+
+// Everything a cached 3D image depends on; any difference forces a re-render
+typedef struct {
+    SDL_FRect rect;
+    float phi, theta, zoom, pan_x, pan_y;
+    float x_min, x_max, y_min, y_max, z_min, z_max;
+    int line_count;
+} CameraKey;
+
+// The "AxesCache" - last rendered image of a 3D axes, reused while its view is unchanged
+struct AxesCache {
+    SDL_Texture* texture;
+    int w, h;
+    CameraKey key;
+    bool valid;
+};
+
+int figure_axes_at(Figure* fig, float x, float y);
+bool camera_handle_event(Figure* fig, const SDL_Event* event);
+bool figure_update_camera(Figure* fig);
+void render_axes_3d_cached(Canvas* cv, Axes* ax);
+void axes_invalidate_cache(Axes* ax);
+void axes_release_cache(Axes* ax);
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef SDL_CANVAS_H
+#define SDL_CANVAS_H
+
+#include <stdio.h>
+#include "sdl_graphs.h"
+
+// Drawing primitives every backend implements. All coordinates are in pixels.
+typedef struct CanvasOps {
+    void (*set_color)(Canvas* cv, SDL_Color color);
+    void (*line)(Canvas* cv, float x1, float y1, float x2, float y2);
+    void (*polyline)(Canvas* cv, const SDL_FPoint* pts, int count, float thickness, LineStyle style);
+    void (*rect)(Canvas* cv, const SDL_FRect* rect, bool filled);
+    void (*markers)(Canvas* cv, const SDL_FPoint* centers, int count, float size);
+    void (*geometry)(Canvas* cv, const SDL_Vertex* vertices, int num_vertices, const int* indices, int num_indices);
+    void (*image)(Canvas* cv, SDL_Texture* texture, const SDL_Vertex* vertices, int num_vertices, const int* indices, int num_indices);
+    void (*text)(Canvas* cv, const char* text, float x, float y, bool right_align, SDL_Color color);
+    void (*tick_label)(Canvas* cv, TickCache* tc, int index, float x, float y, bool right_align, SDL_Color color);
+} CanvasOps;
+
+// The "Canvas" - the draw-command target that render_axes_2d/3d and friends emit into
+struct Canvas {
+    const CanvasOps* ops;
+    SDL_Color color;         // Current draw color
+    TTF_Font* font;          // Used for text and text metrics
+    FrameArena* arena;       // Scratch memory for batching
+    SDL_Renderer* renderer;  // SDL backend only
+    FILE* out;               // SVG backend only
+    struct RasterTarget* raster; // Software backend only
+    float width, height;     // Size of the drawing surface
+
+    // Output transform (SDL backend): pixel = coord * scale - origin
+    float scale;
+    float origin_x, origin_y;
+    TTF_Font* text_font;     // Font pre-sized for 'scale' (NULL = use 'font')
+};
+
+void canvas_init_sdl(Canvas* cv, SDL_Renderer* renderer, TTF_Font* font, FrameArena* arena);
+bool canvas_begin_svg(Canvas* cv, FILE* out, float width, float height, TTF_Font* font, FrameArena* arena);
+void canvas_end_svg(Canvas* cv);
+void canvas_set_transform(Canvas* cv, float scale, float origin_x, float origin_y, TTF_Font* text_font);
+
+// Window coordinates -> output pixels under the current transform
+static inline float canvas_px(const Canvas* cv, float x) { return x * cv->scale - cv->origin_x; }
+static inline float canvas_py(const Canvas* cv, float y) { return y * cv->scale - cv->origin_y; }
+static inline bool canvas_is_transformed(const Canvas* cv) {
+    return cv->scale != 1.0f || cv->origin_x != 0.0f || cv->origin_y != 0.0f;
+}
+
+static inline void canvas_set_color(Canvas* cv, SDL_Color color) {
+    cv->color = color;
+    cv->ops->set_color(cv, color);
+}
+static inline void canvas_line(Canvas* cv, float x1, float y1, float x2, float y2) {
+    cv->ops->line(cv, x1, y1, x2, y2);
+}
+static inline void canvas_polyline(Canvas* cv, const SDL_FPoint* pts, int count, float thickness, LineStyle style) {
+    if (count >= 2) cv->ops->polyline(cv, pts, count, thickness, style);
+}
+static inline void canvas_rect(Canvas* cv, const SDL_FRect* rect, bool filled) {
+    cv->ops->rect(cv, rect, filled);
+}
+static inline void canvas_markers(Canvas* cv, const SDL_FPoint* centers, int count, float size) {
+    if (count > 0) cv->ops->markers(cv, centers, count, size);
+}
+static inline void canvas_geometry(Canvas* cv, const SDL_Vertex* vertices, int num_vertices, const int* indices, int num_indices) {
+    if (num_vertices > 0) cv->ops->geometry(cv, vertices, num_vertices, indices, num_indices);
+}
+// Textured geometry. Textures live on the GPU, so only the SDL backend draws them.
+static inline void canvas_image(Canvas* cv, SDL_Texture* texture, const SDL_Vertex* vertices, int num_vertices, const int* indices, int num_indices) {
+    if (texture && num_vertices > 0) cv->ops->image(cv, texture, vertices, num_vertices, indices, num_indices);
+}
+static inline void canvas_text(Canvas* cv, const char* text, float x, float y, bool right_align, SDL_Color color) {
+    if (text) cv->ops->text(cv, text, x, y, right_align, color);
+}
+static inline void canvas_tick_label(Canvas* cv, TickCache* tc, int index, float x, float y, bool right_align, SDL_Color color) {
+    cv->ops->tick_label(cv, tc, index, x, y, right_align, color);
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SDL_CAPTURE_H
+#define SDL_CAPTURE_H
+
+#include <stdint.h>
+#include "sdl_graphs.h"
+
+#define PYRAMID_MAGIC       "SDLGPYR1"
+#define PYRAMID_VERSION     1
+#define PYRAMID_BASE_BLOCK  64   // Samples per level-0 block
+#define PYRAMID_FANOUT      8    // Level L+1 blocks span this many level-L blocks
+#define PYRAMID_MAX_LEVELS  16
+
+// Sidecar file header ("<capture>.pyr"). Level data follows as float (min, max)
+// pairs: for level L and channel c, block b is at
+// level_offset[L] + ((c * level_blocks[L]) + b) * 2 * sizeof(float).
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t channels;
+    uint32_t base_block;
+    uint32_t fanout;
+    uint32_t levels;
+    uint32_t reserved;
+    uint64_t samples;          // Samples per channel
+    uint64_t source_size;      // Used to detect a stale sidecar
+    int64_t source_mtime;
+    uint64_t level_offset[PYRAMID_MAX_LEVELS];
+    uint64_t level_blocks[PYRAMID_MAX_LEVELS];
+} PyramidHeader;
+
+// A read-only memory mapping (POSIX mmap or Win32 file mapping)
+typedef struct {
+    void* data;
+    size_t size;
+    intptr_t handle[2];
+    bool heap;                 // data is a malloc'd copy, not a mapping (unwritable sidecar)
+} MappedFile;
+
+// The "Capture" - a raw recording of interleaved float32 channels, memory-mapped,
+// plus its min/max pyramid
+typedef struct Capture {
+    MappedFile source;
+    MappedFile pyramid;
+    const float* samples;      // Interleaved: samples[i * channels + c]
+    const PyramidHeader* header;
+    int channels;
+    uint64_t count;            // Samples per channel
+    double sample_rate;        // Samples per second; sample i is at x = x_origin + i / sample_rate
+    double x_origin;
+} Capture;
+
+Capture* capture_open(const char* path, int channels, double sample_rate);
+void capture_close(Capture* cap);
+bool capture_build_pyramid(const char* path, int channels);
+int capture_envelope(const Capture* cap, int channel, double x_lo, double x_hi, int columns, float* out_min, float* out_max);
+bool capture_channel_range(const Capture* cap, int channel, float* y_min, float* y_max);
+Series* plot_capture(Axes* ax, Capture* cap, int channel, SDL_Color color);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SDL_COLORMAP_H
+#define SDL_COLORMAP_H
+
+#include <SDL3/SDL.h>
+
+#define COLORMAP_SIZE 256
+
+typedef enum {
+    COLORMAP_NONE,      // Use the series' own color
+    COLORMAP_VIRIDIS,
+    COLORMAP_PLASMA,
+    COLORMAP_INFERNO,
+    COLORMAP_GRAY
+} Colormap;
+
+const SDL_Color* colormap_lut(Colormap cmap);
+
+// Maps t in [0, 1] to a LUT entry (values outside are clamped, NaN maps to 0)
+static inline SDL_Color colormap_lookup(const SDL_Color* lut, float t) {
+    if (!(t > 0.0f)) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    return lut[(int)(t * (COLORMAP_SIZE - 1) + 0.5f)];
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef SDL_CONTEXT_H
+#define SDL_CONTEXT_H
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include "sdl_layout.h"
+
+#define CONTEXT_DEFAULT_FONT "PTC55F.ttf"
+#define CONTEXT_DEFAULT_SIZE 16.0f
+#define GLYPH_FIRST 32           // Printable ASCII, ' ' .. '~'
+#define GLYPH_COUNT 95
+#define GLYPH_ATLAS_WIDTH 512
+
+// The "GlyphAtlas" - every printable ASCII glyph of one font, rasterized once
+// into a white texture on one renderer and tinted per draw through vertex colors
+typedef struct GlyphAtlas {
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    SDL_Texture* texture;
+    SDL_FRect cell[GLYPH_COUNT];   // Glyph cell in the atlas (a one-character text render)
+    float advance[GLYPH_COUNT];    // Pen movement after the glyph
+    float height;                  // Line height (cell height)
+} GlyphAtlas;
+
+// One open size of the context's font face
+typedef struct {
+    float size;
+    TTF_Font* font;
+    FontMetrics metrics;           // Layout advances, measured once for all figures
+} ContextFont;
+
+// The "GraphContext" - library-wide resources shared by every Figure. Used from
+// the render thread only.
+typedef struct GraphContext {
+    int refs;                      // Figures (and explicit context_retain calls) using it
+    char font_path[256];
+    const void* font_data;         // Face bytes every size is opened from
+    size_t font_size;
+    bool owns_data;                // Loaded from font_path (freed on shutdown)
+    ContextFont* fonts;
+    int font_count, font_capacity;
+    GlyphAtlas* atlases;
+    int atlas_count, atlas_capacity;
+} GraphContext;
+
+void context_retain(void);
+void context_release(void);
+bool context_set_font_file(const char* path);
+bool context_set_font_memory(const void* data, size_t size);
+TTF_Font* context_font(float size);
+const FontMetrics* context_font_metrics(TTF_Font* font);
+const GlyphAtlas* context_glyphs(SDL_Renderer* renderer, TTF_Font* font);
+void context_release_renderer(SDL_Renderer* renderer);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef SDL_DPI_H
+#define SDL_DPI_H
+
+#include "sdl_graphs.h"
+
+// Scales closer to 1 than this are treated as 1 (no transform, no extra fonts)
+#define DPI_SCALE_EPSILON 0.01f
+
+bool figure_update_scale(Figure* fig);
+void figure_fit_window(Figure* fig);
+void figure_scale_event(const Figure* fig, SDL_Event* event);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef SDL_FIGURE_MANAGER_H
+#define SDL_FIGURE_MANAGER_H
+
+#include "sdl_graphs.h"
+
+// The "FigureManager" - drives many Figures from a single event loop
+typedef struct {
+    Figure** figures;
+    int figure_count;
+    int capacity;
+    bool continuous;   // Redraw every figure each pump (live data) instead of only dirty ones
+} FigureManager;
+
+FigureManager* create_figure_manager(void);
+bool manager_add(FigureManager* mgr, Figure* fig);
+int manager_pump(FigureManager* mgr);
+void manager_run(FigureManager* mgr);
+void destroy_figure_manager(FigureManager* mgr);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SDL_FILL_H
+#define SDL_FILL_H
+
+#include "sdl_graphs.h"
+
+#define BAR_DEFAULT_WIDTH 0.8f   // Data units
+#define ERRORBAR_CAP_PX 6.0f     // Cap width in pixels
+
+// The "FillGeometry" - extra data and cached triangles behind fill_between(), 
+// errorbar() and bar() series. The series' x/y are the band's first edge, the 
+// points, or the bar tops respectively.
+typedef struct FillGeometry {
+    const float* y2;      // PLOT_FILL: second edge (NULL = 0)
+    const float* err;     // PLOT_ERRORBAR: symmetric error per point
+    float width;          // PLOT_BAR: bar width in data units
+
+    // Window-space triangles, rebuilt only when the key changes
+    SDL_Vertex* verts;
+    int* indices;
+    int num_vertices, num_indices;
+    int vert_capacity, index_capacity;
+
+    // Cache key
+    const float* key_x;
+    const float* key_y;
+    int key_count;
+    float key_view[4];
+    SDL_FRect key_rect;
+    SDL_Color key_color;
+    bool valid;
+} FillGeometry;
+
+void fill_bounds(const Axes* ax, const Series* s, float* x_lim, float* y_lim);
+void render_fill(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi);
+void fill_invalidate(FillGeometry* g);
+void fill_destroy(FillGeometry* g);
+
+#endif
@@ -3,16 +3,30 @@
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
+#include "sdl_arena.h"
+#include "sdl_ticks.h"
+#include "sdl_recorder.h"
+#include "sdl_colormap.h"
 
 #ifndef M_PI
     #define M_PI 3.14159265358979323846
 #endif
 
+// Draw-command target (SDL window, SVG file, ...), defined in sdl_canvas.h
+typedef struct Canvas Canvas;
+
 typedef enum {
     PROJECTION_2D=0,
     PROJECTION_3D
 } ProjectionType;
 
+// How data values map onto an axis (see set_xscale)
+typedef enum {
+    SCALE_LINEAR = 0,
+    SCALE_LOG,          // log10; values <= 0 are left out like NaN
+    SCALE_SYMLOG        // sign(v) * log10(1 + |v| / linthresh): linear near 0, log beyond
+} AxisScale;
+
 typedef enum {
     STYLE_SOLID,
     STYLE_DASHED,
@@ -21,7 +35,14 @@ typedef enum {
 
 typedef enum {
     PLOT_LINE,
-    PLOT_SCATTER
+    PLOT_SCATTER,
+    PLOT_SURFACE,     // 3D grid, see plot_surface()
+    PLOT_HIST,        // Bars over bins, see hist()
+    PLOT_SPECTROGRAM, // Scrolling time/frequency image, see spectrogram()
+    PLOT_IMAGE,       // Colormapped matrix, see imshow()
+    PLOT_FILL,        // Band between two curves, see fill_between()
+    PLOT_ERRORBAR,    // Whiskers with caps, see errorbar()
+    PLOT_BAR          // Bars from zero, see bar()
 } PlotType;
 
 typedef struct {
@@ -35,6 +56,19 @@ typedef struct {
     float marker_size; // Control how big the scatter points are
     float thickness;
     char label[32]; // The name of this line (e.g., "Sensor A")
+    struct SeriesStream* stream; // Non-NULL when fed from another thread (see sdl_stream.h)
+    struct PickIndex* pick;      // Lazily built hover/pick index (see sdl_pick.h)
+    struct RunIndex* runs;       // Lazily built finite runs, i.e. where lines break (see sdl_runs.h)
+    struct ScaleCache* scaled;   // x/y mapped through the axes' log/symlog scales (see sdl_scale.h)
+    struct Capture* capture;     // Non-NULL for memory-mapped captures (see sdl_capture.h)
+    int capture_channel;
+    Colormap colormap;           // COLORMAP_NONE = use 'color'; otherwise color by z
+    int grid_rows, grid_cols;    // PLOT_SURFACE grid (count = rows * cols)
+    bool cull_backfaces;         // PLOT_SURFACE: skip quads facing away from the viewer
+    struct Histogram* hist;      // PLOT_HIST: bin counts (see sdl_hist.h); x/y are its centers/counts
+    struct Spectrogram* spectro; // PLOT_SPECTROGRAM: FFT columns (see sdl_spectrogram.h); x/y are its extents
+    struct Heatmap* image;       // PLOT_IMAGE: matrix and texture (see sdl_imshow.h); x/y are its extents
+    struct FillGeometry* fill;   // PLOT_FILL/ERRORBAR/BAR: extra arrays and cached triangles (see sdl_fill.h)
 } Series;
 
 // The "Axes" - handles coordinates and drawing
@@ -59,21 +93,89 @@ typedef struct {
     float phi;   // Azimuthal angle (rotation around Z)
     float theta; // Elevation angle (angle from Z-axis)
     float zoom;
+    float pan_x, pan_y;          // View offset, in units of the projection scale
+    float spin_phi, spin_theta;  // Inertial rotation, degrees per second
+    struct AxesCache* cache;     // Last rendered 3D image (see sdl_camera.h)
+    // Decoration placement, set by the layout engine (see sdl_layout.h)
+    float title_offset;          // Title center, above the plot area
+    float xlabel_offset;         // X label center, below the plot area
+    float ylabel_offset;         // Y label center, left of the plot area
+    bool hide_x_ticklabels;      // Inner axes of a shared column
+    bool hide_y_ticklabels;      // Inner axes of a shared row
+    FrameArena* arena; // Per-frame scratch memory, owned by the Figure
+    // Tick locators (recomputed only when the view changes)
+    TickFormat x_format;
+    double x_time_origin; // Epoch seconds (UTC) that x = 0 maps to in TICKS_TIME mode
+    TickCache x_ticks;
+    TickCache y_ticks;
+    // Axis scales (2D axes), see set_xscale/set_yscale
+    AxisScale xscale, yscale;
+    float x_linthresh, y_linthresh; // SCALE_SYMLOG: half-width of the linear region
+    // Limit sharing (2D axes), see axes_share_x/axes_share_y
+    struct AxesLink* x_link;
+    struct AxesLink* y_link;
+    float data_lim[4];    // Data bounds in view units from the last axes_autoscale (x lo/hi, y lo/hi)
 } Axes;
 
+// Result of a hover/pick query (see figure_pick)
+typedef struct {
+    int axes_index;       // -1 when nothing was hit
+    int series_index;
+    int point_index;
+    float x, y;           // Data values of the point
+    float screen_x, screen_y;
+    float distance;       // Pixels from the query position
+} PickResult;
+
+// Startup cost of a Figure, in nanoseconds (see figure_print_timing)
+typedef struct {
+    Uint64 created_ns;      // SDL_GetTicksNS() when subplots() was called
+    Uint64 setup_ns;        // subplots() itself: axes and layout
+    Uint64 font_ns;         // Opening the shared font (near 0 once another figure has)
+    Uint64 window_ns;       // SDL_CreateWindow
+    Uint64 renderer_ns;     // SDL_CreateRenderer, including fallbacks
+    Uint64 first_frame_ns;  // From subplots() to the first presented frame
+    const char* driver;     // Render driver in use (NULL until created)
+} FigureTiming;
+
 // The "Figure" - the top level container
 typedef struct {
-    SDL_Window* window;
+    SDL_Window* window;     // Created on first render or export (see figure_realize)
     SDL_Renderer* renderer;
-    TTF_Font* font;
+    TTF_Font* font;         // Shared context font, opened on first use
     Axes* axes;
     int axes_count;
     void* toolbar;
+    FrameArena frame_arena; // Reset at the start of every frame in figure_render()
+    SDL_WindowID window_id;
+    bool dirty;             // Needs a redraw (set by events or figure_mark_dirty)
+    bool close_requested;   // The user asked to close the window
+    int vsync;              // Swap interval passed to figure_set_vsync (0 = off)
+    FrameRecorder* recorder; // Active recording, see figure_start_recording
+    bool hover_enabled;     // Show a tooltip for the point under the cursor
+    PickResult hover;       // Current hover target (axes_index -1 = none)
+    int drag_axes;          // 3D axes being rotated/panned by the mouse (-1 = none)
+    Uint64 drag_last_ns;    // Timestamp of the last drag event
+    Uint64 camera_ticks;    // Last inertia step, see figure_update_camera
+    struct FigureLayout* layout; // Grid description and cached solution
+    char title[128];        // Window title, kept until the window exists
+    int width, height;      // Figure size in layout pixels, valid without a window
+    bool window_shown;      // False while the window is hidden (created for an export)
+    float pixel_scale;      // Output pixels per layout pixel (the display scale, see sdl_dpi.h)
+    float event_scale;      // Layout pixels per window coordinate, for mouse events
+    TTF_Font* text_font;    // Context font sized for pixel_scale (NULL at 1x)
+    FigureTiming timing;
 } Figure;
 
 Figure* subplots(const char* title, int width, int height,int num_axes);
 void plot(Axes* ax, float* x, float* y, int count, SDL_Color color);
 void scatter(Axes* ax, float* x, float* y, int count, SDL_Color color, float size);
+void fill_between(Axes* ax, float* x, float* y1, float* y2, int count, SDL_Color color);
+void errorbar(Axes* ax, float* x, float* y, float* yerr, int count, SDL_Color color);
+void bar(Axes* ax, float* x, float* height, int count, float width, SDL_Color color);
+struct Heatmap* imshow(Axes* ax, const float* data, int rows, int cols, Colormap cmap);
+struct Spectrogram* spectrogram(Axes* ax, float sample_rate, int fft_size, int hop, int history, Colormap cmap);
+struct SeriesStream* spectrogram_stream(Axes* ax, float sample_rate, int fft_size, int hop, int history, Colormap cmap);
 void render_axes(SDL_Renderer* renderer, TTF_Font* font, Axes* ax);
 void draw_text(SDL_Renderer* renderer, TTF_Font* font, const char* text, float x, float y, bool right_align, SDL_Color color);
 void update_layout(Figure* fig, int window_w, int window_h);
@@ -82,20 +184,36 @@ void SDL_RenderLineDashed(SDL_Renderer* renderer, float x1, float y1, float x2,
 void set_linestyle(Axes* ax, int series_idx, LineStyle style);
 void RenderThickLine(SDL_Renderer* renderer, float x1, float y1, float x2, float y2, float thickness); // Now redundant I think
 void DrawDashedThickLine(SDL_Renderer* renderer, float x1, float y1, float x2, float y2, float thickness, LineStyle style);
-void render_legend(SDL_Renderer* renderer, TTF_Font* font, Axes* ax);
+void render_legend(Canvas* cv, Axes* ax);
 void set_legend(Axes* ax, bool enabled);
 void set_label(Axes* ax, int series_idx, const char* name);
 void set_xlabel(Axes* ax, const char* label);
 void set_ylabel(Axes* ax, const char* label);
 void set_title(Axes* ax, const char* title);
+void set_xaxis_time(Axes* ax, double epoch_origin);
 void destroy_figure(Figure* fig);
 void show(Figure* fig);
+bool figure_handle_event(Figure* fig, SDL_Event* event);
+void figure_render(Figure* fig);
+void figure_mark_dirty(Figure* fig);
+void series_invalidate(Axes* ax, Series* s);
+bool figure_should_close(Figure* fig);
+bool figure_set_vsync(Figure* fig, int interval);
+bool figure_start_recording(Figure* fig, const char* path, RecordFormat format, int fps);
+void figure_stop_recording(Figure* fig);
+bool figure_consume_streams(Figure* fig);
+void axes_autoscale(Axes* ax);
+void axes_view_2d(const Axes* ax, float* x_lo, float* x_hi, float* y_lo, float* y_hi);
 void save_figure_as_png(Figure* fig, const char* filename);
+bool save_figure_as_svg(Figure* fig, const char* filename);
+bool save_figure_as_png_scaled(Figure* fig, const char* filename, int width, int height);
+bool save_figure_as_png_antialiased(Figure* fig, const char* filename, int width, int height);
 void plot3D(Axes* ax, float* x, float* y, float* z, int count, SDL_Color color);
 void set_projection(Axes* ax, ProjectionType proj);
-void render_axes_2d(SDL_Renderer* renderer, TTF_Font* font, Axes* ax);
-void render_axes_3d(SDL_Renderer* renderer, TTF_Font* font, Axes* ax);
+void render_axes_canvas(Canvas* cv, Axes* ax);
+void render_axes_2d(Canvas* cv, Axes* ax);
+void render_axes_3d(Canvas* cv, Axes* ax);
 static void project_3d(Axes* ax, float x, float y, float z, float* px, float* py);
-void draw_3d_box(SDL_Renderer* renderer, Axes* ax);
+void draw_3d_box(Canvas* cv, Axes* ax);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef SDL_HIST_H
+#define SDL_HIST_H
+
+#include <stddef.h>
+#include "sdl_graphs.h"
+#include "sdl_stream.h"
+
+// Batches smaller than this are binned on the calling thread
+#define HIST_PARALLEL_MIN 262144
+#define HIST_MAX_THREADS 16
+#define HIST_MAX_BINS 4096
+// Default hist_stream() ring: values that can arrive between two frames (4 MB)
+#define HIST_STREAM_RING (1 << 20)
+
+// The "Histogram" - bin counts behind a PLOT_HIST series
+typedef struct Histogram {
+    int bins;
+    double lo, width;     // Bin i covers [lo + i*width, lo + (i+1)*width); the last bin includes its right edge
+    bool auto_range;      // Range follows the data (bins merge pairwise as it grows)
+    bool has_range;       // False until the first finite sample (auto range only)
+    Uint64* counts;
+    Uint64 total;         // Samples binned
+    Uint64 rejected;      // NaN/Inf samples, or samples outside a fixed range
+    Uint64 max_count;
+
+    // Series view: bin centers and counts, s->count = bins
+    float* centers;
+    float* heights;
+    Axes* ax;             // Axes whose limits grow with the histogram
+} Histogram;
+
+Histogram* hist(Axes* ax, const float* samples, int count, int bins, SDL_Color color);
+Histogram* hist_range(Axes* ax, const float* samples, int count, int bins, float lo, float hi, SDL_Color color);
+void hist_add(Histogram* h, const float* samples, size_t count);
+void hist_clear(Histogram* h);
+SeriesStream* hist_stream(Axes* ax, int bins, int capacity, SDL_Color color);
+int hist_push(SeriesStream* stream, const float* values, int count);
+void render_hist(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi);
+void hist_destroy(Histogram* h);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SDL_IMSHOW_H
+#define SDL_IMSHOW_H
+
+#include "sdl_graphs.h"
+
+// Entries in a heatmap's color table (interpolated from the COLORMAP_SIZE base map)
+#define HEATMAP_LUT_SIZE 4096
+
+// The "Heatmap" - a float matrix shown as a colormapped image (see imshow())
+typedef struct Heatmap {
+    const float* data;    // rows * cols values, row-major, user-owned
+    int rows, cols;
+    float vmin, vmax;     // Values mapped to the ends of the colormap
+    bool auto_clim;       // vmin/vmax follow the data on imshow_set_data()
+    Uint32 lut[HEATMAP_LUT_SIZE]; // Packed RGBA32 pixels
+
+    SDL_Texture* texture; // Streaming, cols x rows
+    SDL_Renderer* texture_owner;
+    int dirty_lo, dirty_hi; // Rows [lo, hi) not yet converted into the texture
+
+    float extent_x[2];    // Left/right edges in data units, used as the Series' x
+    float extent_y[2];    // Bottom/top edges, used as the Series' y
+    Axes* ax;
+} Heatmap;
+
+void heatmap_convert_row(const Heatmap* hm, const float* values, Uint32* out, int count);
+void imshow_update_rows(Heatmap* hm, int first_row, int num_rows);
+void imshow_set_data(Heatmap* hm, const float* data);
+void imshow_set_clim(Heatmap* hm, float vmin, float vmax);
+void imshow_set_extent(Heatmap* hm, float x0, float x1, float y0, float y1);
+void render_heatmap(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi);
+void heatmap_destroy(Heatmap* hm);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef SDL_LAYOUT_H
+#define SDL_LAYOUT_H
+
+#include "sdl_graphs.h"
+
+// Upper bound on grid rows and columns
+#define LAYOUT_MAX_TRACKS 32
+
+// Cell range occupied by one Axes
+typedef struct {
+    int row, col;
+    int row_span, col_span;
+} GridSlot;
+
+// Per-font text metrics, measured once so layout never has to call into TTF
+typedef struct {
+    TTF_Font* font;
+    float height;        // Line height
+    float advance[128];  // Width of each printable ASCII character
+} FontMetrics;
+
+// Space one Axes needs around its plot area, plus what it was measured from
+typedef struct {
+    float left, right, top, bottom;
+    float title_offset, xlabel_offset, ylabel_offset;
+    bool hide_x, hide_y;  // Inner axes of a shared row/column
+
+    // Cache key: margins are re-measured only when any of these change
+    bool valid;
+    float key_limits[4];  // x_min, x_max, y_min, y_max
+    float key_extent[2];  // Plot area size the ticks were estimated for
+    const char* key_title;
+    const char* key_xlabel;
+    const char* key_ylabel;
+    ProjectionType key_projection;
+    TickFormat key_format;
+    bool key_hide_x, key_hide_y;
+    AxisScale key_scale[2];
+} AxesMargins;
+
+// The "FigureLayout" - grid description and cached solution for a Figure
+struct FigureLayout {
+    int rows, cols;
+    float width_ratios[LAYOUT_MAX_TRACKS];
+    float height_ratios[LAYOUT_MAX_TRACKS];
+    bool share_x;         // Axes in a column share x: only the bottom one gets x labels
+    bool share_y;         // Axes in a row share y: only the leftmost gets y labels
+    GridSlot* slots;      // One per Axes
+    AxesMargins* margins; // One per Axes
+    int count;
+    int width, height;    // Figure size the layout is solved for
+    FontMetrics metrics;
+    bool dirty;           // Grid, spans or size changed since the last solve
+};
+
+struct FigureLayout* layout_create(int axes_count);
+void layout_destroy(struct FigureLayout* layout);
+void layout_resize(Figure* fig, int width, int height);
+bool layout_update(Figure* fig);
+float layout_text_width(const FontMetrics* fm, const char* text);
+void layout_measure_font(FontMetrics* fm, TTF_Font* font);
+
+Figure* subplots_grid(const char* title, int width, int height, int rows, int cols);
+bool layout_set_grid(Figure* fig, int rows, int cols);
+bool layout_set_span(Figure* fig, int axes_index, int row, int col, int row_span, int col_span);
+void layout_set_ratios(Figure* fig, const float* width_ratios, const float* height_ratios);
+void layout_set_shared(Figure* fig, bool share_x, bool share_y);
+
+#endif
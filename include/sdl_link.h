@@ -0,0 +1,35 @@
+#ifndef SDL_LINK_H
+#define SDL_LINK_H
+
+#include "sdl_graphs.h"
+#include "sdl_ticks.h"
+
+// The "AxesLink" - a group of 2D axes that share their x (or y) limits.
+// Limits set on any member are copied to all members once, and members whose 
+// plot area matches the leader's reuse one set of ticks and label textures.
+typedef struct AxesLink {
+    Axes** members;       // members[0] is the leader
+    int count, capacity;
+    bool y_axis;          // Links y limits instead of x
+    float lo, hi;         // Limits last propagated to every member
+    TickCache ticks;      // Shared ticks, computed for the leader's extent
+} AxesLink;
+
+void axes_share_x(Axes* ax, Axes* other);
+void axes_share_y(Axes* ax, Axes* other);
+void axes_unshare(Axes* ax, bool x_axis, bool y_axis);
+void set_xlim(Axes* ax, float lo, float hi);
+void set_ylim(Axes* ax, float lo, float hi);
+
+void link_propagate(AxesLink* link, float lo, float hi);
+bool links_sync(Figure* fig);
+TickCache* axes_tick_cache(Axes* ax, bool y_axis);
+void axes_invalidate_ticks(Axes* ax, bool y_axis);
+
+// Linked axes and log/symlog axes refit from all data when a series is added,
+// instead of just widening their limits
+static inline bool axes_full_rescan(const Axes* ax) {
+    return ax->xscale != SCALE_LINEAR || ax->yscale != SCALE_LINEAR || ax->x_link || ax->y_link;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SDL_PICK_H
+#define SDL_PICK_H
+
+#include "sdl_graphs.h"
+
+// Grid cell size in pixels. Hover radii are a few cells wide, so a query
+// touches a handful of cells no matter how many points the series has.
+#define PICK_CELL_PX 8.0f
+
+// The "PickIndex" - a uniform grid over a series' on-screen points
+typedef struct PickIndex {
+    // Cache key: the index is rebuilt when any of these change
+    const float* key_x;
+    const float* key_y;
+    int key_count;
+    float key_view[4];     // x_lo, x_hi, y_lo, y_hi
+    SDL_FRect key_rect;
+    bool valid;
+
+    int cols, rows;
+    int* cell_start;       // cols * rows + 1 offsets into the entry arrays
+    int* entry_index;      // Point indices, grouped by cell
+    float* entry_x;        // Screen positions, in the same order (contiguous per cell)
+    float* entry_y;
+    int* scratch;          // Cell of each point during a rebuild
+    int point_capacity;
+    int cell_capacity;
+} PickIndex;
+
+void pick_invalidate(PickIndex* pi);
+void pick_destroy(PickIndex* pi);
+
+bool figure_pick(Figure* fig, float mouse_x, float mouse_y, float radius, PickResult* out);
+void figure_set_hover(Figure* fig, bool enabled);
+bool figure_update_hover(Figure* fig, float mouse_x, float mouse_y);
+void render_hover(Canvas* cv, Figure* fig);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SDL_PLOT3D_H
+#define SDL_PLOT3D_H
+
+#include "sdl_graphs.h"
+
+// Primitives (points or quads) expanded into one scratch vertex buffer at a time
+#define PLOT3D_BATCH_PRIMS 16384
+
+// The "View3D" - an Axes' camera folded into three affine rows, so projecting a
+// point costs 9 multiply-adds (data -> normalized cube -> rotation -> screen).
+typedef struct {
+    float sx[4];   // screen x = sx[0]*x + sx[1]*y + sx[2]*z + sx[3]
+    float sy[4];   // screen y
+    float sz[4];   // view-space depth (larger = closer to the viewer)
+    float scale;   // Pixels per normalized unit
+} View3D;
+
+void view3d_setup(const Axes* ax, View3D* v);
+void view3d_project_bulk(const View3D* v, const float* x, const float* y, const float* z, int count, SDL_FPoint* out, float* depth);
+
+static inline void view3d_project(const View3D* v, float x, float y, float z, float* px, float* py) {
+    *px = v->sx[0] * x + v->sx[1] * y + v->sx[2] * z + v->sx[3];
+    *py = v->sy[0] * x + v->sy[1] * y + v->sy[2] * z + v->sy[3];
+}
+
+void scatter3D(Axes* ax, float* x, float* y, float* z, int count, SDL_Color color, float size);
+void plot_surface(Axes* ax, float* x, float* y, float* z, int rows, int cols, Colormap cmap);
+void set_colormap(Axes* ax, int series_idx, Colormap cmap);
+void set_backface_culling(Axes* ax, int series_idx, bool enabled);
+void render_series_3d(Canvas* cv, Axes* ax, Series* s, const View3D* v);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef SDL_PNG_WRITER_H
+#define SDL_PNG_WRITER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PNG_HASH_SIZE   (1 << 15)
+#define PNG_WINDOW_SIZE 32768
+#define PNG_BUFFER_SIZE (1 << 17)
+#define PNG_IDAT_SIZE   65536
+
+// The "PngWriter" - encodes an RGB image row by row, so the full image never
+// has to be held in memory. Compression is deflate with fixed Huffman codes.
+typedef struct {
+    FILE* file;
+    int width, height;
+    int rows_written;
+    bool failed;
+
+    // Deflate state
+    uint8_t* window;          // Sliding window of recent (filtered) bytes
+    int window_len;
+    int* hash_head;           // Last window position for each 3-byte hash
+    uint32_t bit_buffer;
+    int bit_count;
+    uint32_t adler_a, adler_b;
+
+    // Pending IDAT payload
+    uint8_t* idat;
+    int idat_len;
+
+    uint8_t* row;             // One filtered scanline (filter byte + RGB)
+} PngWriter;
+
+PngWriter* png_writer_open(const char* filename, int width, int height);
+bool png_writer_write_rows(PngWriter* pw, const uint8_t* rgb, int pitch, int rows);
+bool png_writer_close(PngWriter* pw);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef SDL_RASTER_H
+#define SDL_RASTER_H
+
+#include <SDL3/SDL.h>
+#include "sdl_graphs.h"
+
+// The "RasterTarget" - an RGBA image drawn by the CPU with anti-aliased coverage.
+// Works without a window or renderer, which makes it suitable for headless export.
+typedef struct RasterTarget {
+    Uint8* pixels;           // RGBA bytes, row-major
+    int width, height;
+    int pitch;               // Bytes per row
+    Uint8* coverage;         // One byte per pixel; all zero between primitives
+    int dirty_x0, dirty_y0;  // Bounding box of non-zero coverage
+    int dirty_x1, dirty_y1;
+} RasterTarget;
+
+bool raster_init(RasterTarget* rt, int width, int height);
+void raster_destroy(RasterTarget* rt);
+void raster_clear(RasterTarget* rt, SDL_Color color);
+void raster_polyline(RasterTarget* rt, const SDL_FPoint* pts, int count, float thickness, LineStyle style, SDL_Color color);
+void raster_fill_rect(RasterTarget* rt, float x, float y, float w, float h, SDL_Color color);
+void raster_triangles(RasterTarget* rt, const SDL_Vertex* vertices, int num_vertices, const int* indices, int num_indices);
+void raster_blit_surface(RasterTarget* rt, SDL_Surface* surface, int x, int y);
+
+void canvas_init_raster(Canvas* cv, RasterTarget* rt, TTF_Font* font, FrameArena* arena);
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef SDL_RECORDER_H
+#define SDL_RECORDER_H
+
+#include <stdio.h>
+#include <SDL3/SDL.h>
+
+// Frames waiting for the encoder; further captures are dropped, never waited on
+#define RECORDER_QUEUE_LEN 8
+
+typedef enum {
+    RECORD_Y4M,          // One uncompressed YUV4MPEG2 (4:2:0) video file
+    RECORD_PNG_SEQUENCE  // prefix_00000.png, prefix_00001.png, ...
+} RecordFormat;
+
+typedef struct {
+    SDL_Surface* surface;  // Pixels read back from the renderer (owned by the queue)
+    int index;             // Capture slot number on the recording timeline
+    int repeat;            // Slots up to and including this one (1 + frames dropped before it)
+} RecordedFrame;
+
+// The "FrameRecorder" - captures rendered frames and encodes them on a background thread
+typedef struct FrameRecorder {
+    RecordFormat format;
+    char path[512];
+    int fps;
+
+    // Bounded queue shared with the encoder thread
+    RecordedFrame queue[RECORDER_QUEUE_LEN];
+    int queue_head, queue_count;
+    SDL_Mutex* lock;
+    SDL_Condition* ready;
+    SDL_Thread* thread;
+    bool stopping;
+
+    // Capture side (render thread only)
+    Uint64 start_ns;
+    int next_index;        // Next timeline slot to be filled
+    int pending_drops;     // Dropped slots not yet covered by a queued frame
+
+    // Encoder side (encoder thread only)
+    FILE* file;
+    int width, height;     // Fixed by the first frame; later frames are cropped/padded
+    Uint8* yuv;
+    bool failed;
+
+    // Statistics
+    int frames_captured;
+    int frames_dropped;
+    int frames_written;
+} FrameRecorder;
+
+FrameRecorder* recorder_start(const char* path, RecordFormat format, int fps);
+bool recorder_capture(FrameRecorder* rec, SDL_Renderer* renderer);
+void recorder_stop(FrameRecorder* rec);
+
+#endif
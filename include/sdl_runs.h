@@ -0,0 +1,27 @@
+#ifndef SDL_RUNS_H
+#define SDL_RUNS_H
+
+#include "sdl_graphs.h"
+
+// The "RunIndex" - maximal stretches of finite points in a series. Lines are 
+// drawn run by run, so a NaN/Inf sample leaves a gap instead of a spike.
+typedef struct RunIndex {
+    // Cache key: the index is rebuilt when any of these change
+    const float* key_x;
+    const float* key_y;
+    int key_count;
+    bool valid;
+
+    bool all_finite;    // Common case: one run covering the whole series
+    int count;          // Number of runs
+    int* start;         // First point of each run
+    int* length;        // Points in each run
+    int capacity;
+} RunIndex;
+
+int finite_bounds(const float* x, const float* y, int count, float* x_min, float* x_max, float* y_min, float* y_max);
+const RunIndex* series_runs(Series* s, const float* x, const float* y);
+void runs_invalidate(RunIndex* ri);
+void runs_destroy(RunIndex* ri);
+
+#endif
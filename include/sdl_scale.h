@@ -0,0 +1,79 @@
+#ifndef SDL_SCALE_H
+#define SDL_SCALE_H
+
+#include <math.h>
+#include <string.h>
+#include "sdl_graphs.h"
+
+// The "ScaleCache" - a series' x/y already mapped through its axes' scales
+typedef struct ScaleCache {
+    // Cache key: the arrays are re-mapped when any of these change
+    const float* key_x;
+    const float* key_y;
+    int key_count;
+    AxisScale key_xscale, key_yscale;
+    float key_xthresh, key_ythresh;
+    bool valid;
+
+    float* x;             // NULL while the x axis is linear (the series' own array is used)
+    float* y;
+    int capacity;
+} ScaleCache;
+
+/**
+ * @brief log10 with about 5 correct digits, built from the float's exponent bits
+ * and an odd series for the mantissa. No branches or libm calls, so bulk loops
+ * over it vectorize. Returns NaN for values <= 0, NaN and +Inf.
+ */
+static inline float fast_log10(float v) {
+    Uint32 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    float e = (float)((int)((bits >> 23) & 0xFF) - 127);
+    bits = (bits & 0x007FFFFFu) | 0x3F800000u; // Mantissa m in [1, 2)
+    float m;
+    memcpy(&m, &bits, sizeof(m));
+    // log2(m) = 2/ln2 * atanh(t), t = (m - 1) / (m + 1) in [0, 1/3)
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    float log2m = t * (2.8853901f + t2 * (0.9617967f + t2 * (0.5770780f + t2 * 0.4121983f)));
+    float r = (e + log2m) * 0.30102999566f;
+
+    // Blend in a quiet NaN with a mask rather than a branch
+    Uint32 ok = 0u - (Uint32)((v > 0.0f) & (v <= 3.4028235e38f));
+    Uint32 rbits;
+    memcpy(&rbits, &r, sizeof(rbits));
+    rbits = (rbits & ok) | (0x7FC00000u & ~ok);
+    memcpy(&r, &rbits, sizeof(r));
+    return r;
+}
+
+// Data value -> position along a scaled axis ("view" units)
+static inline float scale_forward(AxisScale scale, float linthresh, float v) {
+    switch (scale) {
+        case SCALE_LOG:    return fast_log10(v);
+        case SCALE_SYMLOG: return copysignf(fast_log10(1.0f + fabsf(v) / linthresh), v);
+        default:           return v;
+    }
+}
+
+// Position along a scaled axis -> data value (exact inverse, for limits and ticks)
+static inline float scale_inverse(AxisScale scale, float linthresh, float t) {
+    switch (scale) {
+        case SCALE_LOG:    return powf(10.0f, t);
+        case SCALE_SYMLOG: return copysignf(linthresh * (powf(10.0f, fabsf(t)) - 1.0f), t);
+        default:           return t;
+    }
+}
+
+static inline float axes_tx(const Axes* ax, float v) { return scale_forward(ax->xscale, ax->x_linthresh, v); }
+static inline float axes_ty(const Axes* ax, float v) { return scale_forward(ax->yscale, ax->y_linthresh, v); }
+
+void scale_bulk(AxisScale scale, float linthresh, const float* in, float* out, int count);
+void series_scaled(const Axes* ax, Series* s, const float** x, const float** y);
+bool scale_update_ticks(TickCache* tc, AxisScale scale, float linthresh, float view_min, float view_max, float extent_px, float min_spacing_px);
+void scale_cache_invalidate(ScaleCache* sc);
+void scale_cache_destroy(ScaleCache* sc);
+void set_xscale(Axes* ax, AxisScale scale, float linthresh);
+void set_yscale(Axes* ax, AxisScale scale, float linthresh);
+
+#endif
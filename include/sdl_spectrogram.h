@@ -0,0 +1,59 @@
+#ifndef SDL_SPECTROGRAM_H
+#define SDL_SPECTROGRAM_H
+
+#include <stddef.h>
+#include "sdl_graphs.h"
+#include "sdl_stream.h"
+
+#define SPECTROGRAM_MAX_FFT 65536
+
+// Precomputed tables for one power-of-two FFT size
+typedef struct {
+    int n, log2n;
+    float* cos_table;   // cos(2*pi*k/n), k < n/2
+    float* sin_table;   // sin(2*pi*k/n), k < n/2
+    int* bitrev;        // Bit-reversal permutation
+    float* window;      // Hann window
+    float* re;          // Work buffers (split real/imaginary)
+    float* im;
+} FFTPlan;
+
+// The "Spectrogram" - windowed FFT columns kept in a ring of texture rows.
+// Texture row r holds one time slice: pixel k is frequency bin k.
+typedef struct Spectrogram {
+    FFTPlan plan;
+    int bins;             // fft_size / 2
+    int hop;              // Samples between consecutive columns
+    float sample_rate;
+    float db_min, db_max; // Color range (dB relative to a full-scale sine)
+    float power_norm;     // Scales |X|^2 so a full-scale sine reads 0 dB
+    const SDL_Color* lut;
+
+    float* frame;         // Last fft_size input samples
+    int frame_len;
+    Uint64 columns;       // Columns computed so far
+
+    int history;          // Columns kept (texture height)
+    Uint8* pixels;        // history * bins RGBA rows, CPU copy of the texture
+    int next_row;         // Ring slot the next column goes to
+    int pending;          // Rows computed but not yet uploaded
+
+    SDL_Texture* texture;
+    SDL_Renderer* texture_owner;
+
+    float extent_x[2];    // Time covered (seconds), used as the Series' x
+    float extent_y[2];    // Frequencies covered (Hz), used as the Series' y
+    Axes* ax;             // Axes whose limits follow the scrolling image
+} Spectrogram;
+
+bool fft_plan_init(FFTPlan* plan, int n);
+void fft_plan_free(FFTPlan* plan);
+void fft_forward(const FFTPlan* plan, float* re, float* im);
+
+void spectrogram_feed(Spectrogram* sp, const float* samples, size_t count);
+int spectrogram_push(SeriesStream* stream, const float* samples, int count);
+void spectrogram_set_range(Spectrogram* sp, float db_min, float db_max);
+void render_spectrogram(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi);
+void spectrogram_destroy(Spectrogram* sp);
+
+#endif
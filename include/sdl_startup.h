@@ -0,0 +1,25 @@
+#ifndef SDL_STARTUP_H
+#define SDL_STARTUP_H
+
+#include "sdl_graphs.h"
+
+// Render drivers tried first, in order (SDL accepts comma-separated lists).
+// direct3d11 has shown occasional crashes here, so Windows only falls back to it.
+#if defined(_WIN32)
+#define DEFAULT_RENDER_DRIVERS "direct3d12,opengl,direct3d11"
+#elif defined(__APPLE__)
+#define DEFAULT_RENDER_DRIVERS "metal,opengl"
+#else
+#define DEFAULT_RENDER_DRIVERS NULL // SDL's own order
+#endif
+
+// Set this environment variable to print each figure's startup timing
+#define STARTUP_TIMING_ENV "SDL_GRAPHS_TIMING"
+
+void set_render_driver(const char* drivers);
+bool figure_realize(Figure* fig, bool visible);
+bool figure_ensure_font(Figure* fig);
+void figure_size(const Figure* fig, int* width, int* height);
+void figure_print_timing(const Figure* fig);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SDL_STREAM_H
+#define SDL_STREAM_H
+
+#include "sdl_graphs.h"
+
+// The "SeriesStream" - lock-free single-producer/single-consumer sample handoff.
+// A producer thread pushes samples; the render thread drains whole batches per frame
+// into a rolling history that backs the Series' x/y arrays.
+typedef struct SeriesStream {
+    // Ring buffer shared between the two threads
+    float* ring_x;         // NULL for value streams (plot_value_stream())
+    float* ring_y;
+    Uint32 ring_mask;      // Ring capacity - 1 (capacity is a power of two)
+    SDL_AtomicU32 head;    // Total samples written (producer only)
+    SDL_AtomicU32 tail;    // Total samples read (consumer only)
+    SDL_AtomicInt dropped; // Samples rejected because the ring was full
+
+    // Rolling history, only touched by the consumer (render) thread
+    float* hist_x;         // 2 * history floats, see stream_append()
+    float* hist_y;
+    int history;           // Maximum number of samples kept for display
+    int start;
+    int len;
+} SeriesStream;
+
+SeriesStream* plot_stream(Axes* ax, int history, SDL_Color color);
+SeriesStream* plot_value_stream(Axes* ax, int capacity, SDL_Color color);
+int stream_push(SeriesStream* stream, const float* x, const float* y, int count);
+int stream_push_values(SeriesStream* stream, const float* values, int count);
+bool stream_push_sample(SeriesStream* stream, float x, float y);
+int series_consume_stream(Series* s);
+void destroy_stream(SeriesStream* stream);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef SDL_TICKS_H
+#define SDL_TICKS_H
+
+#include <SDL3/SDL.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define MAX_TICKS 16
+#define TICK_LABEL_LEN 24
+
+// key_origin tags for the scaled locators (numeric ticks use 0, time ticks the epoch)
+#define TICKS_KEY_LOG (-1.0)
+#define TICKS_KEY_SYMLOG (-2.0)
+
+typedef enum {
+    TICKS_NUMERIC = 0,
+    TICKS_TIME          // Values are seconds relative to an epoch origin
+} TickFormat;
+
+// Tick positions and their formatted labels, regenerated only when the view changes
+typedef struct {
+    int count;
+    float values[MAX_TICKS];                  // Data-space positions
+    char labels[MAX_TICKS][TICK_LABEL_LEN];
+    double step;                              // Spacing between ticks (seconds in time mode)
+    // Rasterized labels, created lazily by the renderer and dropped on regeneration
+    SDL_Texture* textures[MAX_TICKS];
+    float label_w[MAX_TICKS];
+    float label_h[MAX_TICKS];
+    struct TTF_Font* texture_font;            // Font (i.e. point size) the textures were drawn with
+    // Cache key: the view the ticks were computed for
+    bool valid;
+    float key_min, key_max;
+    float key_extent;
+    double key_origin;
+} TickCache;
+
+void ticks_init(TickCache* tc);
+void ticks_invalidate(TickCache* tc);
+void ticks_release_textures(TickCache* tc);
+bool ticks_update_numeric(TickCache* tc, float view_min, float view_max, float extent_px, float min_spacing_px);
+bool ticks_update_log(TickCache* tc, float view_min, float view_max, float extent_px, float min_spacing_px);
+bool ticks_update_symlog(TickCache* tc, float linthresh, float view_min, float view_max, float extent_px, float min_spacing_px);
+bool ticks_update_time(TickCache* tc, double origin, float view_min, float view_max, float extent_px);
+size_t format_time_label(char* buf, size_t cap, double epoch_seconds, double step);
+
+#endif
@@ -46,6 +46,6 @@ void update_toolbar(Toolbar* tb);
 void destroy_toolbar(Toolbar* tb);
 
 void render_toolbar(Toolbar* tb, TTF_Font* font);
-void handle_toolbar_events(Toolbar* tb, SDL_Event* event);
+bool handle_toolbar_events(Toolbar* tb, SDL_Event* event);
 static inline bool point_in_frect(float x, float y, SDL_FRect r);
 #endif
\ No newline at end of file
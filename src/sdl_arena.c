@@ -0,0 +1,134 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "sdl_arena.h"
+
+// Header size rounded up so the first allocation in a block is aligned
+#define ARENA_HEADER_SIZE ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+static inline size_t align_up(size_t n) {
+    return (n + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+static inline char* block_data(ArenaBlock* block) {
+    return (char*)block + ARENA_HEADER_SIZE;
+}
+
+static ArenaBlock* arena_push_block(FrameArena* arena, size_t min_size) {
+    size_t size = arena->block_size;
+    while (size < min_size) size *= 2;
+
+    ArenaBlock* block = malloc(ARENA_HEADER_SIZE + size);
+    if (!block) return NULL;
+    block->size = size;
+    block->used = 0;
+    block->next = arena->head;
+    arena->head = block;
+    arena->capacity += size;
+    arena->block_count++;
+    return block;
+}
+
+static void arena_free_blocks(FrameArena* arena) {
+    ArenaBlock* block = arena->head;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->capacity = 0;
+    arena->block_count = 0;
+}
+
+/**
+ * @brief Prepares an empty arena. No memory is reserved until the first allocation.
+ * * @param arena      Pointer to the arena to initialize.
+ * @param block_size Size of the first block in bytes (0 selects ARENA_DEFAULT_BLOCK_SIZE).
+ */
+void arena_init(FrameArena* arena, size_t block_size) {
+    if (!arena) return;
+    arena->head = NULL;
+    arena->block_size = block_size ? align_up(block_size) : ARENA_DEFAULT_BLOCK_SIZE;
+    arena->bytes_used = 0;
+    arena->peak_bytes = 0;
+    arena->capacity = 0;
+    arena->block_count = 0;
+    arena->overflow_count = 0;
+    arena->frame_count = 0;
+}
+
+/**
+ * @brief Hands out a block of scratch memory that lives until the next arena_reset().
+ * * Allocation is a pointer bump inside the current block. When the block is full a
+ * new one is chained in front of it; the chain is collapsed back into a single,
+ * larger block on the next reset so steady-state frames never touch malloc.
+ * * @param arena Pointer to the arena.
+ * @param size  Number of bytes requested.
+ * @return A pointer aligned to ARENA_ALIGNMENT bytes, or NULL if the system is out of memory.
+ * * @note The memory is NOT zeroed.
+ * @warning Pointers returned by this function are invalidated by arena_reset().
+ * Never store them in a Figure, Axes or Series.
+ */
+void* arena_alloc(FrameArena* arena, size_t size) {
+    if (!arena || size == 0) return NULL;
+    size = align_up(size);
+
+    ArenaBlock* block = arena->head;
+    if (!block || block->size - block->used < size) {
+        if (block) arena->overflow_count++;
+        block = arena_push_block(arena, size);
+        if (!block) return NULL;
+    }
+
+    void* ptr = block_data(block) + block->used;
+    block->used += size;
+    arena->bytes_used += size;
+    if (arena->bytes_used > arena->peak_bytes) arena->peak_bytes = arena->bytes_used;
+    return ptr;
+}
+
+/**
+ * @brief Releases everything allocated from the arena in one step.
+ * * Called at the start of every frame by show(). If the previous frame spilled
+ * into more than one block, the chain is replaced by a single block large enough
+ * for the peak usage seen so far, which keeps the hot path to a single bump.
+ * * @param arena Pointer to the arena to reset.
+ */
+void arena_reset(FrameArena* arena) {
+    if (!arena) return;
+
+    if (arena->block_count > 1) {
+        size_t wanted = arena->peak_bytes;
+        arena_free_blocks(arena);
+        if (wanted > arena->block_size) arena->block_size = align_up(wanted);
+        arena_push_block(arena, wanted);
+    } else if (arena->head) {
+        arena->head->used = 0;
+    }
+
+    arena->bytes_used = 0;
+    arena->frame_count++;
+}
+
+/**
+ * @brief Frees every block owned by the arena. The arena can be reused after arena_init().
+ * * @param arena Pointer to the arena to destroy.
+ */
+void arena_destroy(FrameArena* arena) {
+    if (!arena) return;
+    arena_free_blocks(arena);
+    arena->bytes_used = 0;
+}
+
+/**
+ * @brief Prints usage statistics (peak, capacity, overflows) to stdout.
+ * * Useful for tuning the initial block size passed to arena_init().
+ * * @param arena Pointer to the arena to report on.
+ */
+void arena_print_stats(const FrameArena* arena) {
+    if (!arena) return;
+    printf("Frame arena: %lu frames, peak %zu bytes, capacity %zu bytes in %d block(s), %d overflow(s)\n",
+           arena->frame_count, arena->peak_bytes, arena->capacity,
+           arena->block_count, arena->overflow_count);
+}
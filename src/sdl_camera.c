@@ -0,0 +1,296 @@
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_camera.h"
+#include "sdl_canvas.h"
+
+// Rotation sensitivity, degrees per pixel dragged
+#define CAMERA_DEG_PER_PIXEL 0.5f
+// Zoom step per wheel notch, and the allowed zoom range
+#define CAMERA_ZOOM_STEP 1.1f
+#define CAMERA_ZOOM_MIN 0.1f
+#define CAMERA_ZOOM_MAX 100.0f
+// Inertia: spin decays by e every 1/DECAY seconds and stops below MIN deg/s
+#define CAMERA_SPIN_DECAY 3.0f
+#define CAMERA_SPIN_MIN 2.0f
+#define CAMERA_SPIN_MAX 720.0f
+// A release more than this long after the last motion does not throw the view
+#define CAMERA_FLICK_NS 60000000ull
+
+static float camera_scale(const Axes* ax) {
+    return (ax->rect.w < ax->rect.h ? ax->rect.w : ax->rect.h) * 0.4f * ax->zoom;
+}
+
+static float clamp_spin(float v) {
+    if (v > CAMERA_SPIN_MAX) return CAMERA_SPIN_MAX;
+    if (v < -CAMERA_SPIN_MAX) return -CAMERA_SPIN_MAX;
+    return v;
+}
+
+// Returns false (and stops vertical spin) when theta hit its limit
+static bool clamp_theta(Axes* ax) {
+    // Keep theta within reasonable bounds so the graph doesn't flip
+    if (ax->theta > 89.0f) { ax->theta = 89.0f; return false; }
+    if (ax->theta < -89.0f) { ax->theta = -89.0f; return false; }
+    return true;
+}
+
+/**
+ * @brief Finds the Axes under a window position.
+ * * @param fig Pointer to the Figure.
+ * @param x   Window x coordinate (e.g. of the mouse).
+ * @param y   Window y coordinate.
+ * @return The index of the Axes whose rect contains the point, or -1.
+ */
+int figure_axes_at(Figure* fig, float x, float y) {
+    if (!fig) return -1;
+    SDL_FPoint p = { x, y };
+    // Last drawn wins when rects overlap
+    for (int i = fig->axes_count - 1; i >= 0; i--) {
+        if (SDL_PointInRectFloat(&p, &fig->axes[i].rect)) return i;
+    }
+    return -1;
+}
+
+static Axes* axes_3d_at(Figure* fig, float x, float y) {
+    int i = figure_axes_at(fig, x, y);
+    return (i >= 0 && fig->axes[i].projection == PROJECTION_3D) ? &fig->axes[i] : NULL;
+}
+
+// Zooms by 'factor' while keeping the point under (mx, my) fixed on screen
+static void camera_zoom_at(Axes* ax, float factor, float mx, float my) {
+    float old_scale = camera_scale(ax);
+    float zoom = ax->zoom * factor;
+    if (zoom < CAMERA_ZOOM_MIN) zoom = CAMERA_ZOOM_MIN;
+    if (zoom > CAMERA_ZOOM_MAX) zoom = CAMERA_ZOOM_MAX;
+    ax->zoom = zoom;
+
+    float new_scale = camera_scale(ax);
+    if (old_scale <= 0 || new_scale <= 0) return;
+    float dx = mx - (ax->rect.x + ax->rect.w / 2.0f);
+    float dy = my - (ax->rect.y + ax->rect.h / 2.0f);
+    ax->pan_x += dx / new_scale - dx / old_scale;
+    ax->pan_y += dy / new_scale - dy / old_scale;
+}
+
+/**
+ * @brief Mouse interaction for 3D axes.
+ * * Only the Axes under the cursor is affected:
+ * - Left-drag rotates (a quick release keeps it spinning, see figure_update_camera()).
+ * - Right-drag pans.
+ * - The wheel zooms around the cursor.
+ * A drag stays with the Axes it started on, even if the cursor leaves its rect.
+ * * @param fig   Pointer to the Figure.
+ * @param event Pointer to an event already addressed to this figure's window.
+ * @return true if the event was consumed by a 3D camera.
+ */
+bool camera_handle_event(Figure* fig, const SDL_Event* event) {
+    if (!fig || !event) return false;
+
+    switch (event->type) {
+        case SDL_EVENT_MOUSE_BUTTON_DOWN: {
+            if (event->button.button != SDL_BUTTON_LEFT && event->button.button != SDL_BUTTON_RIGHT) return false;
+            Axes* ax = axes_3d_at(fig, event->button.x, event->button.y);
+            if (!ax) return false;
+            fig->drag_axes = (int)(ax - fig->axes);
+            fig->drag_last_ns = event->button.timestamp;
+            if (event->button.button == SDL_BUTTON_LEFT) {
+                ax->spin_phi = ax->spin_theta = 0.0f; // Grabbing stops any spin
+            }
+            return true;
+        }
+        case SDL_EVENT_MOUSE_BUTTON_UP: {
+            if (fig->drag_axes < 0) return false;
+            Axes* ax = &fig->axes[fig->drag_axes];
+            if (event->button.button == SDL_BUTTON_LEFT &&
+                event->button.timestamp - fig->drag_last_ns > CAMERA_FLICK_NS) {
+                ax->spin_phi = ax->spin_theta = 0.0f; // Held still before letting go
+            }
+            fig->drag_axes = -1;
+            return true;
+        }
+        case SDL_EVENT_MOUSE_MOTION: {
+            if (fig->drag_axes < 0 || !(event->motion.state & (SDL_BUTTON_LMASK | SDL_BUTTON_RMASK))) {
+                return false;
+            }
+            Axes* ax = &fig->axes[fig->drag_axes];
+            if (event->motion.state & SDL_BUTTON_LMASK) {
+                float d_phi = event->motion.xrel * CAMERA_DEG_PER_PIXEL;
+                float d_theta = -event->motion.yrel * CAMERA_DEG_PER_PIXEL;
+                ax->phi += d_phi;
+                ax->theta += d_theta;
+                clamp_theta(ax);
+
+                // Smoothed angular velocity for the throw on release
+                double dt = (event->motion.timestamp - fig->drag_last_ns) / 1e9;
+                if (dt > 0) {
+                    ax->spin_phi = clamp_spin(0.6f * (float)(d_phi / dt) + 0.4f * ax->spin_phi);
+                    ax->spin_theta = clamp_spin(0.6f * (float)(d_theta / dt) + 0.4f * ax->spin_theta);
+                }
+            } else {
+                float scale = camera_scale(ax);
+                if (scale > 0) {
+                    ax->pan_x += event->motion.xrel / scale;
+                    ax->pan_y += event->motion.yrel / scale;
+                }
+            }
+            fig->drag_last_ns = event->motion.timestamp;
+            fig->dirty = true;
+            return true;
+        }
+        case SDL_EVENT_MOUSE_WHEEL: {
+            Axes* ax = axes_3d_at(fig, event->wheel.mouse_x, event->wheel.mouse_y);
+            if (!ax) return false;
+            float notches = event->wheel.y;
+            if (event->wheel.direction == SDL_MOUSEWHEEL_FLIPPED) notches = -notches;
+            camera_zoom_at(ax, powf(CAMERA_ZOOM_STEP, notches), event->wheel.mouse_x, event->wheel.mouse_y);
+            fig->dirty = true;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Advances inertial rotation of every spinning 3D axes.
+ * * Called once per loop iteration by show() and the FigureManager (whether or not 
+ * the figure is about to be drawn), so a thrown view keeps turning and slows down 
+ * smoothly in real time. Marks the figure dirty while anything is moving.
+ * * @param fig Pointer to the Figure.
+ * @return true if any camera moved.
+ */
+bool figure_update_camera(Figure* fig) {
+    if (!fig) return false;
+    Uint64 now = SDL_GetTicksNS();
+    float dt = fig->camera_ticks ? (float)((now - fig->camera_ticks) / 1e9) : 0.0f;
+    if (dt > 0.1f) dt = 0.1f; // Don't jump after a stall
+    fig->camera_ticks = now;
+    if (dt <= 0.0f) return false;
+
+    bool moved = false;
+    float decay = expf(-CAMERA_SPIN_DECAY * dt);
+    for (int i = 0; i < fig->axes_count; i++) {
+        Axes* ax = &fig->axes[i];
+        if (i == fig->drag_axes || (ax->spin_phi == 0.0f && ax->spin_theta == 0.0f)) continue;
+
+        ax->phi += ax->spin_phi * dt;
+        ax->theta += ax->spin_theta * dt;
+        if (!clamp_theta(ax)) ax->spin_theta = 0.0f;
+        ax->phi = fmodf(ax->phi, 360.0f);
+
+        ax->spin_phi *= decay;
+        ax->spin_theta *= decay;
+        if (fabsf(ax->spin_phi) < CAMERA_SPIN_MIN && fabsf(ax->spin_theta) < CAMERA_SPIN_MIN) {
+            ax->spin_phi = ax->spin_theta = 0.0f;
+        }
+        moved = true;
+    }
+    if (moved) fig->dirty = true;
+    return moved;
+}
+
+static CameraKey camera_key(const Axes* ax) {
+    CameraKey key;
+    memset(&key, 0, sizeof(key)); // memcmp'd, so padding must be zero
+    key.rect = ax->rect;
+    key.phi = ax->phi;  key.theta = ax->theta;  key.zoom = ax->zoom;
+    key.pan_x = ax->pan_x;  key.pan_y = ax->pan_y;
+    key.x_min = ax->x_min;  key.x_max = ax->x_max;
+    key.y_min = ax->y_min;  key.y_max = ax->y_max;
+    key.z_min = ax->z_min;  key.z_max = ax->z_max;
+    key.line_count = ax->line_count;
+    return key;
+}
+
+/**
+ * @brief Draws a 3D axes from its cached image, re-rendering only if its view changed.
+ * * The axes (plus CAMERA_CACHE_MARGIN for its labels) is rendered into a target 
+ * texture with premultiplied alpha and composited onto the window. While the 
+ * camera, limits, layout and series count stay the same the texture is simply 
+ * redrawn, so rotating one heavy 3D subplot does not re-project the others. 
+ * Content is clipped to the cached region. Falls back to direct rendering when 
+ * target textures are unavailable (or the Canvas is not a window-sized SDL one). 
+ * On HiDPI windows the image is kept at native resolution.
+ * * @param cv The window's SDL Canvas.
+ * @param ax The 3D Axes to draw.
+ */
+void render_axes_3d_cached(Canvas* cv, Axes* ax) {
+    if (!cv->renderer || cv->origin_x != 0.0f || cv->origin_y != 0.0f) {
+        render_axes_3d(cv, ax);
+        return;
+    }
+
+    // --- STEP 1: Region covered by the cache (rect + margin, clipped to the window) ---
+    float x0 = floorf(fmaxf(ax->rect.x - CAMERA_CACHE_MARGIN, 0.0f));
+    float y0 = floorf(fmaxf(ax->rect.y - CAMERA_CACHE_MARGIN, 0.0f));
+    float x1 = ceilf(fminf(ax->rect.x + ax->rect.w + CAMERA_CACHE_MARGIN, cv->width));
+    float y1 = ceilf(fminf(ax->rect.y + ax->rect.h + CAMERA_CACHE_MARGIN, cv->height));
+    float s = cv->scale; // Output pixels per layout pixel
+    int w = (int)ceilf((x1 - x0) * s), h = (int)ceilf((y1 - y0) * s);
+    if (w <= 0 || h <= 0) return;
+
+    // --- STEP 2: (Re)create the target texture when the region's size changes ---
+    struct AxesCache* cache = ax->cache;
+    if (!cache) {
+        cache = calloc(1, sizeof(*cache));
+        if (!cache) {
+            render_axes_3d(cv, ax);
+            return;
+        }
+        ax->cache = cache;
+    }
+    if (!cache->texture || cache->w != w || cache->h != h) {
+        if (cache->texture) SDL_DestroyTexture(cache->texture);
+        cache->texture = SDL_CreateTexture(cv->renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, w, h);
+        cache->w = w;
+        cache->h = h;
+        cache->valid = false;
+        if (!cache->texture) {
+            render_axes_3d(cv, ax);
+            return;
+        }
+        SDL_SetTextureBlendMode(cache->texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    }
+
+    // --- STEP 3: Re-render only if something the image depends on changed ---
+    CameraKey key = camera_key(ax);
+    if (!cache->valid || memcmp(&key, &cache->key, sizeof(key)) != 0) {
+        SDL_Texture* previous = SDL_GetRenderTarget(cv->renderer);
+        SDL_SetRenderTarget(cv->renderer, cache->texture);
+        SDL_SetRenderDrawColor(cv->renderer, 0, 0, 0, 0);
+        SDL_RenderClear(cv->renderer);
+
+        Canvas sub = *cv;
+        sub.width = (float)w / s;
+        sub.height = (float)h / s;
+        canvas_set_transform(&sub, s, x0 * s, y0 * s, cv->text_font);
+        render_axes_3d(&sub, ax);
+
+        SDL_SetRenderTarget(cv->renderer, previous);
+        cache->key = key;
+        cache->valid = true;
+    }
+
+    // --- STEP 4: Composite ---
+    SDL_FRect dst = { x0 * s, y0 * s, (float)w, (float)h };
+    SDL_RenderTexture(cv->renderer, cache->texture, NULL, &dst);
+}
+
+/**
+ * @brief Forces the next frame to re-render a 3D axes (e.g. after its data changed in place).
+ */
+void axes_invalidate_cache(Axes* ax) {
+    if (ax && ax->cache) ax->cache->valid = false;
+}
+
+/**
+ * @brief Frees an Axes' cached image. Must be called before its renderer is destroyed.
+ */
+void axes_release_cache(Axes* ax) {
+    if (!ax || !ax->cache) return;
+    if (ax->cache->texture) SDL_DestroyTexture(ax->cache->texture);
+    free(ax->cache);
+    ax->cache = NULL;
+}
@@ -0,0 +1,233 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <math.h>
+#include "sdl_canvas.h"
+
+// Maximum segments expanded into one SDL_RenderGeometry call
+#define RENDER_BATCH_SEGMENTS 8192
+
+// Copies points into the arena in output space (NULL if the arena is exhausted)
+static SDL_FPoint* transform_points(Canvas* cv, const SDL_FPoint* pts, int count) {
+    SDL_FPoint* out = arena_alloc_array(cv->arena, SDL_FPoint, count);
+    if (!out) return NULL;
+    for (int i = 0; i < count; i++) {
+        out[i].x = canvas_px(cv, pts[i].x);
+        out[i].y = canvas_py(cv, pts[i].y);
+    }
+    return out;
+}
+
+static void sdl_set_color(Canvas* cv, SDL_Color color) {
+    SDL_SetRenderDrawColor(cv->renderer, color.r, color.g, color.b, color.a);
+}
+
+static void sdl_line(Canvas* cv, float x1, float y1, float x2, float y2) {
+    if (cv->scale > 1.0f) {
+        RenderThickLine(cv->renderer, canvas_px(cv, x1), canvas_py(cv, y1), canvas_px(cv, x2), canvas_py(cv, y2), cv->scale);
+    } else {
+        SDL_RenderLine(cv->renderer, canvas_px(cv, x1), canvas_py(cv, y1), canvas_px(cv, x2), canvas_py(cv, y2));
+    }
+}
+
+/**
+ * @brief Renders a polyline as a handful of batched geometry calls.
+ * * Instead of one SDL_RenderGeometry call per segment (see RenderThickLine), every
+ * segment of a solid line is expanded into a quad inside a scratch vertex buffer
+ * taken from the frame arena. The buffer is reused for chunks of
+ * RENDER_BATCH_SEGMENTS segments so memory stays bounded regardless of the series
+ * length. Dashed and dotted lines still go through DrawDashedThickLine.
+ */
+static void sdl_polyline(Canvas* cv, const SDL_FPoint* pts, int count, float thickness, LineStyle style) {
+    SDL_Renderer* renderer = cv->renderer;
+    int segments = count - 1;
+
+    if (canvas_is_transformed(cv)) {
+        pts = transform_points(cv, pts, count);
+        if (!pts) return;
+        thickness = (thickness > 1.0f ? thickness : 1.0f) * cv->scale;
+    }
+
+    if (style != STYLE_SOLID) {
+        for (int i = 0; i < segments; i++) {
+            DrawDashedThickLine(renderer, pts[i].x, pts[i].y, pts[i+1].x, pts[i+1].y, thickness, style);
+        }
+        return;
+    }
+    if (thickness <= 1.0f) {
+        SDL_RenderLines(renderer, pts, count);
+        return;
+    }
+
+    int batch = segments < RENDER_BATCH_SEGMENTS ? segments : RENDER_BATCH_SEGMENTS;
+    SDL_Vertex* verts = arena_alloc_array(cv->arena, SDL_Vertex, batch * 4);
+    int* indices = arena_alloc_array(cv->arena, int, batch * 6);
+    if (!verts || !indices) {
+        for (int i = 0; i < segments; i++) {
+            RenderThickLine(renderer, pts[i].x, pts[i].y, pts[i+1].x, pts[i+1].y, thickness);
+        }
+        return;
+    }
+
+    SDL_Color c = cv->color;
+    SDL_FColor fc = { c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+    float half = thickness / 2.0f;
+
+    for (int start = 0; start < segments; start += batch) {
+        int n = 0;
+        int end = (start + batch < segments) ? start + batch : segments;
+        for (int i = start; i < end; i++) {
+            float dx = pts[i+1].x - pts[i].x;
+            float dy = pts[i+1].y - pts[i].y;
+            float len = sqrtf(dx * dx + dy * dy);
+            if (len == 0) continue;
+
+            float vx = -dy / len * half;
+            float vy = dx / len * half;
+            SDL_Vertex* v = &verts[n * 4];
+            v[0].position = (SDL_FPoint){ pts[i].x + vx,   pts[i].y + vy };
+            v[1].position = (SDL_FPoint){ pts[i].x - vx,   pts[i].y - vy };
+            v[2].position = (SDL_FPoint){ pts[i+1].x - vx, pts[i+1].y - vy };
+            v[3].position = (SDL_FPoint){ pts[i+1].x + vx, pts[i+1].y + vy };
+            for (int k = 0; k < 4; k++) {
+                v[k].color = fc;
+                v[k].tex_coord = (SDL_FPoint){ 0, 0 };
+            }
+
+            int base = n * 4;
+            int* idx = &indices[n * 6];
+            idx[0] = base; idx[1] = base + 1; idx[2] = base + 2;
+            idx[3] = base; idx[4] = base + 2; idx[5] = base + 3;
+            n++;
+        }
+        if (n > 0) SDL_RenderGeometry(renderer, NULL, verts, n * 4, indices, n * 6);
+    }
+}
+
+static void sdl_rect(Canvas* cv, const SDL_FRect* rect, bool filled) {
+    SDL_FRect r = { canvas_px(cv, rect->x), canvas_py(cv, rect->y), rect->w * cv->scale, rect->h * cv->scale };
+    if (filled) {
+        SDL_RenderFillRect(cv->renderer, &r);
+    } else if (cv->scale > 1.0f) {
+        sdl_line(cv, rect->x, rect->y, rect->x + rect->w, rect->y);
+        sdl_line(cv, rect->x + rect->w, rect->y, rect->x + rect->w, rect->y + rect->h);
+        sdl_line(cv, rect->x + rect->w, rect->y + rect->h, rect->x, rect->y + rect->h);
+        sdl_line(cv, rect->x, rect->y + rect->h, rect->x, rect->y);
+    } else {
+        SDL_RenderRect(cv->renderer, &r);
+    }
+}
+
+// Square markers centered on each point, submitted with a single fill call
+static void sdl_markers(Canvas* cv, const SDL_FPoint* centers, int count, float size) {
+    SDL_FRect* rects = arena_alloc_array(cv->arena, SDL_FRect, count);
+    if (!rects) return;
+    size *= cv->scale;
+    float half = size / 2.0f;
+    for (int i = 0; i < count; i++) {
+        rects[i] = (SDL_FRect){ canvas_px(cv, centers[i].x) - half, canvas_py(cv, centers[i].y) - half, size, size };
+    }
+    SDL_RenderFillRects(cv->renderer, rects, count);
+}
+
+static void sdl_image(Canvas* cv, SDL_Texture* texture, const SDL_Vertex* vertices, int num_vertices, const int* indices, int num_indices) {
+    if (canvas_is_transformed(cv)) {
+        SDL_Vertex* v = arena_alloc_array(cv->arena, SDL_Vertex, num_vertices);
+        if (!v) return;
+        for (int i = 0; i < num_vertices; i++) {
+            v[i] = vertices[i];
+            v[i].position.x = canvas_px(cv, vertices[i].position.x);
+            v[i].position.y = canvas_py(cv, vertices[i].position.y);
+        }
+        vertices = v;
+    }
+    SDL_RenderGeometry(cv->renderer, texture, vertices, num_vertices, indices, num_indices);
+}
+
+static void sdl_geometry(Canvas* cv, const SDL_Vertex* vertices, int num_vertices, const int* indices, int num_indices) {
+    sdl_image(cv, NULL, vertices, num_vertices, indices, num_indices);
+}
+
+static void sdl_text(Canvas* cv, const char* text, float x, float y, bool right_align, SDL_Color color) {
+    TTF_Font* font = cv->text_font ? cv->text_font : cv->font;
+    draw_text(cv->renderer, font, text, canvas_px(cv, x), canvas_py(cv, y), right_align, color);
+}
+
+/**
+ * @brief Draws a cached tick label, rasterizing it only the first time it is used.
+ * * Works like draw_text(), but keeps the texture in the TickCache so that steady
+ * frames render tick labels without any surface/texture creation.
+ */
+static void sdl_tick_label(Canvas* cv, TickCache* tc, int i, float x, float y, bool right_align, SDL_Color color) {
+    // Textures are cached per font, so a scaled canvas (HiDPI window, scaled export)
+    // keeps its own sharp labels instead of stretching the 1x ones
+    TTF_Font* font = cv->text_font ? cv->text_font : cv->font;
+    if (!font) return;
+    if (tc->texture_font != font) {
+        ticks_release_textures(tc);
+        tc->texture_font = font;
+    }
+    if (!tc->textures[i]) {
+        SDL_Surface* surface = TTF_RenderText_Blended(font, tc->labels[i], 0, color);
+        if (!surface) return;
+        tc->textures[i] = SDL_CreateTextureFromSurface(cv->renderer, surface);
+        tc->label_w[i] = (float)surface->w;
+        tc->label_h[i] = (float)surface->h;
+        SDL_DestroySurface(surface);
+        if (!tc->textures[i]) return;
+    }
+
+    float w = tc->label_w[i];
+    float h = tc->label_h[i];
+    x = canvas_px(cv, x);
+    y = canvas_py(cv, y);
+    SDL_FRect dst = { right_align ? x - w : x - (w / 2.0f), y - (h / 2.0f), w, h };
+    SDL_RenderTexture(cv->renderer, tc->textures[i], NULL, &dst);
+}
+
+static const CanvasOps sdl_canvas_ops = {
+    sdl_set_color, sdl_line, sdl_polyline, sdl_rect, sdl_markers, sdl_geometry, sdl_image, sdl_text, sdl_tick_label
+};
+
+/**
+ * @brief Prepares a Canvas that draws straight to an SDL_Renderer.
+ * * @param cv       Pointer to the Canvas to initialize.
+ * @param renderer The SDL_Renderer to draw with.
+ * @param font     The TTF_Font used for text.
+ * @param arena    Scratch memory for batched geometry (usually the Figure's frame arena).
+ */
+void canvas_init_sdl(Canvas* cv, SDL_Renderer* renderer, TTF_Font* font, FrameArena* arena) {
+    int w = 0, h = 0;
+    cv->ops = &sdl_canvas_ops;
+    cv->color = (SDL_Color){0, 0, 0, 255};
+    cv->font = font;
+    cv->arena = arena;
+    cv->renderer = renderer;
+    cv->out = NULL;
+    cv->raster = NULL;
+    cv->scale = 1.0f;
+    cv->origin_x = cv->origin_y = 0.0f;
+    cv->text_font = NULL;
+    if (renderer) SDL_GetRenderOutputSize(renderer, &w, &h);
+    cv->width = (float)w;
+    cv->height = (float)h;
+}
+
+/**
+ * @brief Sets the output transform applied by the SDL backend.
+ * * Layout code keeps working in window coordinates; every primitive is mapped to 
+ * `coord * scale - origin` before it reaches the renderer. Line widths and marker
+ * sizes grow with the scale, so a scaled render looks like an enlarged window 
+ * rather than the same picture with hairlines.
+ * * @param cv        Pointer to the Canvas.
+ * @param scale     Output pixels per window pixel.
+ * @param origin_x  Output-space x coordinate that maps to the left edge of the target.
+ * @param origin_y  Output-space y coordinate that maps to the top edge of the target.
+ * @param text_font Font already sized for @p scale, or NULL to reuse cv->font.
+ */
+void canvas_set_transform(Canvas* cv, float scale, float origin_x, float origin_y, TTF_Font* text_font) {
+    if (!cv) return;
+    cv->scale = scale > 0.0f ? scale : 1.0f;
+    cv->origin_x = origin_x;
+    cv->origin_y = origin_y;
+    cv->text_font = text_font;
+}
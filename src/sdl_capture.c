@@ -0,0 +1,474 @@
+#include <SDL3/SDL.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "sdl_capture.h"
+#include "sdl_canvas.h"
+#include "sdl_link.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define PYRAMID_MAX_THREADS 16
+
+// --- Memory mapping ---------------------------------------------------------
+
+static bool map_file(const char* path, MappedFile* mf) {
+    memset(mf, 0, sizeof(*mf));
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!data) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    mf->data = data;
+    mf->size = (size_t)size.QuadPart;
+    mf->handle[0] = (intptr_t)file;
+    mf->handle[1] = (intptr_t)mapping;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    mf->data = data;
+    mf->size = (size_t)st.st_size;
+    mf->handle[0] = fd;
+#endif
+    return true;
+}
+
+static void unmap_file(MappedFile* mf) {
+    if (!mf->data) return;
+    if (mf->heap) {
+        free(mf->data);
+        mf->data = NULL;
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mf->data);
+    CloseHandle((HANDLE)mf->handle[1]);
+    CloseHandle((HANDLE)mf->handle[0]);
+#else
+    munmap(mf->data, mf->size);
+    close((int)mf->handle[0]);
+#endif
+    mf->data = NULL;
+}
+
+static int64_t file_mtime(const char* path) {
+    struct stat st;
+    return (stat(path, &st) == 0) ? (int64_t)st.st_mtime : 0;
+}
+
+// --- Pyramid construction ---------------------------------------------------
+
+typedef struct {
+    const float* samples;
+    int channels;
+    uint64_t count;
+    uint64_t block_begin, block_end; // Level-0 blocks handled by this worker
+    uint64_t blocks;                 // Total level-0 blocks per channel
+    float* level0;
+} PyramidJob;
+
+// Level 0: one sequential pass over a slice of the interleaved samples
+static int pyramid_worker(void* data) {
+    PyramidJob* job = (PyramidJob*)data;
+    int ch = job->channels;
+    float* mn = malloc(sizeof(float) * ch * 2);
+    if (!mn) return -1;
+    float* mx = mn + ch;
+
+    for (uint64_t b = job->block_begin; b < job->block_end; b++) {
+        uint64_t s0 = b * PYRAMID_BASE_BLOCK;
+        uint64_t s1 = s0 + PYRAMID_BASE_BLOCK < job->count ? s0 + PYRAMID_BASE_BLOCK : job->count;
+        for (int c = 0; c < ch; c++) { mn[c] = INFINITY; mx[c] = -INFINITY; }
+        for (uint64_t i = s0; i < s1; i++) {
+            const float* row = job->samples + i * ch;
+            for (int c = 0; c < ch; c++) {
+                // NaN fails both comparisons, so gaps never poison the envelope
+                if (row[c] < mn[c]) mn[c] = row[c];
+                if (row[c] > mx[c]) mx[c] = row[c];
+            }
+        }
+        for (int c = 0; c < ch; c++) {
+            float* out = job->level0 + (c * job->blocks + b) * 2;
+            out[0] = mn[c];
+            out[1] = mx[c];
+        }
+    }
+    free(mn);
+    return 0;
+}
+
+static uint64_t level_block_samples(int level) {
+    uint64_t n = PYRAMID_BASE_BLOCK;
+    for (int l = 0; l < level; l++) n *= PYRAMID_FANOUT;
+    return n;
+}
+
+// Computes the sidecar image (header + every level) of a capture into a heap buffer
+static Uint8* pyramid_compute(const char* path, int channels, size_t* size) {
+    MappedFile src;
+    if (!map_file(path, &src)) {
+        fprintf(stderr, "Failed to map capture %s\n", path);
+        return NULL;
+    }
+    uint64_t count = src.size / (sizeof(float) * (size_t)channels);
+    if (count == 0) {
+        fprintf(stderr, "Capture %s holds less than one sample\n", path);
+        unmap_file(&src);
+        return NULL;
+    }
+
+    // --- STEP 1: Lay out the levels ---
+    PyramidHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, PYRAMID_MAGIC, 8);
+    hdr.version = PYRAMID_VERSION;
+    hdr.channels = (uint32_t)channels;
+    hdr.base_block = PYRAMID_BASE_BLOCK;
+    hdr.fanout = PYRAMID_FANOUT;
+    hdr.samples = count;
+    hdr.source_size = src.size;
+    hdr.source_mtime = file_mtime(path);
+
+    uint64_t offset = (sizeof(PyramidHeader) + 63) & ~(uint64_t)63;
+    uint64_t blocks = (count + PYRAMID_BASE_BLOCK - 1) / PYRAMID_BASE_BLOCK;
+    for (int l = 0; l < PYRAMID_MAX_LEVELS; l++) {
+        hdr.level_offset[l] = offset;
+        hdr.level_blocks[l] = blocks;
+        hdr.levels = (uint32_t)(l + 1);
+        offset += blocks * (uint64_t)channels * 2 * sizeof(float);
+        if (blocks == 1) break;
+        blocks = (blocks + PYRAMID_FANOUT - 1) / PYRAMID_FANOUT;
+    }
+
+    Uint8* file = calloc(1, (size_t)offset);
+    if (!file) {
+        fprintf(stderr, "Out of memory for the pyramid of %s (%llu bytes)\n", path, (unsigned long long)offset);
+        unmap_file(&src);
+        return NULL;
+    }
+    memcpy(file, &hdr, sizeof(hdr));
+
+    // --- STEP 2: Level 0 in parallel ---
+    int threads = SDL_GetNumLogicalCPUCores();
+    if (threads < 1) threads = 1;
+    if (threads > PYRAMID_MAX_THREADS) threads = PYRAMID_MAX_THREADS;
+    if ((uint64_t)threads > hdr.level_blocks[0]) threads = (int)hdr.level_blocks[0];
+
+    PyramidJob jobs[PYRAMID_MAX_THREADS];
+    SDL_Thread* workers[PYRAMID_MAX_THREADS];
+    uint64_t per_thread = (hdr.level_blocks[0] + threads - 1) / threads;
+    for (int t = 0; t < threads; t++) {
+        jobs[t].samples = (const float*)src.data;
+        jobs[t].channels = channels;
+        jobs[t].count = count;
+        jobs[t].blocks = hdr.level_blocks[0];
+        jobs[t].block_begin = t * per_thread;
+        jobs[t].block_end = (t + 1) * per_thread < hdr.level_blocks[0] ? (t + 1) * per_thread : hdr.level_blocks[0];
+        jobs[t].level0 = (float*)(file + hdr.level_offset[0]);
+        workers[t] = (t > 0) ? SDL_CreateThread(pyramid_worker, "pyramid_worker", &jobs[t]) : NULL;
+    }
+    bool ok = pyramid_worker(&jobs[0]) == 0; // The calling thread takes the first slice
+    for (int t = 1; t < threads; t++) {
+        int status = -1;
+        if (workers[t]) {
+            SDL_WaitThread(workers[t], &status);
+        } else {
+            status = pyramid_worker(&jobs[t]); // Thread creation failed: do it inline
+        }
+        if (status != 0) ok = false;
+    }
+    unmap_file(&src);
+
+    // --- STEP 3: Coarser levels from the level below (1/64th of the data) ---
+    for (uint32_t l = 1; ok && l < hdr.levels; l++) {
+        const float* below = (const float*)(file + hdr.level_offset[l - 1]);
+        float* level = (float*)(file + hdr.level_offset[l]);
+        uint64_t nb_below = hdr.level_blocks[l - 1];
+        for (int c = 0; c < channels; c++) {
+            for (uint64_t b = 0; b < hdr.level_blocks[l]; b++) {
+                float mn = INFINITY, mx = -INFINITY;
+                uint64_t k1 = (b + 1) * PYRAMID_FANOUT < nb_below ? (b + 1) * PYRAMID_FANOUT : nb_below;
+                for (uint64_t k = b * PYRAMID_FANOUT; k < k1; k++) {
+                    const float* p = below + (c * nb_below + k) * 2;
+                    if (p[0] < mn) mn = p[0];
+                    if (p[1] > mx) mx = p[1];
+                }
+                level[(c * hdr.level_blocks[l] + b) * 2] = mn;
+                level[(c * hdr.level_blocks[l] + b) * 2 + 1] = mx;
+            }
+        }
+    }
+
+    if (!ok) {
+        fprintf(stderr, "Failed to compute the pyramid of %s\n", path);
+        free(file);
+        return NULL;
+    }
+    *size = (size_t)offset;
+    return file;
+}
+
+// Writes a sidecar image, saying which step failed and why
+static bool pyramid_write(const char* sidecar, const Uint8* file, size_t size) {
+    FILE* out = fopen(sidecar, "wb");
+    if (!out) {
+        fprintf(stderr, "Cannot create pyramid %s: %s\n", sidecar, strerror(errno));
+        return false;
+    }
+    bool ok = fwrite(file, 1, size, out) == size;
+    int err = errno;
+    if (fclose(out) != 0 && ok) {
+        ok = false;
+        err = errno;
+    }
+    if (!ok) {
+        fprintf(stderr, "Failed to write pyramid %s: %s\n", sidecar, strerror(err));
+        remove(sidecar);
+    }
+    return ok;
+}
+
+/**
+ * @brief Computes the min/max pyramid of a capture and writes it next to it.
+ * * Level 0 (one min/max pair per PYRAMID_BASE_BLOCK samples) is computed by up to 
+ * one thread per CPU core, each streaming through a contiguous slice of the file. 
+ * Each further level combines PYRAMID_FANOUT blocks of the previous one, until a 
+ * single block covers the whole capture. The result is written to "<path>.pyr".
+ * * @param path     Path of the raw capture (interleaved float32 samples).
+ * @param channels Number of interleaved channels.
+ * @return true if the sidecar file was written.
+ */
+bool capture_build_pyramid(const char* path, int channels) {
+    if (!path || channels <= 0) return false;
+    size_t size = 0;
+    Uint8* file = pyramid_compute(path, channels, &size);
+    if (!file) return false;
+
+    char sidecar[1024];
+    snprintf(sidecar, sizeof(sidecar), "%s.pyr", path);
+    bool ok = pyramid_write(sidecar, file, size);
+    free(file);
+    return ok;
+}
+
+// A sidecar is usable if it matches the capture it was built from
+static bool pyramid_valid(const MappedFile* pyr, const MappedFile* src, const char* path, int channels) {
+    if (pyr->size < sizeof(PyramidHeader)) return false;
+    const PyramidHeader* h = (const PyramidHeader*)pyr->data;
+    if (memcmp(h->magic, PYRAMID_MAGIC, 8) != 0 || h->version != PYRAMID_VERSION) return false;
+    if (h->channels != (uint32_t)channels || h->base_block != PYRAMID_BASE_BLOCK || h->fanout != PYRAMID_FANOUT) return false;
+    if (h->source_size != src->size || h->source_mtime != file_mtime(path)) return false;
+    if (h->levels == 0 || h->levels > PYRAMID_MAX_LEVELS) return false;
+    uint32_t last = h->levels - 1;
+    uint64_t end = h->level_offset[last] + h->level_blocks[last] * (uint64_t)channels * 2 * sizeof(float);
+    return end <= pyr->size;
+}
+
+/**
+ * @brief Memory-maps a raw capture and its min/max pyramid.
+ * * The capture file holds interleaved float32 samples (channel 0, 1, ..., then the 
+ * next sample). If "<path>.pyr" is missing or was built from a different version 
+ * of the file, it is regenerated once (see capture_build_pyramid()); otherwise it 
+ * is mapped as-is, so opening even a multi-GB capture and drawing it zoomed out 
+ * touches only a few kilobytes. If the sidecar can't be written (read-only media, 
+ * no permission), the pyramid is kept in memory for as long as the capture is open.
+ * * @param path        Path of the raw capture.
+ * @param channels    Number of interleaved channels.
+ * @param sample_rate Samples per second (x spacing is 1 / sample_rate).
+ * @return A new Capture, or NULL on failure. Free it with capture_close().
+ */
+Capture* capture_open(const char* path, int channels, double sample_rate) {
+    if (!path || channels <= 0 || !(sample_rate > 0)) return NULL;
+
+    Capture* cap = calloc(1, sizeof(Capture));
+    if (!cap) return NULL;
+    if (!map_file(path, &cap->source)) {
+        fprintf(stderr, "Failed to map capture %s\n", path);
+        free(cap);
+        return NULL;
+    }
+
+    char sidecar[1024];
+    snprintf(sidecar, sizeof(sidecar), "%s.pyr", path);
+    bool mapped = map_file(sidecar, &cap->pyramid);
+    if (!mapped || !pyramid_valid(&cap->pyramid, &cap->source, path, channels)) {
+        if (mapped) unmap_file(&cap->pyramid);
+        size_t size = 0;
+        Uint8* image = pyramid_compute(path, channels, &size);
+        if (!image) {
+            capture_close(cap);
+            return NULL;
+        }
+        if (pyramid_write(sidecar, image, size) && map_file(sidecar, &cap->pyramid)) {
+            free(image); // Mapped from disk: shared with other processes, paged on demand
+        } else {
+            fprintf(stderr, "Keeping the pyramid of %s in memory (%zu bytes)\n", path, size);
+            cap->pyramid.data = image;
+            cap->pyramid.size = size;
+            cap->pyramid.heap = true;
+        }
+    }
+
+    cap->samples = (const float*)cap->source.data;
+    cap->header = (const PyramidHeader*)cap->pyramid.data;
+    cap->channels = channels;
+    cap->count = cap->header->samples;
+    cap->sample_rate = sample_rate;
+    cap->x_origin = 0.0;
+    return cap;
+}
+
+/**
+ * @brief Unmaps a capture. Series plotting it must not be drawn afterwards.
+ */
+void capture_close(Capture* cap) {
+    if (!cap) return;
+    unmap_file(&cap->pyramid);
+    unmap_file(&cap->source);
+    free(cap);
+}
+
+static inline const float* pyramid_level(const Capture* cap, int level, int channel) {
+    const PyramidHeader* h = cap->header;
+    return (const float*)((const Uint8*)cap->pyramid.data + h->level_offset[level]) +
+           (uint64_t)channel * h->level_blocks[level] * 2;
+}
+
+/**
+ * @brief Gets the overall value range of a channel from the top pyramid level.
+ * * @return false if the channel contains no finite samples.
+ */
+bool capture_channel_range(const Capture* cap, int channel, float* y_min, float* y_max) {
+    if (!cap || channel < 0 || channel >= cap->channels) return false;
+    int top = (int)cap->header->levels - 1;
+    const float* lv = pyramid_level(cap, top, channel);
+    float mn = INFINITY, mx = -INFINITY;
+    for (uint64_t b = 0; b < cap->header->level_blocks[top]; b++) {
+        if (lv[b * 2] < mn) mn = lv[b * 2];
+        if (lv[b * 2 + 1] > mx) mx = lv[b * 2 + 1];
+    }
+    if (!(mn <= mx)) return false;
+    *y_min = mn;
+    *y_max = mx;
+    return true;
+}
+
+/**
+ * @brief Computes the min/max envelope of a channel for a range of pixel columns.
+ * * Picks the coarsest pyramid level whose blocks are no wider than one column, 
+ * so each column reads at most about PYRAMID_FANOUT blocks. Only when zoomed in
+ * below PYRAMID_BASE_BLOCK samples per column are raw samples read. The cost
+ * depends on the number of columns, not on the length of the capture.
+ * * @param cap      The Capture.
+ * @param channel  Channel index.
+ * @param x_lo     x value at the left edge of column 0.
+ * @param x_hi     x value at the right edge of the last column.
+ * @param columns  Number of columns.
+ * @param out_min  Receives the minimum per column (NaN where there is no data).
+ * @param out_max  Receives the maximum per column (NaN where there is no data).
+ * @return The number of columns written.
+ */
+int capture_envelope(const Capture* cap, int channel, double x_lo, double x_hi, int columns, float* out_min, float* out_max) {
+    if (!cap || channel < 0 || channel >= cap->channels || columns <= 0 || !(x_hi > x_lo)) return 0;
+
+    double per_column = (x_hi - x_lo) * cap->sample_rate / columns;
+    int level = -1;
+    for (int l = 0; l < (int)cap->header->levels; l++) {
+        if ((double)level_block_samples(l) <= per_column) level = l;
+    }
+    uint64_t block = (level >= 0) ? level_block_samples(level) : 1;
+    const float* lv = (level >= 0) ? pyramid_level(cap, level, channel) : NULL;
+    uint64_t nblocks = (level >= 0) ? cap->header->level_blocks[level] : 0;
+
+    double first = (x_lo - cap->x_origin) * cap->sample_rate;
+    for (int c = 0; c < columns; c++) {
+        double a = floor(first + c * per_column);
+        double b = ceil(first + (c + 1) * per_column);
+        if (a < 0) a = 0;
+        if (b > (double)cap->count) b = (double)cap->count;
+        float mn = INFINITY, mx = -INFINITY;
+        if (a < b) {
+            uint64_t s0 = (uint64_t)a, s1 = (uint64_t)b;
+            if (lv) {
+                uint64_t b1 = (s1 + block - 1) / block;
+                if (b1 > nblocks) b1 = nblocks;
+                for (uint64_t k = s0 / block; k < b1; k++) {
+                    if (lv[k * 2] < mn) mn = lv[k * 2];
+                    if (lv[k * 2 + 1] > mx) mx = lv[k * 2 + 1];
+                }
+            } else {
+                for (uint64_t i = s0; i < s1; i++) {
+                    float v = cap->samples[i * cap->channels + channel];
+                    if (v < mn) mn = v;
+                    if (v > mx) mx = v;
+                }
+            }
+        }
+        out_min[c] = (mn <= mx) ? mn : NAN;
+        out_max[c] = (mn <= mx) ? mx : NAN;
+    }
+    return columns;
+}
+
+/**
+ * @brief Adds a line series that draws one channel of a memory-mapped capture.
+ * * The series holds no sample arrays (count stays 0); render_axes_2d() asks the 
+ * pyramid for a per-column envelope instead. The axes limits are widened to the 
+ * full extent of the capture using the top pyramid level, without touching the 
+ * samples.
+ * * @param ax      Pointer to the Axes to add the series to.
+ * @param cap     The Capture (must outlive the figure, or at least its rendering).
+ * @param channel Channel index.
+ * @param color   Line color.
+ * @return The new Series, or NULL on failure.
+ */
+Series* plot_capture(Axes* ax, Capture* cap, int channel, SDL_Color color) {
+    if (!ax || !cap || channel < 0 || channel >= cap->channels) return NULL;
+
+    plot(ax, NULL, NULL, 0, color);
+    Series* s = &ax->lines[ax->line_count - 1];
+    s->capture = cap;
+    s->capture_channel = channel;
+    s->thickness = 1.0f;
+
+    float lo, hi;
+    if (axes_full_rescan(ax)) {
+        axes_autoscale(ax);
+    } else if (capture_channel_range(cap, channel, &lo, &hi)) {
+        float x0 = (float)cap->x_origin;
+        float x1 = (float)(cap->x_origin + (cap->count - 1) / cap->sample_rate);
+        if (x0 < ax->x_min) ax->x_min = x0;
+        if (x1 > ax->x_max) ax->x_max = x1;
+        if (lo < ax->y_min) ax->y_min = lo;
+        if (hi > ax->y_max) ax->y_max = hi;
+    }
+    return s;
+}
@@ -0,0 +1,81 @@
+#include <SDL3/SDL.h>
+#include "sdl_colormap.h"
+
+// Polynomial fits (degree 6, per channel) of the matplotlib perceptual colormaps
+static const float viridis_coeffs[7][3] = {
+    { 0.2777273272234177f, 0.005407344544966578f, 0.3340998053353061f },
+    { 0.1050930431085774f, 1.404613529898575f, 1.384590162594685f },
+    { -0.3308618287255563f, 0.214847559468213f, 0.09509516302823659f },
+    { -4.634230498983486f, -5.799100973351585f, -19.33244095627987f },
+    { 6.228269936347081f, 14.17993336680509f, 56.69055260068105f },
+    { 4.776384997670288f, -13.74514537774601f, -65.35303263337234f },
+    { -5.435455855934631f, 4.645852612178535f, 26.3124352495832f }
+};
+
+static const float plasma_coeffs[7][3] = {
+    { 0.05873234392399702f, 0.02333670892565664f, 0.5433401826748754f },
+    { 2.176514634195958f, 0.2383834171260182f, 0.7539604599784036f },
+    { -2.689460476458034f, -7.455851135738909f, 3.110799939717086f },
+    { 6.130348345893603f, 42.3461881477227f, -28.51885465332158f },
+    { -11.10743619062271f, -82.66631109428045f, 60.13984767418263f },
+    { 10.02306557647065f, 71.41361770095349f, -54.07218655560067f },
+    { -3.658713842777788f, -22.93153465461149f, 18.19190778539828f }
+};
+
+static const float inferno_coeffs[7][3] = {
+    { 0.0002189403691192265f, 0.001651004631001012f, -0.01948089843709184f },
+    { 0.1065134194856116f, 0.5639564367884091f, 3.932712388889277f },
+    { 11.60249308247187f, -3.972853965665698f, -15.9423941062914f },
+    { -41.70399613139459f, 17.43639888205313f, 44.35414519872813f },
+    { 77.162935699427f, -33.40235894210092f, -81.80730925738993f },
+    { -71.31942824499214f, 32.62606426397723f, 73.20951985803202f },
+    { 25.13112622477341f, -12.24266895238567f, -23.07032500287172f }
+};
+
+static SDL_Color luts[COLORMAP_GRAY + 1][COLORMAP_SIZE];
+static bool lut_ready[COLORMAP_GRAY + 1];
+
+static Uint8 to_byte(float v) {
+    if (v < 0.0f) v = 0.0f;
+    if (v > 1.0f) v = 1.0f;
+    return (Uint8)(v * 255.0f + 0.5f);
+}
+
+static void build_lut(SDL_Color* lut, const float (*c)[3]) {
+    for (int i = 0; i < COLORMAP_SIZE; i++) {
+        float t = (float)i / (COLORMAP_SIZE - 1);
+        float rgb[3];
+        for (int k = 0; k < 3; k++) {
+            // Horner's rule: c0 + t*(c1 + t*(c2 + ...))
+            float v = c[6][k];
+            for (int d = 5; d >= 0; d--) v = v * t + c[d][k];
+            rgb[k] = v;
+        }
+        lut[i] = (SDL_Color){ to_byte(rgb[0]), to_byte(rgb[1]), to_byte(rgb[2]), 255 };
+    }
+}
+
+/**
+ * @brief Returns the 256-entry lookup table of a colormap.
+ * * Tables are computed on first use and then shared, so per-point coloring is a 
+ * single array lookup (see colormap_lookup()).
+ * * @param cmap The colormap.
+ * @return Pointer to COLORMAP_SIZE colors, or NULL for COLORMAP_NONE.
+ */
+const SDL_Color* colormap_lut(Colormap cmap) {
+    if (cmap <= COLORMAP_NONE || cmap > COLORMAP_GRAY) return NULL;
+    if (!lut_ready[cmap]) {
+        switch (cmap) {
+            case COLORMAP_VIRIDIS: build_lut(luts[cmap], viridis_coeffs); break;
+            case COLORMAP_PLASMA:  build_lut(luts[cmap], plasma_coeffs); break;
+            case COLORMAP_INFERNO: build_lut(luts[cmap], inferno_coeffs); break;
+            default:
+                for (int i = 0; i < COLORMAP_SIZE; i++) {
+                    luts[cmap][i] = (SDL_Color){ (Uint8)i, (Uint8)i, (Uint8)i, 255 };
+                }
+                break;
+        }
+        lut_ready[cmap] = true;
+    }
+    return luts[cmap];
+}
@@ -0,0 +1,244 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_context.h"
+
+// One context per process. Figures are created and drawn on the render thread,
+// so it needs no locking.
+static GraphContext g_context;
+
+/**
+ * @brief Takes a reference on the library context.
+ * * subplots() takes one per Figure and destroy_figure() drops it. Programs that
+ * create and destroy figures one after another can hold an extra reference so the
+ * font is parsed once for the whole run rather than once per figure.
+ */
+void context_retain(void) {
+    g_context.refs++;
+}
+
+// Closes every font and drops the face bytes (settings are kept)
+static void context_shutdown(GraphContext* ctx) {
+    for (int i = 0; i < ctx->atlas_count; i++) {
+        if (ctx->atlases[i].texture) SDL_DestroyTexture(ctx->atlases[i].texture);
+    }
+    free(ctx->atlases);
+    ctx->atlases = NULL;
+    ctx->atlas_count = ctx->atlas_capacity = 0;
+
+    for (int i = 0; i < ctx->font_count; i++) TTF_CloseFont(ctx->fonts[i].font);
+    free(ctx->fonts);
+    ctx->fonts = NULL;
+    ctx->font_count = ctx->font_capacity = 0;
+
+    if (ctx->owns_data) {
+        SDL_free((void*)ctx->font_data);
+        ctx->font_data = NULL;
+        ctx->font_size = 0;
+        ctx->owns_data = false;
+    }
+}
+
+/**
+ * @brief Drops a reference taken with context_retain(). The last one closes every
+ * shared font, so call it before TTF_Quit().
+ */
+void context_release(void) {
+    if (g_context.refs <= 0) return;
+    if (--g_context.refs == 0) context_shutdown(&g_context);
+}
+
+/**
+ * @brief Chooses the font file figures use (default: CONTEXT_DEFAULT_FONT).
+ * * The file is read into memory once, the first time a font is needed, and every
+ * size is opened from that copy.
+ * * @return false if fonts are already open (the face can't change under them).
+ */
+bool context_set_font_file(const char* path) {
+    if (!path) return false;
+    if (g_context.font_count > 0) {
+        fprintf(stderr, "context_set_font_file: fonts are already in use\n");
+        return false;
+    }
+    if (g_context.owns_data) SDL_free((void*)g_context.font_data);
+    snprintf(g_context.font_path, sizeof(g_context.font_path), "%s", path);
+    g_context.font_data = NULL;
+    g_context.font_size = 0;
+    g_context.owns_data = false;
+    return true;
+}
+
+/**
+ * @brief Makes figures use a font face that is already in memory, e.g. a TTF file
+ * compiled into the program, so startup never touches the filesystem.
+ * * @param data TTF/OTF bytes. Not copied: they must stay valid while any figure exists.
+ * @param size Size of @p data in bytes.
+ * @return false if fonts are already open.
+ */
+bool context_set_font_memory(const void* data, size_t size) {
+    if (!data || size == 0) return false;
+    if (g_context.font_count > 0) {
+        fprintf(stderr, "context_set_font_memory: fonts are already in use\n");
+        return false;
+    }
+    if (g_context.owns_data) SDL_free((void*)g_context.font_data);
+    g_context.font_data = data;
+    g_context.font_size = size;
+    g_context.owns_data = false;
+    return true;
+}
+
+static bool context_load_face(GraphContext* ctx) {
+    if (ctx->font_data) return true;
+    const char* path = ctx->font_path[0] ? ctx->font_path : CONTEXT_DEFAULT_FONT;
+    size_t size = 0;
+    void* data = SDL_LoadFile(path, &size);
+    if (!data) {
+        fprintf(stderr, "Failed to load font %s: %s\n", path, SDL_GetError());
+        return false;
+    }
+    ctx->font_data = data;
+    ctx->font_size = size;
+    ctx->owns_data = true;
+    return true;
+}
+
+/**
+ * @brief Returns the shared font of the given point size, opening it on first use.
+ * * Every Figure, scaled export and text atlas asking for the same size gets the
+ * same TTF_Font, so the face is parsed once per size for the whole process. The
+ * font belongs to the context: do not close it.
+ * * @return The font, or NULL if the face can't be loaded.
+ */
+TTF_Font* context_font(float size) {
+    GraphContext* ctx = &g_context;
+    if (size <= 0.0f) size = CONTEXT_DEFAULT_SIZE;
+    for (int i = 0; i < ctx->font_count; i++) {
+        if (ctx->fonts[i].size == size) return ctx->fonts[i].font;
+    }
+    if (!context_load_face(ctx)) return NULL;
+
+    if (ctx->font_count == ctx->font_capacity) {
+        int cap = ctx->font_capacity ? ctx->font_capacity * 2 : 4;
+        ContextFont* f = realloc(ctx->fonts, sizeof(ContextFont) * (size_t)cap);
+        if (!f) return NULL;
+        ctx->fonts = f;
+        ctx->font_capacity = cap;
+    }
+    TTF_Font* font = TTF_OpenFontIO(SDL_IOFromConstMem(ctx->font_data, ctx->font_size), true, size);
+    if (!font) {
+        fprintf(stderr, "Failed to open font at %.1f pt: %s\n", size, SDL_GetError());
+        return NULL;
+    }
+    ContextFont* cf = &ctx->fonts[ctx->font_count++];
+    cf->size = size;
+    cf->font = font;
+    layout_measure_font(&cf->metrics, font);
+    return font;
+}
+
+/**
+ * @brief Returns the layout metrics of a context font, measured when it was opened.
+ * * @return NULL for fonts the context doesn't own. The pointer is only valid
+ * until the next context_font() call; copy the table.
+ */
+const FontMetrics* context_font_metrics(TTF_Font* font) {
+    for (int i = 0; font && i < g_context.font_count; i++) {
+        if (g_context.fonts[i].font == font) return &g_context.fonts[i].metrics;
+    }
+    return NULL;
+}
+
+// Rasterizes each glyph as a one-character text render and packs the cells in shelves
+static bool atlas_build(GlyphAtlas* ga, SDL_Renderer* renderer, TTF_Font* font) {
+    SDL_Surface* glyphs[GLYPH_COUNT];
+    SDL_Color white = { 255, 255, 255, 255 };
+    float x = 0.0f, y = 0.0f, row_h = 0.0f;
+
+    ga->renderer = renderer;
+    ga->font = font;
+    ga->texture = NULL;
+    ga->height = (float)TTF_GetFontHeight(font);
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        char s[2] = { (char)(GLYPH_FIRST + i), '\0' };
+        glyphs[i] = TTF_RenderText_Blended(font, s, 1, white); // NULL for blank glyphs
+        float w = glyphs[i] ? (float)glyphs[i]->w : 0.0f;
+        float h = glyphs[i] ? (float)glyphs[i]->h : 0.0f;
+        int advance = 0;
+        ga->advance[i] = TTF_GetGlyphMetrics(font, (Uint32)(GLYPH_FIRST + i), NULL, NULL, NULL, NULL, &advance)
+                         ? (float)advance : w;
+        if (x + w > GLYPH_ATLAS_WIDTH) {
+            x = 0.0f;
+            y += row_h + 1.0f;
+            row_h = 0.0f;
+        }
+        ga->cell[i] = (SDL_FRect){ x, y, w, h };
+        x += w + 1.0f; // 1px gutter keeps neighbours out of filtered samples
+        if (h > row_h) row_h = h;
+    }
+
+    bool ok = false;
+    SDL_Surface* atlas = SDL_CreateSurface(GLYPH_ATLAS_WIDTH, (int)(y + row_h) + 1, SDL_PIXELFORMAT_ARGB8888);
+    if (atlas) {
+        SDL_FillSurfaceRect(atlas, NULL, 0);
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            if (!glyphs[i]) continue;
+            SDL_Rect dst = { (int)ga->cell[i].x, (int)ga->cell[i].y, glyphs[i]->w, glyphs[i]->h };
+            SDL_SetSurfaceBlendMode(glyphs[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyphs[i], NULL, atlas, &dst);
+        }
+        ga->texture = SDL_CreateTextureFromSurface(renderer, atlas);
+        if (ga->texture) SDL_SetTextureBlendMode(ga->texture, SDL_BLENDMODE_BLEND);
+        ok = ga->texture != NULL;
+        SDL_DestroySurface(atlas);
+    }
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (glyphs[i]) SDL_DestroySurface(glyphs[i]);
+    }
+    return ok;
+}
+
+/**
+ * @brief Returns the glyph atlas of a context font on a renderer, building it on first use.
+ * * Lets draw_text() draw any ASCII string as one textured batch instead of
+ * rasterizing it every frame. Atlases are kept per (renderer, font) pair, i.e. per
+ * window and point size.
+ * * @return NULL for fonts the context doesn't own, or if the atlas can't be built.
+ */
+const GlyphAtlas* context_glyphs(SDL_Renderer* renderer, TTF_Font* font) {
+    GraphContext* ctx = &g_context;
+    if (!renderer || !context_font_metrics(font)) return NULL;
+    for (int i = 0; i < ctx->atlas_count; i++) {
+        if (ctx->atlases[i].renderer == renderer && ctx->atlases[i].font == font) {
+            return ctx->atlases[i].texture ? &ctx->atlases[i] : NULL;
+        }
+    }
+    if (ctx->atlas_count == ctx->atlas_capacity) {
+        int cap = ctx->atlas_capacity ? ctx->atlas_capacity * 2 : 4;
+        GlyphAtlas* a = realloc(ctx->atlases, sizeof(GlyphAtlas) * (size_t)cap);
+        if (!a) return NULL;
+        ctx->atlases = a;
+        ctx->atlas_capacity = cap;
+    }
+    GlyphAtlas* ga = &ctx->atlases[ctx->atlas_count++];
+    // A failed build is remembered (texture = NULL) so it isn't retried every frame
+    return atlas_build(ga, renderer, font) ? ga : NULL;
+}
+
+/**
+ * @brief Destroys every atlas created on a renderer. Call before SDL_DestroyRenderer().
+ */
+void context_release_renderer(SDL_Renderer* renderer) {
+    GraphContext* ctx = &g_context;
+    int kept = 0;
+    for (int i = 0; i < ctx->atlas_count; i++) {
+        if (ctx->atlases[i].renderer == renderer) {
+            if (ctx->atlases[i].texture) SDL_DestroyTexture(ctx->atlases[i].texture);
+        } else {
+            ctx->atlases[kept++] = ctx->atlases[i];
+        }
+    }
+    ctx->atlas_count = kept;
+}
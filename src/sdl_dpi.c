@@ -0,0 +1,106 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <math.h>
+#include "sdl_dpi.h"
+#include "sdl_layout.h"
+#include "sdl_context.h"
+
+static bool is_unit_scale(float s) {
+    return fabsf(s - 1.0f) < DPI_SCALE_EPSILON;
+}
+
+/**
+ * @brief Re-reads the window's pixel density and display scale.
+ * * Layout, ticks and every hard-coded size (tick length, legend box, label offsets)
+ * work in layout pixels: a 16 pt font and 1 px lines at 100% display scale. Frames
+ * are drawn at the window's native pixel size through the canvas transform, with
+ * text from a context font sized for the scale, so a 200% display gets crisp text and
+ * 2 px lines rather than an upscaled framebuffer. At 100% nothing is transformed and
+ * no extra font or atlas is created.
+ * * Called when the window is created and on resize, pixel-size and display-scale
+ * events.
+ * * @param fig Pointer to the Figure.
+ * @return true if the scale or the layout size changed.
+ */
+bool figure_update_scale(Figure* fig) {
+    if (!fig || !fig->window) return false;
+    int pw = 0, ph = 0, ww = 0, wh = 0;
+    SDL_GetWindowSizeInPixels(fig->window, &pw, &ph);
+    SDL_GetWindowSize(fig->window, &ww, &wh);
+    if (pw <= 0 || ph <= 0 || ww <= 0) return false; // Minimized
+
+    // Output pixels per layout pixel: pixel density x the display's content scale
+    float scale = SDL_GetWindowDisplayScale(fig->window);
+    if (scale <= 0.0f) scale = 1.0f; // 0 on error
+    if (is_unit_scale(scale)) scale = 1.0f;
+
+    int width = (int)(pw / scale + 0.5f);
+    int height = (int)(ph / scale + 0.5f);
+    bool changed = scale != fig->pixel_scale || width != fig->width || height != fig->height;
+
+    if (scale != fig->pixel_scale) {
+        fig->pixel_scale = scale;
+        fig->text_font = NULL;
+        if (scale != 1.0f && fig->font) {
+            // Whole point sizes, so nearby scales share one font and glyph atlas
+            fig->text_font = context_font(roundf(TTF_GetFontSize(fig->font) * scale));
+        }
+    }
+    fig->event_scale = (float)pw / ((float)ww * scale);
+    if (is_unit_scale(fig->event_scale)) fig->event_scale = 1.0f;
+
+    if (changed) {
+        fig->width = width;
+        fig->height = height;
+        layout_resize(fig, width, height); // Solved on the next frame
+        fig->dirty = true;
+    }
+    return changed;
+}
+
+/**
+ * @brief Resizes a new window so its layout size is the size passed to subplots().
+ * * Where window coordinates are physical pixels (Windows, X11), an 800x600 figure on
+ * a 150% display gets a 1200x900 window. Where they are already scaled points (macOS,
+ * Wayland) the window is left as created.
+ */
+void figure_fit_window(Figure* fig) {
+    if (!fig || !fig->window) return;
+    int width = fig->width, height = fig->height;
+    fig->pixel_scale = 0.0f; // Force a full refresh
+    figure_update_scale(fig);
+    if (fig->event_scale == 1.0f || width <= 0 || height <= 0) return;
+
+    SDL_SetWindowSize(fig->window, (int)(width / fig->event_scale + 0.5f), (int)(height / fig->event_scale + 0.5f));
+    SDL_SyncWindow(fig->window); // Some backends resize asynchronously
+    figure_update_scale(fig);
+}
+
+/**
+ * @brief Converts a mouse event's window coordinates to layout pixels, in place.
+ * * Hover, picking and the 3D camera compare mouse positions with the Axes rects,
+ * which are in layout pixels.
+ */
+void figure_scale_event(const Figure* fig, SDL_Event* event) {
+    if (!fig || !event || fig->event_scale == 1.0f) return;
+    float s = fig->event_scale;
+    switch (event->type) {
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+            event->button.x *= s;
+            event->button.y *= s;
+            break;
+        case SDL_EVENT_MOUSE_MOTION:
+            event->motion.x *= s;
+            event->motion.y *= s;
+            event->motion.xrel *= s;
+            event->motion.yrel *= s;
+            break;
+        case SDL_EVENT_MOUSE_WHEEL:
+            event->wheel.mouse_x *= s;
+            event->wheel.mouse_y *= s;
+            break;
+        default:
+            break;
+    }
+}
@@ -0,0 +1,199 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sdl_canvas.h"
+#include "sdl_png_writer.h"
+#include "sdl_raster.h"
+#include "sdl_context.h"
+#include "sdl_startup.h"
+
+// Offscreen tile size. Tiles span a horizontal band of the image; only one band
+// of RGB rows is ever held in memory.
+#define EXPORT_TILE_W 1024
+#define EXPORT_TILE_H 256
+
+// Copies one rendered tile into the band buffer as tightly packed RGB24
+static bool read_tile(SDL_Renderer* renderer, uint8_t* band, int band_pitch, int x0, int w, int h) {
+    SDL_Surface* raw = SDL_RenderReadPixels(renderer, NULL);
+    if (!raw) return false;
+    SDL_Surface* rgb = SDL_ConvertSurface(raw, SDL_PIXELFORMAT_RGB24);
+    SDL_DestroySurface(raw);
+    if (!rgb) return false;
+
+    if (w > rgb->w) w = rgb->w;
+    if (h > rgb->h) h = rgb->h;
+    for (int r = 0; r < h; r++) {
+        memcpy(band + (size_t)r * band_pitch + (size_t)x0 * 3,
+               (const uint8_t*)rgb->pixels + (size_t)r * rgb->pitch, (size_t)w * 3);
+    }
+    SDL_DestroySurface(rgb);
+    return true;
+}
+
+// Scale/layout/font state shared by the export paths
+typedef struct {
+    int win_w, win_h;
+    float scale;
+    TTF_Font* text_font;
+} ExportSetup;
+
+// Enlarges the window layout uniformly to width x height (see save_figure_as_png_scaled)
+static bool export_begin(Figure* fig, int width, int height, ExportSetup* ex) {
+    ex->win_w = ex->win_h = 0;
+    ex->text_font = NULL;
+    figure_ensure_font(fig);
+    figure_size(fig, &ex->win_w, &ex->win_h);
+    if (ex->win_w <= 0 || ex->win_h <= 0) return false;
+
+    float sx = (float)width / ex->win_w;
+    float sy = (float)height / ex->win_h;
+    ex->scale = sx < sy ? sx : sy;
+    update_layout(fig, (int)(width / ex->scale + 0.5f), (int)(height / ex->scale + 0.5f));
+
+    if (fig->font && ex->scale != 1.0f) {
+        // Shared and kept until the last figure closes, so whole points only: exports at
+        // arbitrary sizes reuse a handful of fonts instead of opening one per scale
+        ex->text_font = context_font(roundf(TTF_GetFontSize(fig->font) * ex->scale));
+    }
+    return true;
+}
+
+static void export_end(Figure* fig, ExportSetup* ex, bool ok, const char* filename, int width, int height) {
+    arena_reset(&fig->frame_arena);
+    update_layout(fig, ex->win_w, ex->win_h);
+    fig->dirty = true;
+
+    if (ok) {
+        printf("Graph saved successfully to %s (%dx%d)\n", filename, width, height);
+    } else {
+        fprintf(stderr, "Failed to export %s: %s\n", filename, SDL_GetError());
+    }
+}
+
+/**
+ * @brief Exports the figure as a PNG of arbitrary size, independent of the window.
+ * * The figure is rendered tile by tile into an offscreen target texture and each 
+ * finished band of rows is compressed straight into the PNG file, so an 8000x6000 
+ * poster needs roughly one band (width x EXPORT_TILE_H pixels) of memory instead 
+ * of two full copies of the image. 
+ * * The layout is the window's, enlarged uniformly: lines, markers and text grow 
+ * with the scale, and text is re-rasterized at the larger point size so it stays 
+ * sharp. If the requested aspect ratio differs from the window's, the axes are 
+ * laid out for the requested aspect for the duration of the export.
+ * * @param fig      Pointer to the Figure to export.
+ * @param filename Destination path (e.g. "poster.png").
+ * @param width    Output width in pixels.
+ * @param height   Output height in pixels.
+ * @return true on success.
+ * * @note Must be called from the thread that owns the renderer, outside of figure_render().
+ */
+bool save_figure_as_png_scaled(Figure* fig, const char* filename, int width, int height) {
+    if (!fig || !filename || width <= 0 || height <= 0) return false;
+    if (!figure_realize(fig, false)) return false; // Tiles need the GPU renderer; a hidden window will do
+
+    // --- STEP 1: Uniform scale and a matching logical layout ---
+    ExportSetup ex;
+    if (!export_begin(fig, width, height, &ex)) return false;
+
+    // --- STEP 2: Offscreen target and one band of output rows ---
+    SDL_Texture* tile = SDL_CreateTexture(fig->renderer, SDL_PIXELFORMAT_RGBA8888,
+                                          SDL_TEXTUREACCESS_TARGET, EXPORT_TILE_W, EXPORT_TILE_H);
+    uint8_t* band = malloc((size_t)width * 3 * EXPORT_TILE_H);
+    PngWriter* png = (tile && band) ? png_writer_open(filename, width, height) : NULL;
+    bool ok = png != NULL;
+    if (!ok) fprintf(stderr, "Failed to start export to %s: %s\n", filename, SDL_GetError());
+
+    SDL_Texture* previous_target = SDL_GetRenderTarget(fig->renderer);
+
+    // --- STEP 3: Render each tile, then stream the finished band ---
+    for (int y0 = 0; ok && y0 < height; y0 += EXPORT_TILE_H) {
+        int band_h = (height - y0 < EXPORT_TILE_H) ? height - y0 : EXPORT_TILE_H;
+
+        for (int x0 = 0; ok && x0 < width; x0 += EXPORT_TILE_W) {
+            int tile_w = (width - x0 < EXPORT_TILE_W) ? width - x0 : EXPORT_TILE_W;
+
+            arena_reset(&fig->frame_arena);
+            SDL_SetRenderTarget(fig->renderer, tile);
+            SDL_SetRenderDrawColor(fig->renderer, 255, 255, 255, 255);
+            SDL_RenderClear(fig->renderer);
+
+            Canvas cv;
+            canvas_init_sdl(&cv, fig->renderer, fig->font, &fig->frame_arena);
+            canvas_set_transform(&cv, ex.scale, (float)x0, (float)y0, ex.text_font);
+            for (int i = 0; i < fig->axes_count; i++) {
+                render_axes_canvas(&cv, &fig->axes[i]);
+            }
+
+            ok = read_tile(fig->renderer, band, width * 3, x0, tile_w, band_h);
+        }
+        if (ok) ok = png_writer_write_rows(png, band, width * 3, band_h);
+    }
+
+    // --- STEP 4: Restore the window state ---
+    SDL_SetRenderTarget(fig->renderer, previous_target);
+    if (png && !png_writer_close(png)) ok = false;
+    if (tile) SDL_DestroyTexture(tile);
+    free(band);
+    export_end(fig, &ex, ok, filename, width, height);
+    return ok;
+}
+
+/**
+ * @brief Exports the figure as an anti-aliased PNG rendered entirely on the CPU.
+ * * Same output geometry as save_figure_as_png_scaled(), but every primitive goes 
+ * through the software rasterizer (sdl_raster.c): lines get coverage-based 
+ * anti-aliasing with round joins, and no renderer or offscreen texture is used. 
+ * The image is produced in full-width bands of EXPORT_TILE_H rows that are 
+ * compressed into the PNG as soon as they are finished.
+ * * @param fig      Pointer to the Figure to export.
+ * @param filename Destination path.
+ * @param width    Output width in pixels.
+ * @param height   Output height in pixels.
+ * @return true on success.
+ */
+bool save_figure_as_png_antialiased(Figure* fig, const char* filename, int width, int height) {
+    if (!fig || !filename || width <= 0 || height <= 0) return false;
+
+    ExportSetup ex;
+    if (!export_begin(fig, width, height, &ex)) return false;
+
+    RasterTarget rt = {0};
+    uint8_t* row = malloc((size_t)width * 3);
+    bool ok = row && raster_init(&rt, width, EXPORT_TILE_H);
+    PngWriter* png = ok ? png_writer_open(filename, width, height) : NULL;
+    if (!png) ok = false;
+
+    for (int y0 = 0; ok && y0 < height; y0 += EXPORT_TILE_H) {
+        int band_h = (height - y0 < EXPORT_TILE_H) ? height - y0 : EXPORT_TILE_H;
+
+        arena_reset(&fig->frame_arena);
+        raster_clear(&rt, (SDL_Color){255, 255, 255, 255});
+
+        Canvas cv;
+        canvas_init_raster(&cv, &rt, fig->font, &fig->frame_arena);
+        canvas_set_transform(&cv, ex.scale, 0.0f, (float)y0, ex.text_font);
+        for (int i = 0; i < fig->axes_count; i++) {
+            render_axes_canvas(&cv, &fig->axes[i]);
+        }
+
+        // RGBA -> RGB, one row at a time
+        for (int r = 0; ok && r < band_h; r++) {
+            const Uint8* src = rt.pixels + (size_t)r * rt.pitch;
+            for (int x = 0; x < width; x++) {
+                row[x * 3] = src[x * 4];
+                row[x * 3 + 1] = src[x * 4 + 1];
+                row[x * 3 + 2] = src[x * 4 + 2];
+            }
+            ok = png_writer_write_rows(png, row, width * 3, 1);
+        }
+    }
+
+    if (png && !png_writer_close(png)) ok = false;
+    if (rt.pixels) raster_destroy(&rt);
+    free(row);
+    export_end(fig, &ex, ok, filename, width, height);
+    return ok;
+}
@@ -0,0 +1,128 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "sdl_figure_manager.h"
+#include "sdl_camera.h"
+#include "sdl_startup.h"
+
+/**
+ * @brief Allocates an empty FigureManager.
+ * * @return A pointer to the new manager, or NULL if allocation fails.
+ * @note Figures are added with manager_add(); the manager takes ownership of them.
+ */
+FigureManager* create_figure_manager(void) {
+    FigureManager* mgr = malloc(sizeof(FigureManager));
+    if (!mgr) return NULL;
+    mgr->figures = NULL;
+    mgr->figure_count = 0;
+    mgr->capacity = 0;
+    mgr->continuous = false;
+    return mgr;
+}
+
+/**
+ * @brief Registers a Figure so its window is served by manager_pump().
+ * * @param mgr Pointer to the FigureManager.
+ * @param fig Pointer to the Figure (with optional toolbar) to register.
+ * @return true on success, false if the figure could not be added.
+ * * @note The manager owns the figure from now on: it is destroyed (together with its 
+ * toolbar) when its window is closed or when the manager is destroyed.
+ */
+bool manager_add(FigureManager* mgr, Figure* fig) {
+    if (!mgr || !fig) return false;
+    if (!figure_realize(fig, true)) return false; // Events need the window to exist
+    if (mgr->figure_count == mgr->capacity) {
+        int new_capacity = mgr->capacity ? mgr->capacity * 2 : 4;
+        Figure** grown = realloc(mgr->figures, sizeof(Figure*) * new_capacity);
+        if (!grown) return false;
+        mgr->figures = grown;
+        mgr->capacity = new_capacity;
+    }
+    fig->close_requested = false;
+    fig->dirty = true;
+    mgr->figures[mgr->figure_count++] = fig;
+    return true;
+}
+
+// A window that cannot be seen does not need to be drawn
+static bool figure_is_visible(Figure* fig) {
+    if (!fig->window) return false;
+    SDL_WindowFlags flags = SDL_GetWindowFlags(fig->window);
+    return !(flags & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED | SDL_WINDOW_OCCLUDED));
+}
+
+/**
+ * @brief Runs one non-blocking iteration for every registered Figure.
+ * * 1. Drains the SDL event queue, handing each event to the figure whose window 
+ *    (or toolbar window) it targets. Global quit events close every figure.
+ * 2. Destroys figures whose windows were closed.
+ * 3. Drains thread-fed series (plot_stream()) and advances spinning 3D views,
+ *    marking figures that changed dirty.
+ * 4. Redraws figures that are dirty and visible (or every visible figure when 
+ *    `continuous` is set).
+ * * Call this from your own main loop; it never sleeps.
+ * * @param mgr Pointer to the FigureManager.
+ * @return The number of figures still open.
+ * * @note After changing a figure's data, call figure_mark_dirty() so the next pump 
+ * redraws it.
+ */
+int manager_pump(FigureManager* mgr) {
+    if (!mgr) return 0;
+
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        for (int i = 0; i < mgr->figure_count; i++) {
+            // Window events belong to exactly one figure; stop at the first taker
+            if (figure_handle_event(mgr->figures[i], &event) && event.type != SDL_EVENT_QUIT) break;
+        }
+    }
+
+    // Tear down closed figures, compacting the list in place
+    int open = 0;
+    for (int i = 0; i < mgr->figure_count; i++) {
+        Figure* fig = mgr->figures[i];
+        if (fig->close_requested) {
+            destroy_figure(fig);
+        } else {
+            mgr->figures[open++] = fig;
+        }
+    }
+    mgr->figure_count = open;
+
+    for (int i = 0; i < mgr->figure_count; i++) {
+        Figure* fig = mgr->figures[i];
+        figure_consume_streams(fig); // New samples from producer threads mark it dirty
+        figure_update_camera(fig);   // Spinning 3D views mark it dirty too
+        if ((fig->dirty || mgr->continuous) && figure_is_visible(fig)) {
+            figure_render(fig);
+        }
+    }
+    return mgr->figure_count;
+}
+
+/**
+ * @brief Blocking loop that serves all registered figures until every window is closed.
+ * * Unlike show(), this sleeps in SDL_WaitEventTimeout() between frames, so idle 
+ * dashboards with many windows use almost no CPU.
+ * * @param mgr Pointer to the FigureManager.
+ */
+void manager_run(FigureManager* mgr) {
+    if (!mgr) return;
+    while (manager_pump(mgr) > 0) {
+        // Wake for input immediately, otherwise tick at ~60 Hz for continuous redraws
+        SDL_WaitEventTimeout(NULL, mgr->continuous ? 16 : 100);
+    }
+}
+
+/**
+ * @brief Destroys the manager and every figure still registered with it.
+ * * @param mgr Pointer to the FigureManager to destroy.
+ */
+void destroy_figure_manager(FigureManager* mgr) {
+    if (!mgr) return;
+    for (int i = 0; i < mgr->figure_count; i++) {
+        destroy_figure(mgr->figures[i]);
+    }
+    free(mgr->figures);
+    free(mgr);
+}
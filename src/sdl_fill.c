@@ -0,0 +1,302 @@
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdlib.h>
+#include "sdl_fill.h"
+#include "sdl_canvas.h"
+#include "sdl_scale.h"
+
+// --- Geometry buffers -------------------------------------------------------------
+
+static bool fill_reserve(FillGeometry* g, int verts, int indices) {
+    if (g->num_vertices + verts > g->vert_capacity) {
+        int cap = g->vert_capacity ? g->vert_capacity : 1024;
+        while (cap < g->num_vertices + verts) cap *= 2;
+        SDL_Vertex* v = realloc(g->verts, sizeof(SDL_Vertex) * (size_t)cap);
+        if (!v) return false;
+        g->verts = v;
+        g->vert_capacity = cap;
+    }
+    if (g->num_indices + indices > g->index_capacity) {
+        int cap = g->index_capacity ? g->index_capacity : 1536;
+        while (cap < g->num_indices + indices) cap *= 2;
+        int* i = realloc(g->indices, sizeof(int) * (size_t)cap);
+        if (!i) return false;
+        g->indices = i;
+        g->index_capacity = cap;
+    }
+    return true;
+}
+
+static int push_vertex(FillGeometry* g, float x, float y, SDL_FColor c) {
+    SDL_Vertex* v = &g->verts[g->num_vertices];
+    v->position = (SDL_FPoint){ x, y };
+    v->color = c;
+    v->tex_coord = (SDL_FPoint){ 0, 0 };
+    return g->num_vertices++;
+}
+
+// Two triangles over four existing vertices (a-b-c, a-c-d)
+static void push_quad_indices(FillGeometry* g, int a, int b, int c, int d) {
+    int* idx = &g->indices[g->num_indices];
+    idx[0] = a; idx[1] = b; idx[2] = c;
+    idx[3] = a; idx[4] = c; idx[5] = d;
+    g->num_indices += 6;
+}
+
+// Axis-aligned rectangle, clipped to 'clip'
+static void push_rect(FillGeometry* g, float x0, float y0, float x1, float y1, const SDL_FRect* clip, SDL_FColor c) {
+    if (x0 > x1) { float t = x0; x0 = x1; x1 = t; }
+    if (y0 > y1) { float t = y0; y0 = y1; y1 = t; }
+    if (x0 < clip->x) x0 = clip->x;
+    if (y0 < clip->y) y0 = clip->y;
+    if (x1 > clip->x + clip->w) x1 = clip->x + clip->w;
+    if (y1 > clip->y + clip->h) y1 = clip->y + clip->h;
+    if (!(x1 > x0) || !(y1 > y0)) return; // Also drops NaN
+    if (!fill_reserve(g, 4, 6)) return;
+    int a = push_vertex(g, x0, y0, c);
+    int b = push_vertex(g, x1, y0, c);
+    int d = push_vertex(g, x1, y1, c);
+    int e = push_vertex(g, x0, y1, c);
+    push_quad_indices(g, a, b, d, e);
+}
+
+// --- Triangulation ----------------------------------------------------------------
+
+typedef struct {
+    float x_lo, y_lo, x_scale, y_scale, left, bottom;
+} ScreenMap;
+
+static inline float map_x(const Axes* ax, const ScreenMap* m, float v) { return m->left + (axes_tx(ax, v) - m->x_lo) * m->x_scale; }
+static inline float map_y(const Axes* ax, const ScreenMap* m, float v) { return m->bottom - (axes_ty(ax, v) - m->y_lo) * m->y_scale; }
+
+/**
+ * @brief Triangulates a band as a strip: two vertices per point, one quad per segment.
+ * * Long series are reduced to one vertex pair per pixel column holding the 
+ * column's highest top and lowest bottom, the same idea as decimate_polyline(), 
+ * so a million-point band costs a few thousand triangles. Non-finite points 
+ * break the strip.
+ */
+static void build_band(FillGeometry* g, const Axes* ax, const Series* s, const ScreenMap* m, SDL_FColor c) {
+    bool decimate = s->count > 2 * (int)ax->rect.w;
+    bool open = false;      // A column is being accumulated
+    bool connect = false;   // The last emitted pair continues the current run
+    int column = 0, prev_top = -1, prev_bottom = -1;
+    float px = 0, top = 0, bottom = 0;
+
+    for (int i = 0; i <= s->count; i++) {
+        bool ok = false;
+        float x = 0, y1 = 0, y2 = 0;
+        if (i < s->count) {
+            x = map_x(ax, m, s->x[i]);
+            y1 = map_y(ax, m, s->y[i]);
+            y2 = map_y(ax, m, g->y2 ? g->y2[i] : 0.0f);
+            if (!g->y2 && !isfinite(y2)) y2 = m->bottom; // Zero baseline on a log axis
+            ok = isfinite(x) && isfinite(y1) && isfinite(y2);
+        }
+
+        // Plain compares: fminf()/fmaxf() are libm calls unless -ffast-math
+        float lo = y1 < y2 ? y1 : y2;
+        float hi = y1 < y2 ? y2 : y1;
+
+        // Same pixel column: widen the pending pair instead of emitting a new one
+        if (ok && open && decimate && (int)(x - m->left) == column) {
+            top = lo < top ? lo : top;
+            bottom = hi > bottom ? hi : bottom;
+            continue;
+        }
+
+        if (open && fill_reserve(g, 2, 6)) {
+            int t = push_vertex(g, px, top, c);
+            int b = push_vertex(g, px, bottom, c);
+            if (connect) push_quad_indices(g, prev_top, t, b, prev_bottom);
+            prev_top = t;
+            prev_bottom = b;
+            connect = true;
+        }
+        open = ok;
+        if (!ok) {
+            connect = false;
+            continue;
+        }
+        column = (int)(x - m->left);
+        px = x;
+        top = lo;
+        bottom = hi;
+    }
+}
+
+// One bar per point, standing on zero (or the bottom edge on a log axis)
+static void build_bars(FillGeometry* g, const Axes* ax, const Series* s, const ScreenMap* m, SDL_FColor c) {
+    float base = map_y(ax, m, 0.0f);
+    if (!isfinite(base)) base = m->bottom;
+    float half = g->width / 2.0f;
+    for (int i = 0; i < s->count; i++) {
+        push_rect(g, map_x(ax, m, s->x[i] - half), map_y(ax, m, s->y[i]),
+                  map_x(ax, m, s->x[i] + half), base, &ax->rect, c);
+    }
+}
+
+// A stem and two caps per point, all as quads
+static void build_errorbars(FillGeometry* g, const Axes* ax, const Series* s, const ScreenMap* m, SDL_FColor c) {
+    float half_t = (s->thickness > 1.0f ? s->thickness : 1.0f) / 2.0f;
+    float half_cap = ERRORBAR_CAP_PX / 2.0f;
+    for (int i = 0; i < s->count; i++) {
+        float e = fabsf(g->err[i]);
+        float x = map_x(ax, m, s->x[i]);
+        float hi = map_y(ax, m, s->y[i] + e);
+        float lo = map_y(ax, m, s->y[i] - e);
+        if (!isfinite(lo)) lo = m->bottom; // Below zero on a log axis
+        push_rect(g, x - half_t, hi, x + half_t, lo, &ax->rect, c);
+        push_rect(g, x - half_cap, hi - half_t, x + half_cap, hi + half_t, &ax->rect, c);
+        push_rect(g, x - half_cap, lo - half_t, x + half_cap, lo + half_t, &ax->rect, c);
+    }
+}
+
+/**
+ * @brief Draws a fill, bar or error-bar series as a single geometry batch.
+ * * The triangles are kept between frames and rebuilt only when the view, the 
+ * plot area, the color or the data arrays change (in-place edits are picked up 
+ * through figure_mark_dirty()), so a steady frame is one submission per series.
+ */
+void render_fill(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi) {
+    FillGeometry* g = s->fill;
+    if (!g || s->count <= 0) return;
+
+    float view[4] = { x_lo, x_hi, y_lo, y_hi };
+    SDL_Color col = s->color;
+    if (!(g->valid && g->key_x == s->x && g->key_y == s->y && g->key_count == s->count &&
+          g->key_view[0] == view[0] && g->key_view[1] == view[1] &&
+          g->key_view[2] == view[2] && g->key_view[3] == view[3] &&
+          g->key_rect.x == ax->rect.x && g->key_rect.y == ax->rect.y &&
+          g->key_rect.w == ax->rect.w && g->key_rect.h == ax->rect.h &&
+          g->key_color.r == col.r && g->key_color.g == col.g &&
+          g->key_color.b == col.b && g->key_color.a == col.a)) {
+        ScreenMap m = { x_lo, y_lo, ax->rect.w / (x_hi - x_lo), ax->rect.h / (y_hi - y_lo),
+                        ax->rect.x, ax->rect.y + ax->rect.h };
+        SDL_FColor c = { col.r / 255.0f, col.g / 255.0f, col.b / 255.0f, col.a / 255.0f };
+        g->num_vertices = g->num_indices = 0;
+        if (s->type == PLOT_FILL) build_band(g, ax, s, &m, c);
+        else if (s->type == PLOT_BAR) build_bars(g, ax, s, &m, c);
+        else if (s->type == PLOT_ERRORBAR) build_errorbars(g, ax, s, &m, c);
+
+        g->key_x = s->x;
+        g->key_y = s->y;
+        g->key_count = s->count;
+        for (int k = 0; k < 4; k++) g->key_view[k] = view[k];
+        g->key_rect = ax->rect;
+        g->key_color = col;
+        g->valid = true;
+    }
+    canvas_geometry(cv, g->verts, g->num_vertices, g->indices, g->num_indices);
+}
+
+// --- Limits -----------------------------------------------------------------------
+
+static void widen(float* lim, float t) {
+    if (!isfinite(t)) return;
+    if (t < lim[0]) lim[0] = t;
+    if (t > lim[1]) lim[1] = t;
+}
+
+/**
+ * @brief Widens view-unit limits by the parts of a series that aren't its x/y 
+ * points: the second band edge, error extents, bar widths and zero baselines.
+ * * @param x_lim, y_lim [lo, hi] pairs in view units (see axes_autoscale()).
+ */
+void fill_bounds(const Axes* ax, const Series* s, float* x_lim, float* y_lim) {
+    const FillGeometry* g = s->fill;
+    if (!g || s->count <= 0) return;
+    if (s->type == PLOT_FILL) {
+        if (!g->y2) {
+            widen(y_lim, axes_ty(ax, 0.0f));
+            return;
+        }
+        for (int i = 0; i < s->count; i++) {
+            if (isfinite(s->x[i])) widen(y_lim, axes_ty(ax, g->y2[i]));
+        }
+    } else if (s->type == PLOT_BAR) {
+        float half = g->width / 2.0f;
+        for (int i = 0; i < s->count; i++) {
+            widen(x_lim, axes_tx(ax, s->x[i] - half));
+            widen(x_lim, axes_tx(ax, s->x[i] + half));
+        }
+        widen(y_lim, axes_ty(ax, 0.0f));
+    } else if (s->type == PLOT_ERRORBAR) {
+        for (int i = 0; i < s->count; i++) {
+            if (!isfinite(s->x[i])) continue;
+            float e = fabsf(g->err[i]);
+            widen(y_lim, axes_ty(ax, s->y[i] - e));
+            widen(y_lim, axes_ty(ax, s->y[i] + e));
+        }
+    }
+}
+
+// --- Public API -------------------------------------------------------------------
+
+static FillGeometry* fill_attach(Axes* ax, float* x, float* y, int count, SDL_Color color, PlotType type) {
+    FillGeometry* g = calloc(1, sizeof(FillGeometry));
+    if (!g) return NULL;
+    plot(ax, x, y, count, color);
+    Series* s = &ax->lines[ax->line_count - 1];
+    s->type = type;
+    s->fill = g;
+    return g;
+}
+
+/**
+ * @brief Fills the area between two curves (Matplotlib's ax.fill_between).
+ * * @param ax    Pointer to the Axes.
+ * @param x     X coordinates, shared by both edges.
+ * @param y1    First edge.
+ * @param y2    Second edge, or NULL to fill down to zero.
+ * @param count Number of points.
+ * @param color Fill color; use alpha < 255 for a translucent band.
+ * * @note Arrays are stored, not copied (as in plot()). A NaN in any of them 
+ * leaves a gap in the band.
+ */
+void fill_between(Axes* ax, float* x, float* y1, float* y2, int count, SDL_Color color) {
+    if (!ax || !x || !y1 || count <= 0) return;
+    FillGeometry* g = fill_attach(ax, x, y1, count, color, PLOT_FILL);
+    if (!g) return;
+    g->y2 = y2;
+    axes_autoscale(ax);
+}
+
+/**
+ * @brief Adds vertical error bars with caps around each point (Matplotlib's ax.errorbar).
+ * * Only the bars are drawn; combine with plot() or scatter() for the points.
+ * * @param yerr Symmetric error per point (the bar spans y - yerr .. y + yerr).
+ */
+void errorbar(Axes* ax, float* x, float* y, float* yerr, int count, SDL_Color color) {
+    if (!ax || !x || !y || !yerr || count <= 0) return;
+    FillGeometry* g = fill_attach(ax, x, y, count, color, PLOT_ERRORBAR);
+    if (!g) return;
+    g->err = yerr;
+    ax->lines[ax->line_count - 1].thickness = 1.5f;
+    axes_autoscale(ax);
+}
+
+/**
+ * @brief Adds a bar chart (Matplotlib's ax.bar).
+ * * @param x      Bar centers.
+ * @param height Bar heights (bars stand on zero; negative heights hang below it).
+ * @param width  Bar width in data units (<= 0 = BAR_DEFAULT_WIDTH).
+ */
+void bar(Axes* ax, float* x, float* height, int count, float width, SDL_Color color) {
+    if (!ax || !x || !height || count <= 0) return;
+    FillGeometry* g = fill_attach(ax, x, height, count, color, PLOT_BAR);
+    if (!g) return;
+    g->width = width > 0.0f ? width : BAR_DEFAULT_WIDTH;
+    axes_autoscale(ax);
+}
+
+void fill_invalidate(FillGeometry* g) {
+    if (g) g->valid = false;
+}
+
+void fill_destroy(FillGeometry* g) {
+    if (!g) return;
+    free(g->verts);
+    free(g->indices);
+    free(g);
+}
@@ -3,15 +3,34 @@
 #include <SDL3_image/SDL_image.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <limits.h>
 #include "sdl_graphs.h"
 #include "sdl_toolbar.h"
+#include "sdl_stream.h"
+#include "sdl_canvas.h"
+#include "sdl_pick.h"
+#include "sdl_capture.h"
+#include "sdl_plot3d.h"
+#include "sdl_camera.h"
+#include "sdl_layout.h"
+#include "sdl_hist.h"
+#include "sdl_spectrogram.h"
+#include "sdl_imshow.h"
+#include "sdl_runs.h"
+#include "sdl_scale.h"
+#include "sdl_fill.h"
+#include "sdl_link.h"
+#include "sdl_context.h"
+#include "sdl_startup.h"
+#include "sdl_dpi.h"
 #include <math.h>
 
 /**
  * @brief Initializes a new Figure with a default set of Axes.
- * * This function emulates the `plt.subplots()` behavior from Matplotlib. It creates
- * a resizable SDL window, initializes the hardware-accelerated renderer, loads 
- * the default font, and sets up a primary plotting area (Axes) with default margins.
+ * * This function emulates the `plt.subplots()` behavior from Matplotlib. It sets up 
+ * the Axes and their layout. The resizable window, the hardware-accelerated renderer 
+ * and the shared default font (see sdl_context.h) are created on first render or 
+ * export (see figure_realize()), so plotting and exporting stay cheap.
  *
  * @param title  The text displayed in the window's title bar and as the default plot title.
  * @param width  The initial width of the window in pixels.
@@ -22,20 +41,34 @@
  * limits to allow the first call to plot() or scatter() to set the scale.
  */
 Figure* subplots(const char* title, int width, int height, int num_axes) {
+    Uint64 created = SDL_GetTicksNS();
     Figure* fig = malloc(sizeof(Figure));
     if (!fig) return NULL;
-    fig->window = SDL_CreateWindow(title, width, height, SDL_WINDOW_RESIZABLE);
-    // Left this for future look back in case nothing connects
-    // printf("Available renderer drivers:\n");
-    // for (int i = 0; i < SDL_GetNumRenderDrivers(); i++) {
-    //     printf("%d. %s\n", i + 1, SDL_GetRenderDriver(i));
-    // }
-    // fig->renderer = SDL_CreateRenderer(fig->window, "direct3d12"); //was NULL orginally but direct3d11 which has an issue
-    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "direct3d12"); //direct3d11 has an issue that causes ocassional crashes
-    fig->renderer = SDL_CreateRenderer(fig->window, NULL); //opengl is the best option
-    SDL_SetRenderDrawBlendMode(fig->renderer, SDL_BLENDMODE_BLEND); // Ensure it to be true
-    fig->font = TTF_OpenFont("PTC55F.ttf", 16);
+    // Window, renderer and font are created lazily (see figure_realize)
+    fig->window = NULL;
+    fig->renderer = NULL;
+    fig->font = NULL;
+    snprintf(fig->title, sizeof(fig->title), "%s", title ? title : "");
+    fig->width = width;
+    fig->height = height;
+    fig->window_shown = false;
+    fig->pixel_scale = fig->event_scale = 1.0f;
+    fig->text_font = NULL;
+    memset(&fig->timing, 0, sizeof(fig->timing));
+    fig->timing.created_ns = created;
+    context_retain();
     fig->toolbar = NULL;
+    fig->window_id = 0;
+    fig->dirty = true;
+    fig->close_requested = false;
+    fig->vsync = 0;
+    fig->recorder = NULL;
+    fig->hover_enabled = true;
+    fig->hover.axes_index = -1;
+    fig->drag_axes = -1;
+    fig->drag_last_ns = 0;
+    fig->camera_ticks = 0;
+    arena_init(&fig->frame_arena, 0);
     fig->axes_count = num_axes;
     fig->axes = malloc(sizeof(Axes) * num_axes);
     
@@ -57,10 +90,30 @@ Figure* subplots(const char* title, int width, int height, int num_axes) {
         fig->axes[i].phi = 0.0f;
         fig->axes[i].theta = 0.0f;
         fig->axes[i].zoom = 1.0f;
+        fig->axes[i].pan_x = fig->axes[i].pan_y = 0.0f;
+        fig->axes[i].spin_phi = fig->axes[i].spin_theta = 0.0f;
+        fig->axes[i].cache = NULL;
+        fig->axes[i].title_offset = 30.0f;
+        fig->axes[i].xlabel_offset = 40.0f;
+        fig->axes[i].ylabel_offset = 60.0f;
+        fig->axes[i].hide_x_ticklabels = false;
+        fig->axes[i].hide_y_ticklabels = false;
         fig->axes[i].z_min = 1e38f;  fig->axes[i].z_max = -1e38f;
+        fig->axes[i].arena = &fig->frame_arena;
+        fig->axes[i].x_format = TICKS_NUMERIC;
+        fig->axes[i].x_time_origin = 0.0;
+        ticks_init(&fig->axes[i].x_ticks);
+        ticks_init(&fig->axes[i].y_ticks);
+        fig->axes[i].xscale = fig->axes[i].yscale = SCALE_LINEAR;
+        fig->axes[i].x_linthresh = fig->axes[i].y_linthresh = 1.0f;
+        fig->axes[i].x_link = fig->axes[i].y_link = NULL;
+        fig->axes[i].data_lim[0] = fig->axes[i].data_lim[2] = 1e38f;
+        fig->axes[i].data_lim[1] = fig->axes[i].data_lim[3] = -1e38f;
     }
 
-    update_layout(fig, width, height); 
+    fig->layout = layout_create(num_axes);
+    layout_resize(fig, width, height); // Solved on the first frame or export
+    fig->timing.setup_ns = SDL_GetTicksNS() - created;
     return fig;
 }
 
@@ -90,15 +143,27 @@ void plot(Axes* ax, float* x, float* y, int count, SDL_Color color) {
     newLine->marker_size = 0;
     newLine->thickness = 2.0f;
     newLine->style=STYLE_SOLID;
+    newLine->stream = NULL;
+    newLine->pick = NULL;
+    newLine->runs = NULL;
+    newLine->scaled = NULL;
+    newLine->capture = NULL;
+    newLine->capture_channel = 0;
+    newLine->colormap = COLORMAP_NONE;
+    newLine->grid_rows = newLine->grid_cols = 0;
+    newLine->cull_backfaces = false;
+    newLine->hist = NULL;
+    newLine->spectro = NULL;
+    newLine->image = NULL;
+    newLine->fill = NULL;
     ax->line_count++;
     strncpy(newLine->label, "Series", 32);
 
-    // Update data limits (Auto-scaling)
-    for(int i = 0; i < count; i++) {
-        if (x[i] < ax->x_min) ax->x_min = x[i];
-        if (x[i] > ax->x_max) ax->x_max = x[i];
-        if (y[i] < ax->y_min) ax->y_min = y[i];
-        if (y[i] > ax->y_max) ax->y_max = y[i];
+    // Update data limits (Auto-scaling), ignoring NaN/Inf points
+    if (axes_full_rescan(ax)) {
+        axes_autoscale(ax); // Skips values a log axis can't show, and fits linked groups
+    } else {
+        finite_bounds(x, y, count, &ax->x_min, &ax->x_max, &ax->y_min, &ax->y_max);
     }
 }
 
@@ -125,6 +190,20 @@ void plot3D(Axes* ax, float* x, float* y, float* z, int count, SDL_Color color)
     s->type = PLOT_LINE;
     s->thickness = 2.0f;
     s->style = STYLE_SOLID;
+    s->marker_size = 0;
+    s->stream = NULL;
+    s->pick = NULL;
+    s->runs = NULL;
+    s->scaled = NULL;
+    s->capture = NULL;
+    s->capture_channel = 0;
+    s->colormap = COLORMAP_NONE;
+    s->grid_rows = s->grid_cols = 0;
+    s->cull_backfaces = false;
+    s->hist = NULL;
+    s->spectro = NULL;
+    s->image = NULL;
+    s->fill = NULL;
     ax->line_count++;
     strncpy(s->label, "Series", 32);
     // --- Auto-scale bounds ---
@@ -169,25 +248,153 @@ void scatter(Axes* ax, float* x, float* y, int count, SDL_Color color, float siz
     s->marker_size = size;
 }
 
+/**
+ * @brief Updates a numeric (linear, log or symlog) tick cache, spacing ticks according to the font's metrics.
+ * * Vertical axes keep ticks at least 2.5 line heights apart. Horizontal axes start 
+ * from a guess and, if the widest formatted label would collide with its neighbour, 
+ * are regenerated once with the measured label width. Because the TickCache is only 
+ * rebuilt when the view changes, text measurement never happens on a steady frame.
+ * * @param tc         The TickCache to update.
+ * @param font       The font used for tick labels (may be NULL).
+ * @param scale      Axis scale, selects the locator (see scale_update_ticks()).
+ * @param linthresh  SCALE_SYMLOG linear half-width.
+ * @param view_min   Bottom of the view (in view units, i.e. after the scale).
+ * @param view_max   Top of the view.
+ * @param extent_px  Length of the axis in pixels.
+ * @param horizontal true for the X axis, false for the Y axis.
+ */
+static void update_numeric_ticks(TickCache* tc, TTF_Font* font, AxisScale scale, float linthresh, float view_min, float view_max, float extent_px, bool horizontal) {
+    float font_h = font ? (float)TTF_GetFontHeight(font) : 16.0f;
+    float spacing = horizontal ? 60.0f : font_h * 2.5f;
+
+    if (!scale_update_ticks(tc, scale, linthresh, view_min, view_max, extent_px, spacing)) return;
+    if (!horizontal || !font || tc->count < 2) return;
+
+    int widest = 0;
+    for (int i = 0; i < tc->count; i++) {
+        int w = 0, h = 0;
+        if (TTF_GetStringSize(font, tc->labels[i], 0, &w, &h) && w > widest) widest = w;
+    }
+    float needed = widest + font_h;
+    float available = extent_px / (tc->count - 1);
+    if (needed > available) {
+        ticks_invalidate(tc);
+        scale_update_ticks(tc, scale, linthresh, view_min, view_max, extent_px, needed);
+    }
+}
+
+/**
+ * @brief Reduces a screen-space polyline to at most 4 points per pixel column.
+ * * Consecutive points that fall into the same pixel column are replaced by the 
+ * first, lowest, highest and last of them (in their original order). The rendered 
+ * result is visually identical, but a million-point series costs a few thousand 
+ * vertices. Works in place. Solid lines only: dashes would be laid along a different path.
+ * * @param pts   Screen-space points (modified in place).
+ * @param count Number of points.
+ * @return The number of points kept.
+ */
+static int decimate_polyline(SDL_FPoint* pts, int count) {
+    int out = 0;
+    int i = 0;
+    while (i < count) {
+        int column = (int)floorf(pts[i].x);
+        int first = i, last = i, lo = i, hi = i;
+        for (i = i + 1; i < count && (int)floorf(pts[i].x) == column; i++) {
+            if (pts[i].y < pts[lo].y) lo = i;
+            if (pts[i].y > pts[hi].y) hi = i;
+            last = i;
+        }
+
+        // Emit the distinct extremes in index order
+        int keep[4] = { first, lo < hi ? lo : hi, lo < hi ? hi : lo, last };
+        SDL_FPoint kept[4];
+        int n = 0;
+        for (int k = 0; k < 4; k++) {
+            if (n > 0 && keep[k] == keep[k - 1]) continue;
+            if (k > 0 && keep[k] < keep[k - 1]) continue;
+            kept[n++] = pts[keep[k]];
+        }
+        for (int k = 0; k < n; k++) pts[out++] = kept[k];
+    }
+    return out;
+}
+
+/**
+ * @brief Draws a memory-mapped capture channel (see plot_capture()).
+ * * Zoomed out, each output pixel column gets a vertical min/max stroke taken from 
+ * the capture's pyramid, so the cost is proportional to the axes width rather than 
+ * the length of the recording. Once fewer than two samples fall into a column the 
+ * visible samples are drawn directly as a polyline.
+ */
+static void render_capture_series(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi) {
+    const Capture* cap = s->capture;
+    float bottom = ax->rect.y + ax->rect.h;
+    float y_scale = ax->rect.h / (y_hi - y_lo);
+    int columns = (int)ceilf(ax->rect.w * cv->scale); // One per output pixel
+    if (columns <= 0 || cap->count == 0) return;
+
+    canvas_set_color(cv, (SDL_Color){s->color.r, s->color.g, s->color.b, 255});
+
+    double visible = ((double)x_hi - x_lo) * cap->sample_rate;
+    if (visible <= 2.0 * columns) {
+        double first = floor((x_lo - cap->x_origin) * cap->sample_rate);
+        double last = ceil((x_hi - cap->x_origin) * cap->sample_rate) + 1.0;
+        if (first < 0) first = 0;
+        if (last > (double)cap->count) last = (double)cap->count;
+        int n = (int)(last - first);
+        SDL_FPoint* pts = (n > 0) ? arena_alloc_array(cv->arena, SDL_FPoint, n) : NULL;
+        if (!pts) return;
+        float x_scale = ax->rect.w / (x_hi - x_lo);
+        for (int i = 0; i < n; i++) {
+            uint64_t k = (uint64_t)first + i;
+            pts[i].x = ax->rect.x + (float)((cap->x_origin + k / cap->sample_rate - x_lo) * x_scale);
+            pts[i].y = bottom - (axes_ty(ax, cap->samples[k * cap->channels + s->capture_channel]) - y_lo) * y_scale;
+        }
+        canvas_polyline(cv, pts, n, s->thickness, s->style);
+        return;
+    }
+
+    float* mn = arena_alloc_array(cv->arena, float, columns);
+    float* mx = arena_alloc_array(cv->arena, float, columns);
+    SDL_FPoint* pts = arena_alloc_array(cv->arena, SDL_FPoint, columns * 2);
+    if (!mn || !mx || !pts) return;
+    double x_right = x_lo + (double)columns / cv->scale * (x_hi - x_lo) / ax->rect.w;
+    capture_envelope(cap, s->capture_channel, x_lo, x_right, columns, mn, mx);
+
+    // Runs of columns with data become polylines; empty columns leave gaps
+    int n = 0;
+    for (int c = 0; c <= columns; c++) {
+        if (c == columns || isnan(mn[c])) {
+            canvas_polyline(cv, pts, n, 1.0f, STYLE_SOLID);
+            n = 0;
+            continue;
+        }
+        float px = ax->rect.x + (c + 0.5f) / cv->scale;
+        pts[n++] = (SDL_FPoint){ px, bottom - (axes_ty(ax, mn[c]) - y_lo) * y_scale };
+        pts[n++] = (SDL_FPoint){ px, bottom - (axes_ty(ax, mx[c]) - y_lo) * y_scale };
+    }
+}
+
  /**
  * @brief Performs 2D rendering of axes, grid lines, data series, and labels.
  * * This function follows a strict layering order to ensure visual clarity:
  * 1. **Background**: Draws the plot area and border.
  * 2. **Scaling**: Calculates normalization factors with 10% padding for data breathing room.
- * 3. **Axes & Grid**: Renders numerical ticks and optional light-gray grid lines.
- * 4. **Data Plotting**: Iterates through series to render either thick lines (solid/dashed) 
- * or scatter plot markers.
+ * 3. **Axes & Grid**: Renders "nice" numerical (or time) ticks from the per-axes 
+ * tick cache and optional light-gray grid lines.
+ * 4. **Data Plotting**: Maps each series to screen space in one pass, decimates long 
+ * lines to the pixel grid, and submits each series as a single polyline or marker batch.
  * 5. **Annotations**: Overlays the legend and titles (Main, X, and Y).
- * * @param renderer The active SDL_Renderer.
- * @param font     The TTF_Font used for all text (labels, ticks, titles).
- * @param ax       Pointer to the Axes object containing 2D data and configuration.
+ * * @param cv The Canvas to draw into (SDL window, SVG file, ...).
+ * @param ax Pointer to the Axes object containing 2D data and configuration.
  * * @note Coordinate mapping: Screen Y is inverted relative to data Y because SDL's 
  * origin (0,0) is at the top-left.
  */
-void render_axes_2d(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
-    const int tick_count = 5;
+void render_axes_2d(Canvas* cv, Axes* ax) {
     const float tick_size = 5.0f;
     const SDL_Color text_color = {0, 0, 0, 255};
+    const SDL_Color black = {0, 0, 0, 255};
+    const SDL_Color grid_color = {200, 200, 200, 100}; // Light Gray
     
     float draw_w = ax->rect.w;
     float draw_h = ax->rect.h;
@@ -195,114 +402,173 @@ void render_axes_2d(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
     float draw_y = ax->rect.y;
 
     // --- STEP 1: DRAW BACKGROUND FIRST ---
-    SDL_SetRenderDrawColor(renderer, 245, 245, 245, 255);
-    SDL_RenderFillRect(renderer, &ax->rect);
+    canvas_set_color(cv, (SDL_Color){245, 245, 245, 255});
+    canvas_rect(cv, &ax->rect, true);
     
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderRect(renderer, &ax->rect);
+    canvas_set_color(cv, black);
+    canvas_rect(cv, &ax->rect, false);
 
     // --- STEP 2: CALCULATE SCALING ---
     // Apply 10% padding so data doesn't touch the box edges
-    float x_data_diff = ax->x_max - ax->x_min;
-    float y_data_diff = ax->y_max - ax->y_min;
-    float x_range = (x_data_diff > 0) ? x_data_diff * 1.1f : 1.0f;
-    float y_range = (y_data_diff > 0) ? y_data_diff * 1.1f : 1.0f;
+    float x_view_min, x_view_max, y_view_min, y_view_max;
+    axes_view_2d(ax, &x_view_min, &x_view_max, &y_view_min, &y_view_max);
+    float x_range = x_view_max - x_view_min;
+    float y_range = y_view_max - y_view_min;
 
     // --- STEP 3: DRAW TICKS & LABELS ---
-    for (int i = 0; i <= tick_count; i++) {
-        float ratio = (float)i / tick_count;
-        
-        // Y Axis
-        float y_pos = (draw_y + draw_h) - (ratio * draw_h);
-        // float y_val = y_start_val + (ratio * y_range);
-        float y_val = ax->y_min + (ratio * y_data_diff); 
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderLine(renderer, draw_x - tick_size, y_pos, draw_x, y_pos);
-        
-        char y_label[16];
-        snprintf(y_label, sizeof(y_label), "%.1f", y_val);
-        draw_text(renderer, font, y_label, draw_x - 10, y_pos, true, text_color);
-
+    // Tick positions/labels are cached per axes and only rebuilt when the view changes
+    // and shared by linked axes of the same size (see sdl_link.h)
+    TickCache* x_ticks = axes_tick_cache(ax, false);
+    TickCache* y_ticks = axes_tick_cache(ax, true);
+    if (ax->x_format == TICKS_TIME) {
+        ticks_update_time(x_ticks, ax->x_time_origin, x_view_min, x_view_max, draw_w);
+    } else {
+        update_numeric_ticks(x_ticks, cv->font, ax->xscale, ax->x_linthresh, x_view_min, x_view_max, draw_w, true);
+    }
+    update_numeric_ticks(y_ticks, cv->font, ax->yscale, ax->y_linthresh, y_view_min, y_view_max, draw_h, false);
 
-        // X Axis
-        float x_pos = draw_x + (ratio * draw_w);
-        // float x_val = x_start_val + (ratio * x_range);
-        float x_val = ax->x_min + (ratio * x_data_diff);
-        SDL_RenderLine(renderer, x_pos, draw_y + draw_h, x_pos, draw_y + draw_h + tick_size);
-        
-        char x_label[16];
-        snprintf(x_label, sizeof(x_label), "%.1f", x_val);
-        draw_text(renderer, font, x_label, x_pos, draw_y + draw_h + 15, false, text_color);
+    // Y Axis
+    for (int i = 0; i < y_ticks->count; i++) {
+        float y_pos = (draw_y + draw_h) - ((axes_ty(ax, y_ticks->values[i]) - y_view_min) / y_range) * draw_h;
+        canvas_set_color(cv, black);
+        canvas_line(cv, draw_x - tick_size, y_pos, draw_x, y_pos);
+        if (!ax->hide_y_ticklabels) canvas_tick_label(cv, y_ticks, i, draw_x - 10, y_pos, true, text_color);
 
         //Grid Lines
         if (ax->show_grid) {
-            SDL_SetRenderDrawColor(renderer, 200, 200, 200, 100); // Light Gray
-            SDL_RenderLine(renderer, draw_x, y_pos, draw_x + draw_w, y_pos);
-            SDL_RenderLine(renderer, x_pos, draw_y, x_pos, draw_y + draw_h);
+            canvas_set_color(cv, grid_color);
+            canvas_line(cv, draw_x, y_pos, draw_x + draw_w, y_pos);
         }
     }
+
+    // X Axis
+    for (int i = 0; i < x_ticks->count; i++) {
+        float x_pos = draw_x + ((axes_tx(ax, x_ticks->values[i]) - x_view_min) / x_range) * draw_w;
+        canvas_set_color(cv, black);
+        canvas_line(cv, x_pos, draw_y + draw_h, x_pos, draw_y + draw_h + tick_size);
+        if (!ax->hide_x_ticklabels) canvas_tick_label(cv, x_ticks, i, x_pos, draw_y + draw_h + 15, false, text_color);
+
+        if (ax->show_grid) {
+            canvas_set_color(cv, grid_color);
+            canvas_line(cv, x_pos, draw_y, x_pos, draw_y + draw_h);
+        }
+    }
+
     // Render lines or scatter
     for (int l = 0; l < ax->line_count; l++) {
         Series* s = &ax->lines[l];
-        SDL_SetRenderDrawColor(renderer, s->color.r, s->color.g, s->color.b, 255);
-        
+        if (s->capture) {
+            render_capture_series(cv, ax, s, x_view_min, x_view_max, y_view_min, y_view_max);
+            continue;
+        }
+        if (s->hist) {
+            render_hist(cv, ax, s, x_view_min, x_view_max, y_view_min, y_view_max);
+            continue;
+        }
+        if (s->spectro) {
+            render_spectrogram(cv, ax, s, x_view_min, x_view_max, y_view_min, y_view_max);
+            continue;
+        }
+        if (s->image) {
+            render_heatmap(cv, ax, s, x_view_min, x_view_max, y_view_min, y_view_max);
+            continue;
+        }
+        if (s->fill) {
+            render_fill(cv, ax, s, x_view_min, x_view_max, y_view_min, y_view_max);
+            continue;
+        }
+        if (s->count <= 0) continue;
+
+        // Map the whole series into scratch memory, then submit it as one batch.
+        // Log/symlog axes map from the series' cached scaled copy.
+        const float *sx, *sy;
+        series_scaled(ax, s, &sx, &sy);
+        SDL_FPoint* pts = arena_alloc_array(cv->arena, SDL_FPoint, s->count);
+        if (!pts) continue;
         for (int i = 0; i < s->count; i++) {
-            // Map data to pixels
-            float px = draw_x + ((s->x[i] - ax->x_min) / x_range) * draw_w;
-            float py = (draw_y + draw_h) - ((s->y[i] - ax->y_min) / y_range) * draw_h;
-
-            if (s->type == PLOT_LINE && i < s->count - 1) {
-                // Existing line drawing logic...
-                float px2 = draw_x + ((s->x[i+1] - ax->x_min) / x_range) * draw_w;
-                float py2 = (draw_y + draw_h) - ((s->y[i+1] - ax->y_min) / y_range) * draw_h;
-
-                if (s->style == STYLE_SOLID) {
-                    RenderThickLine(renderer, px, py, px2, py2, s->thickness);
-                } else {
-                    DrawDashedThickLine(renderer, px, py, px2, py2, s->thickness, s->style);
-                    // SDL_RenderLineDashed(renderer, px, py, px2, py2, s->style);
-                }
-                // // SDL_RenderLine(renderer, px, py, px2, py2);
-                // SDL_RenderLineDashed(renderer, px, py, px2, py2, s->style);
-            } 
-            else if (s->type == PLOT_SCATTER) {
-                // Draw a marker (square) centered on the point
-                SDL_FRect marker = { 
-                    px - (s->marker_size / 2.0f), 
-                    py - (s->marker_size / 2.0f), 
-                    s->marker_size, 
-                    s->marker_size 
-                };
-                SDL_RenderFillRect(renderer, &marker);
+            pts[i].x = draw_x + ((sx[i] - x_view_min) / x_range) * draw_w;
+            pts[i].y = (draw_y + draw_h) - ((sy[i] - y_view_min) / y_range) * draw_h;
+        }
+
+        canvas_set_color(cv, (SDL_Color){s->color.r, s->color.g, s->color.b, 255});
+        // Dash patterns follow the arc length, which decimation would rewrite
+        int decimate_above = (s->style == STYLE_SOLID) ? 2 * (int)draw_w : INT_MAX;
+        const RunIndex* runs = series_runs(s, sx, sy);
+        if (!runs || runs->all_finite) {
+            if (s->type == PLOT_LINE) {
+                int n = (s->count > decimate_above) ? decimate_polyline(pts, s->count) : s->count;
+                canvas_polyline(cv, pts, n, s->thickness, s->style);
+            } else if (s->type == PLOT_SCATTER) {
+                canvas_markers(cv, pts, s->count, s->marker_size);
+            }
+        } else if (s->type == PLOT_LINE) {
+            // NaN/Inf samples split the line: one polyline per finite run
+            for (int r = 0; r < runs->count; r++) {
+                SDL_FPoint* run = pts + runs->start[r];
+                int len = runs->length[r];
+                int n = (len > decimate_above) ? decimate_polyline(run, len) : len;
+                canvas_polyline(cv, run, n, s->thickness, s->style);
+            }
+        } else if (s->type == PLOT_SCATTER) {
+            // Pack the finite points to the front, still one marker batch
+            int n = 0;
+            for (int r = 0; r < runs->count; r++) {
+                for (int i = 0; i < runs->length[r]; i++) pts[n++] = pts[runs->start[r] + i];
             }
+            canvas_markers(cv, pts, n, s->marker_size);
         }
     }
-    render_legend(renderer, font, ax);
-    SDL_Color black = {0, 0, 0, 255};
+    render_legend(cv, ax);
 
     // 1. Draw Main Title (Top Center)
     if (ax->title) {
-        draw_text(renderer, font, ax->title, 
+        canvas_text(cv, ax->title, 
                 ax->rect.x + (ax->rect.w / 2.0f), 
-                ax->rect.y - 30, false, black);
+                ax->rect.y - ax->title_offset, false, black);
     }
 
     // 2. Draw X-Axis Label (Bottom Center)
-    if (ax->x_label) {
-        draw_text(renderer, font, ax->x_label, 
+    if (ax->x_label && !ax->hide_x_ticklabels) {
+        canvas_text(cv, ax->x_label, 
                 ax->rect.x + (ax->rect.w / 2.0f), 
-                ax->rect.y + ax->rect.h + 40, false, black);
+                ax->rect.y + ax->rect.h + ax->xlabel_offset, false, black);
     }
 
     // 3. Draw Y-Axis Label (Left Center)
-    if (ax->y_label) {
+    if (ax->y_label && !ax->hide_y_ticklabels) {
         // Note: Positioned to the left of the axis numbers
-        draw_text(renderer, font, ax->y_label, 
-                ax->rect.x - 60, 
+        canvas_text(cv, ax->y_label, 
+                ax->rect.x - ax->ylabel_offset, 
                 ax->rect.y + (ax->rect.h / 2.0f), false, black);
     }
 }
 
+/**
+ * @brief Computes the data range visible in a 2D Axes.
+ * * The view runs from the lower data limit to the upper limit plus 10% headroom 
+ * (or a unit range when the limits are equal). Anything that maps data to pixels 
+ * (rendering, picking) goes through this so they always agree. The range is in 
+ * view units: log10 of the data on a log axis (see set_xscale()), so data must 
+ * go through axes_tx()/axes_ty() before it is compared with it.
+ * * @param ax   Pointer to the Axes.
+ * @param x_lo Receives the left edge of the view.
+ * @param x_hi Receives the right edge of the view.
+ * @param y_lo Receives the bottom edge of the view.
+ * @param y_hi Receives the top edge of the view.
+ */
+void axes_view_2d(const Axes* ax, float* x_lo, float* x_hi, float* y_lo, float* y_hi) {
+    float x0 = axes_tx(ax, ax->x_min), x1 = axes_tx(ax, ax->x_max);
+    float y0 = axes_ty(ax, ax->y_min), y1 = axes_ty(ax, ax->y_max);
+    if (!isfinite(x0)) x0 = 0.0f; // e.g. empty axes, or a limit <= 0 on a log axis
+    if (!isfinite(y0)) y0 = 0.0f;
+    float x_data_diff = isfinite(x1) ? x1 - x0 : 0.0f;
+    float y_data_diff = isfinite(y1) ? y1 - y0 : 0.0f;
+    *x_lo = x0;
+    *y_lo = y0;
+    *x_hi = x0 + ((x_data_diff > 0) ? x_data_diff * 1.1f : 1.0f);
+    *y_hi = y0 + ((y_data_diff > 0) ? y_data_diff * 1.1f : 1.0f);
+}
+
 /**
  * @brief Renders 3D data series within a projected wireframe "cage".
  * * Unlike the 2D renderer, this function utilizes a projection engine to map 
@@ -310,69 +576,116 @@ void render_axes_2d(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
  * rotation (phi and theta).
  * * **Process:**
  * 1. **Cage**: Renders a 3D bounding box to provide a spatial reference.
- * 2. **Projection**: Iterates through series, projecting each 3D point to a screen 
- * pixel using `project_3d`.
- * 3. **Line Strips**: Connects projected points to form 3D paths.
+ * 2. **Projection**: Folds the camera into a View3D once and projects every series 
+ * in bulk.
+ * 3. **Series**: Lines become one polyline; scatters and surfaces are culled, 
+ * radix-sorted by depth and submitted as geometry batches (see sdl_plot3d.c).
  * 4. **Z-Labeling**: Places the Z-axis title at a projected anchor point relative to the cage.
- * * @param renderer The active SDL_Renderer.
- * @param font     The TTF_Font used for text rendering.
- * @param ax       Pointer to the Axes object (must have PROJECTION_3D enabled).
+ * * @param cv The Canvas to draw into.
+ * @param ax Pointer to the Axes object (must have PROJECTION_3D enabled).
  * * @see project_3d, draw_3d_box
  */
-void render_axes_3d(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
+void render_axes_3d(Canvas* cv, Axes* ax) {
     // 1. Draw the Bounding Box (The "Cage")
-    draw_3d_box(renderer, ax);
+    draw_3d_box(cv, ax);
 
-    // 2. Render each 3D Series
+    // 2. Render each 3D Series (the camera is set up once for all of them)
+    View3D view;
+    view3d_setup(ax, &view);
     for (int i = 0; i < ax->line_count; i++) {
-        Series* s = &ax->lines[i];
-        if (s->count < 2) continue;
-
-        // Set the series color
-        SDL_SetRenderDrawColor(renderer, s->color.r, s->color.g, s->color.b, s->color.a);
-
-        for (int j = 0; j < s->count - 1; j++) {
-            float x1, y1, x2, y2;
-
-            // Project the current point and the next point
-            project_3d(ax, s->x[j], s->y[j], s->z[j], &x1, &y1);
-            project_3d(ax, s->x[j+1], s->y[j+1], s->z[j+1], &x2, &y2);
-            SDL_RenderLine(renderer, x1, y1, x2, y2);
-        }
+        render_series_3d(cv, ax, &ax->lines[i], &view);
     }
 
     float lx, ly;
     SDL_Color label_color = {0, 0, 0, 255};
     // X label
     project_3d(ax, (ax->x_min + ax->x_max) * 0.5f, ax->y_min, ax->z_min, &lx, &ly);
-    draw_text(renderer, font, ax->x_label, lx, ly + 30, false, label_color);
+    canvas_text(cv, ax->x_label, lx, ly + 30, false, label_color);
 
     // Y label
     project_3d(ax, ax->x_max, (ax->y_min + ax->y_max) * 0.5f, ax->z_min, &lx, &ly);
-    draw_text(renderer, font, ax->y_label, lx + 35, ly + 15, false, label_color);
+    canvas_text(cv, ax->y_label, lx + 35, ly + 15, false, label_color);
 
     // Z label
     project_3d(ax, ax->x_min, ax->y_min, (ax->z_min + ax->z_max) * 0.5f, &lx, &ly);
-    draw_text(renderer, font, ax->z_label, lx - 40, ly, false, label_color);
+    canvas_text(cv, ax->z_label, lx - 40, ly, false, label_color);
 
 }
 
 /**
  * @brief High-level dispatcher that renders an Axes object based on its projection type.
- * * This acts as the primary interface for the Figure rendering loop. It inspects 
- * the Axes' `projection` member and routes the rendering task to either the 
- * 2D or 3D specific implementation.
+ * * Routes the rendering task to either the 2D or 3D implementation. Any Canvas 
+ * backend can be used, which is how the same code path produces both the live 
+ * window and vector (SVG) exports.
+ * * @param cv The Canvas to draw into.
+ * @param ax Pointer to the Axes object to be drawn.
+ */
+void render_axes_canvas(Canvas* cv, Axes* ax) {
+    if (ax->projection == PROJECTION_3D) {
+        render_axes_3d(cv, ax);
+    } else {
+        render_axes_2d(cv, ax);
+    }
+}
+
+/**
+ * @brief High-level dispatcher that renders an Axes object to an SDL_Renderer.
+ * * This acts as the primary interface for the Figure rendering loop. It wraps the 
+ * renderer in an SDL Canvas and calls render_axes_canvas().
  * * @param renderer The active SDL_Renderer.
  * @param font     The TTF_Font used for rendering.
  * @param ax       Pointer to the Axes object to be drawn.
  * * @note This abstraction allows a single Figure to contain a mix of 2D and 3D subplots.
  */
 void render_axes(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
-    if (ax->projection == PROJECTION_3D) {
-        render_axes_3d(renderer, font, ax);
-    } else {
-        render_axes_2d(renderer, font, ax);
+    Canvas cv;
+    canvas_init_sdl(&cv, renderer, font, ax->arena);
+    render_axes_canvas(&cv, ax);
+}
+
+// Maximum glyphs per SDL_RenderGeometry call in draw_text_glyphs
+#define TEXT_BATCH_GLYPHS 64
+
+// Draws ASCII text from a glyph atlas; returns false (drawing nothing) for other bytes
+static bool draw_text_glyphs(SDL_Renderer* renderer, const GlyphAtlas* ga, const char* text, float x, float y, bool right_align, SDL_Color color) {
+    float w = 0.0f;
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        if (*p < GLYPH_FIRST || *p >= GLYPH_FIRST + GLYPH_COUNT) return false;
+        w += ga->advance[*p - GLYPH_FIRST];
     }
+
+    // Whole pixels, so the atlas is sampled 1:1
+    float pen = floorf(right_align ? x - w : x - w / 2.0f);
+    float top = floorf(y - ga->height / 2.0f);
+    float tw = 0.0f, th = 0.0f;
+    SDL_GetTextureSize(ga->texture, &tw, &th);
+    SDL_FColor fc = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+
+    SDL_Vertex verts[TEXT_BATCH_GLYPHS * 4];
+    int indices[TEXT_BATCH_GLYPHS * 6];
+    int n = 0;
+    for (const unsigned char* p = (const unsigned char*)text; ; p++) {
+        if (n == TEXT_BATCH_GLYPHS || (!*p && n > 0)) {
+            SDL_RenderGeometry(renderer, ga->texture, verts, n * 4, indices, n * 6);
+            n = 0;
+        }
+        if (!*p) break;
+        const SDL_FRect* c = &ga->cell[*p - GLYPH_FIRST];
+        if (c->w > 0.0f) {
+            float u0 = c->x / tw, v0 = c->y / th, u1 = (c->x + c->w) / tw, v1 = (c->y + c->h) / th;
+            SDL_Vertex* v = &verts[n * 4];
+            v[0] = (SDL_Vertex){ { pen, top }, fc, { u0, v0 } };
+            v[1] = (SDL_Vertex){ { pen + c->w, top }, fc, { u1, v0 } };
+            v[2] = (SDL_Vertex){ { pen + c->w, top + c->h }, fc, { u1, v1 } };
+            v[3] = (SDL_Vertex){ { pen, top + c->h }, fc, { u0, v1 } };
+            int* idx = &indices[n * 6];
+            idx[0] = n * 4; idx[1] = n * 4 + 1; idx[2] = n * 4 + 2;
+            idx[3] = n * 4; idx[4] = n * 4 + 2; idx[5] = n * 4 + 3;
+            n++;
+        }
+        pen += ga->advance[*p - GLYPH_FIRST];
+    }
+    return true;
 }
 
 /**
@@ -387,11 +700,14 @@ void render_axes(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
  * @param y           The vertical anchor point (the text is always vertically centered on this).
  * @param right_align If true, 'x' is the right edge of the text. If false, 'x' is the horizontal center.
  * @param color       The SDL_Color for the text.
- * * @note This function performs texture creation and destruction on every call. 
- * For high-performance static text, consider caching textures.
+ * * @note Text in a context font (see sdl_context.h) is drawn from that font's 
+ * glyph atlas as one batch, with no rasterization. Other fonts and non-ASCII 
+ * text fall back to creating and destroying a texture on every call.
  */
 void draw_text(SDL_Renderer* renderer, TTF_Font* font, const char* text, float x, float y, bool right_align, SDL_Color color) {
     if (!text || !font) return;
+    const GlyphAtlas* ga = context_glyphs(renderer, font);
+    if (ga && draw_text_glyphs(renderer, ga, text, x, y, right_align, color)) return;
 
     SDL_Surface* surface = TTF_RenderText_Blended(font, text, 0, color);
     if (!surface) return;
@@ -416,47 +732,19 @@ void draw_text(SDL_Renderer* renderer, TTF_Font* font, const char* text, float x
 }
 
 /**
- * @brief Recalculates the position and size of all Axes based on the window dimensions.
- * * This function implements a responsive layout by defining the plotting area using 
- * percentage-based margins. It ensures that axis labels, titles, and data points 
- * stay within the visible window area when the user resizes the window.
+ * @brief Recalculates the position and size of all Axes for a given figure size.
+ * * Lays the Axes out on the figure's grid (see sdl_layout.h) with tight margins: 
+ * each axes reserves exactly the room its tick labels, axis labels and title need, 
+ * measured from cached font metrics. The solve happens immediately; resize events 
+ * use layout_resize() instead, which defers it to the next frame.
  * * @param fig      Pointer to the Figure whose layout needs updating.
- * @param window_w The current width of the window in pixels (usually from an SDL event).
- * @param window_h The current height of the window in pixels (usually from an SDL event).
- * * @note The current implementation uses a 15% margin on the top/left and 
- * reserves extra space at the bottom (35% total margin) to accommodate 
- * X-axis labels and titles.
+ * @param window_w The figure width in pixels.
+ * @param window_h The figure height in pixels.
  */
 void update_layout(Figure* fig, int window_w, int window_h) {
-    if (fig->axes_count <= 0) return;
-
-    // 1. Determine Grid Dimensions
-    int cols = (fig->axes_count > 1) ? 2 : 1; 
-    int rows = (fig->axes_count + cols - 1) / cols;
-
-    // 2. Calculate individual cell size
-    float cell_w = (float)window_w / cols;
-    float cell_h = (float)window_h / rows;
-
-    for (int i = 0; i < fig->axes_count; i++) {
-        Axes* ax = &fig->axes[i];
-
-        int r = i / cols;
-        int c = i % cols;
-
-        // 3. Dynamic Padding
-        // We need space for Y-axis labels (left) and X-axis labels (bottom)
-        float pad_left   = cell_w * 0.12f; // Room for Y-axis numbers
-        float pad_right  = cell_w * 0.05f; // Small gap on right
-        float pad_top    = cell_h * 0.10f; // Room for Title
-        float pad_bottom = cell_h * 0.15f; // Room for X-axis labels
-
-        // 4. Set the Rectangle
-        ax->rect.x = (c * cell_w) + pad_left;
-        ax->rect.y = (r * cell_h) + pad_top;
-        ax->rect.w = cell_w - (pad_left + pad_right);
-        ax->rect.h = cell_h - (pad_top + pad_bottom);
-    }
+    if (!fig || fig->axes_count <= 0) return;
+    layout_resize(fig, window_w, window_h);
+    layout_update(fig);
 }
 
 /**
@@ -612,7 +900,7 @@ void DrawDashedThickLine(SDL_Renderer* renderer, float x1, float y1, float x2, f
  * @note This function is more computationally expensive than RenderThickLine 
  * due to multiple geometry calls and trigonometric calculations per segment.
  */
-void render_legend(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
+void render_legend(Canvas* cv, Axes* ax) {
     if (!ax->show_legend || ax->line_count == 0) return;
 
     // 1. Position the legend in the top-right corner of the axes
@@ -624,13 +912,12 @@ void render_legend(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
     float box_y = ax->rect.y + padding;
 
     // 2. Draw Legend Background (Semi-transparent white)
-    // SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND); // Ensured now in subplots
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 180);
+    canvas_set_color(cv, (SDL_Color){255, 255, 255, 180});
     SDL_FRect legend_rect = { box_x, box_y, box_w, box_h };
-    SDL_RenderFillRect(renderer, &legend_rect);
+    canvas_rect(cv, &legend_rect, true);
     
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderRect(renderer, &legend_rect);
+    canvas_set_color(cv, (SDL_Color){0, 0, 0, 255});
+    canvas_rect(cv, &legend_rect, false);
 
     // 3. Draw each entry
     for (int i = 0; i < ax->line_count; i++) {
@@ -638,23 +925,24 @@ void render_legend(SDL_Renderer* renderer, TTF_Font* font, Axes* ax) {
         float entry_y = box_y + padding + (i * row_height) + (row_height / 2);
 
         // Draw the Style Proxy (A small line or dot)
-        SDL_SetRenderDrawColor(renderer, s->color.r, s->color.g, s->color.b, 255);
+        canvas_set_color(cv, (SDL_Color){s->color.r, s->color.g, s->color.b, 255});
         if (s->type == PLOT_LINE) {
-            RenderThickLine(renderer, box_x + 5, entry_y, box_x + 25, entry_y, 2.0f);
+            SDL_FPoint proxy[2] = { { box_x + 5, entry_y }, { box_x + 25, entry_y } };
+            canvas_polyline(cv, proxy, 2, 2.0f, STYLE_SOLID);
         } else {
-            SDL_FRect dot = { box_x + 12, entry_y - 3, 6, 6 };
-            SDL_RenderFillRect(renderer, &dot);
+            SDL_FPoint dot = { box_x + 15, entry_y };
+            canvas_markers(cv, &dot, 1, 6.0f);
         }
 
         // Draw the Label Text
-        draw_text(renderer, font, s->label, box_x + 35, entry_y, false, (SDL_Color){0,0,0,255});
+        canvas_text(cv, s->label, box_x + 35, entry_y, false, (SDL_Color){0,0,0,255});
     }
 }
 /**
  * @brief Safely deallocates a Figure and all its associated Axes and Series.
  * * This function performs a deep-clean of the Figure's memory. It frees the 
  * internal arrays for axes and lines, and destroys the SDL_Window and 
- * SDL_Renderer associated with the figure.
+ * SDL_Renderer associated with the figure, along with its Toolbar if one is attached.
  * * @param fig Pointer to the Figure to be destroyed.
  * @note This does NOT free the raw data arrays (x, y) passed to plot(), 
  * as those are owned by the caller.
@@ -668,10 +956,24 @@ void destroy_figure(Figure* fig) {
 
         // 2. Loop through each Series in the Axes
         for (int j = 0; j < ax->line_count; j++) {
-            // If you later decide to malloc the x/y arrays inside the lib, 
-            // you'd free them here. Currently, they are user-owned pointers.
+            // x/y arrays are user-owned, except for streamed series whose 
+            // storage belongs to the stream.
+            destroy_stream(ax->lines[j].stream);
+            pick_destroy(ax->lines[j].pick);
+            runs_destroy(ax->lines[j].runs);
+            scale_cache_destroy(ax->lines[j].scaled);
+            hist_destroy(ax->lines[j].hist);
+            spectrogram_destroy(ax->lines[j].spectro); // Owns a texture
+            heatmap_destroy(ax->lines[j].image);
+            fill_destroy(ax->lines[j].fill);
         }
         
+        // Cached tick label textures belong to the renderer destroyed below
+        axes_unshare(ax, true, true); // The last member frees its group's ticks
+        ticks_invalidate(&ax->x_ticks);
+        ticks_invalidate(&ax->y_ticks);
+        axes_release_cache(ax);
+
         // Free the array of Series
         if (ax->lines) {
             free(ax->lines);
@@ -683,13 +985,23 @@ void destroy_figure(Figure* fig) {
         free(fig->axes);
     }
 
+    arena_destroy(&fig->frame_arena);
+    layout_destroy(fig->layout);
+
     // 4. Clean up SDL Resources
+    figure_stop_recording(fig);
+    if (fig->toolbar) {
+        destroy_toolbar((Toolbar*)fig->toolbar);
+        fig->toolbar = NULL;
+    }
     if (fig->renderer) {
+        context_release_renderer(fig->renderer);
         SDL_DestroyRenderer(fig->renderer);
     }
     if (fig->window) {
         SDL_DestroyWindow(fig->window);
     }
+    context_release(); // Closes the shared fonts after the last figure
 
     // 5. Free the Figure itself
     free(fig);
@@ -710,6 +1022,7 @@ void destroy_figure(Figure* fig) {
  */
 void set_grid(Axes* ax, bool enabled) {
     ax->show_grid = enabled;
+    axes_invalidate_cache(ax); // 3D axes redraw from a cached image
 }
 
 /**
@@ -726,6 +1039,7 @@ void set_grid(Axes* ax, bool enabled) {
 void set_linestyle(Axes* ax, int series_idx, LineStyle style) {
     if (series_idx < ax->line_count) {
         ax->lines[series_idx].style = style;
+        axes_invalidate_cache(ax);
     }
 }
 
@@ -741,6 +1055,7 @@ void set_linestyle(Axes* ax, int series_idx, LineStyle style) {
  */
 void set_legend(Axes* ax, bool enabled) {
     ax->show_legend = enabled;
+    axes_invalidate_cache(ax);
 }
 
 /**
@@ -757,6 +1072,7 @@ void set_legend(Axes* ax, bool enabled) {
 void set_label(Axes* ax, int series_idx, const char* name) {
     if (series_idx < ax->line_count) {
         strncpy(ax->lines[series_idx].label, name, 31);
+        axes_invalidate_cache(ax);
     }
 }
 
@@ -772,6 +1088,7 @@ void set_label(Axes* ax, int series_idx, const char* name) {
  */
 void set_xlabel(Axes* ax, const char* label) {
     ax->x_label = label;
+    axes_invalidate_cache(ax);
 }
 
 /**
@@ -787,6 +1104,7 @@ void set_xlabel(Axes* ax, const char* label) {
  */
 void set_ylabel(Axes* ax, const char* label) {
     ax->y_label = label;
+    axes_invalidate_cache(ax);
 }
 
 /**
@@ -801,6 +1119,389 @@ void set_ylabel(Axes* ax, const char* label) {
  */
 void set_title(Axes* ax, const char* title) {
     ax->title = title;
+    axes_invalidate_cache(ax);
+}
+
+/**
+ * @brief Switches the X axis to time mode with calendar-aware tick labels.
+ * * X values are interpreted as seconds relative to @p epoch_origin, and tick labels 
+ * show the corresponding UTC wall-clock time (e.g. "14:05:30" or "2024-03-01"). 
+ * Ticks snap to whole milliseconds, seconds, minutes, hours or days depending on 
+ * the visible span, and their labels are only regenerated when the view changes.
+ * * @param ax           Pointer to the Axes object to modify.
+ * @param epoch_origin Unix time (seconds since 1970-01-01 UTC) that x = 0 corresponds to.
+ * * @note Series store x as float, which cannot hold raw Unix timestamps with 
+ * sub-minute precision. Subtract a recent origin (e.g. the first sample's 
+ * timestamp) from your data and pass that origin here instead.
+ */
+void set_xaxis_time(Axes* ax, double epoch_origin) {
+    if (!ax) return;
+    ax->x_format = TICKS_TIME;
+    ax->x_time_origin = epoch_origin;
+    axes_invalidate_ticks(ax, false);
+}
+
+/**
+ * @brief Returns the window an event is addressed to, or 0 for global events.
+ */
+static SDL_WindowID event_window_id(const SDL_Event* event) {
+    switch (event->type) {
+        case SDL_EVENT_MOUSE_MOTION:       return event->motion.windowID;
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:    return event->button.windowID;
+        case SDL_EVENT_MOUSE_WHEEL:        return event->wheel.windowID;
+        case SDL_EVENT_KEY_DOWN:           return event->key.windowID;
+        default:
+            // Every window event (shown, exposed, close requested, scale changed, ...)
+            if (event->type >= SDL_EVENT_WINDOW_FIRST && event->type <= SDL_EVENT_WINDOW_LAST) {
+                return event->window.windowID;
+            }
+            return 0;
+    }
+}
+
+/**
+ * @brief Processes a single SDL event on behalf of a Figure and its Toolbar.
+ * * Events addressed to other windows are ignored, so the same event can safely be 
+ * offered to several figures (this is how the FigureManager dispatches). Handles:
+ * - Quit / window close requests (sets `fig->close_requested`).
+ * - Window resizes (updates the layout).
+ * - 3D camera control for the axes under the cursor: left-drag rotates (with 
+ *   inertia), right-drag pans, the wheel zooms (see sdl_camera.c).
+ * - Toolbar interaction, when a toolbar is attached.
+ * Any event that changes what is on screen marks the figure dirty.
+ * * @param fig   Pointer to the Figure.
+ * @param event Pointer to the SDL_Event to process.
+ * @return true if the event belonged to this figure (or was a global event).
+ */
+bool figure_handle_event(Figure* fig, SDL_Event* event) {
+    if (!fig || !event) return false;
+
+    // Handle Global Quit
+    if (event->type == SDL_EVENT_QUIT) {
+        fig->close_requested = true;
+        return true;
+    }
+    if (!fig->window) return false; // Not shown yet: no event can target it
+
+    Toolbar* tb = (Toolbar*)fig->toolbar;
+    SDL_WindowID id = event_window_id(event);
+    SDL_WindowID tb_id = (tb != NULL && tb->window != NULL) ? SDL_GetWindowID(tb->window) : 0;
+    if (id != fig->window_id && (tb_id == 0 || id != tb_id)) return false;
+
+    // For multiwindow support: closing either window closes the figure
+    if (event->type == SDL_EVENT_WINDOW_CLOSE_REQUESTED) {
+        fig->close_requested = true;
+        return true;
+    }
+
+    if (id == tb_id) {
+        handle_toolbar_events(tb, event); // Invalidates the series it edits itself
+        fig->dirty = true;
+        return true;
+    }
+
+    // Mouse positions in layout pixels, like the Axes rects
+    SDL_Event scaled = *event;
+    figure_scale_event(fig, &scaled);
+    event = &scaled;
+
+    switch (event->type) {
+        case SDL_EVENT_WINDOW_RESIZED:
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        case SDL_EVENT_WINDOW_DISPLAY_SCALE_CHANGED:
+        case SDL_EVENT_WINDOW_DISPLAY_CHANGED: // Moved to another monitor
+            figure_update_scale(fig); // Re-laid out on the next frame
+            fig->dirty = true;
+            break;
+        case SDL_EVENT_WINDOW_EXPOSED:
+        case SDL_EVENT_WINDOW_SHOWN:
+        case SDL_EVENT_WINDOW_RESTORED:
+            fig->dirty = true;
+            break;
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+        case SDL_EVENT_MOUSE_WHEEL:
+            camera_handle_event(fig, event);
+            break;
+        case SDL_EVENT_MOUSE_MOTION:
+            // Drags rotate/pan the 3D axes they started on; plain motion hovers
+            if (camera_handle_event(fig, event)) break;
+            if (event->motion.state == 0) {
+                figure_update_hover(fig, event->motion.x, event->motion.y);
+            }
+            break;
+        case SDL_EVENT_WINDOW_MOUSE_LEAVE:
+            if (fig->hover.axes_index >= 0) {
+                fig->hover.axes_index = -1;
+                fig->dirty = true;
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+static void figure_draw(Figure* fig);
+
+/**
+ * @brief Draws one frame of the Figure (and its Toolbar) and presents it.
+ * * Resets the figure's frame arena, clears the window, renders every Axes and 
+ * presents the result. Clears the dirty flag. Does not sleep or poll events, 
+ * so hosts can call it from their own loop with their own frame pacing (it only 
+ * blocks on present when vsync was enabled with figure_set_vsync()).
+ * * @param fig Pointer to the Figure to draw.
+ * * @note Hover/pick indexes, fill batches and 3D images are keyed on the data 
+ * pointers and counts. After editing arrays in place, call figure_mark_dirty() 
+ * before the next frame.
+ */
+void figure_render(Figure* fig) {
+    if (!fig || !figure_realize(fig, true)) return; // Creates the window on the first frame
+
+    figure_draw(fig);
+    if (fig->recorder) recorder_capture(fig->recorder, fig->renderer); // Before present
+    SDL_RenderPresent(fig->renderer);
+    if (fig->timing.first_frame_ns == 0) {
+        fig->timing.first_frame_ns = SDL_GetTicksNS() - fig->timing.created_ns;
+        if (getenv(STARTUP_TIMING_ENV)) figure_print_timing(fig);
+    }
+
+    // --- RENDER TOOLBAR WINDOW ---
+    if (fig->toolbar != NULL) {
+        render_toolbar((Toolbar*)fig->toolbar, fig->font);
+    }
+    fig->dirty = false;
+}
+
+// Draws the figure into its renderer's back buffer without presenting it
+static void figure_draw(Figure* fig) {
+    // Everything allocated from the arena last frame is released in one step
+    arena_reset(&fig->frame_arena);
+    figure_consume_streams(fig);
+    layout_update(fig); // No-op unless the size or an axes' decorations changed
+
+    // --- RENDER GRAPH WINDOW ---
+    Canvas cv;
+    canvas_init_sdl(&cv, fig->renderer, fig->font, &fig->frame_arena);
+    if (fig->pixel_scale != 1.0f) {
+        // HiDPI: layout pixels -> native pixels, text from a font sized for the scale
+        canvas_set_transform(&cv, fig->pixel_scale, 0.0f, 0.0f, fig->text_font);
+        cv.width /= fig->pixel_scale;
+        cv.height /= fig->pixel_scale;
+    }
+    SDL_SetRenderDrawColor(fig->renderer, 255, 255, 255, 255);
+    SDL_RenderClear(fig->renderer);
+    for (int i = 0; i < fig->axes_count; i++) {
+        Axes* ax = &fig->axes[i];
+        if (ax->projection == PROJECTION_3D) {
+            render_axes_3d_cached(&cv, ax); // Re-projects only if this axes' view changed
+        } else {
+            render_axes_canvas(&cv, ax);
+        }
+    }
+    render_hover(&cv, fig);
+}
+
+// Widens a [lo, hi] pair by a value in view units, ignoring values the scale can't show
+static void widen_view(float* lim, float t) {
+    if (!isfinite(t)) return;
+    if (t < lim[0]) lim[0] = t;
+    if (t > lim[1]) lim[1] = t;
+}
+
+// Widens a view-unit [lo, hi] pair by the cached data bounds of every member of a link
+static void widen_by_group(const AxesLink* link, int axis, float* lim) {
+    if (!link) return;
+    for (int i = 0; i < link->count; i++) {
+        const float* d = &link->members[i]->data_lim[axis];
+        if (d[0] > d[1]) continue; // No data
+        widen_view(lim, d[0]);
+        widen_view(lim, d[1]);
+    }
+}
+
+/**
+ * @brief Recomputes an Axes' data limits from all of its series.
+ * * Unlike plot(), which only ever widens the limits, this rescans every series so 
+ * the view can shrink again (e.g. when a streamed window scrolls past an outlier).
+ * * @param ax Pointer to the Axes to rescale.
+ * @note This overrides any limits set manually on the Axes.
+ */
+void axes_autoscale(Axes* ax) {
+    if (!ax) return;
+    // Gathered in view units, where values <= 0 on a log axis are already NaN
+    float* xl = &ax->data_lim[0];
+    float* yl = &ax->data_lim[2];
+    xl[0] = yl[0] = 1e38f;
+    xl[1] = yl[1] = -1e38f;
+    for (int l = 0; l < ax->line_count; l++) {
+        Series* s = &ax->lines[l];
+        const float *sx, *sy;
+        series_scaled(ax, s, &sx, &sy);
+        finite_bounds(sx, sy, s->count, &xl[0], &xl[1], &yl[0], &yl[1]);
+
+        const Histogram* h = s->hist;
+        if (h && (h->has_range || !h->auto_range)) {
+            // Bars span whole bins and stand on zero
+            widen_view(xl, axes_tx(ax, (float)h->lo));
+            widen_view(xl, axes_tx(ax, (float)(h->lo + h->bins * h->width)));
+            widen_view(yl, axes_ty(ax, 0.0f));
+        }
+        fill_bounds(ax, s, xl, yl); // Second band edge, error extents, bar widths
+
+        float lo, hi;
+        if (s->capture && capture_channel_range(s->capture, s->capture_channel, &lo, &hi)) {
+            const Capture* cap = s->capture;
+            widen_view(xl, axes_tx(ax, (float)cap->x_origin));
+            widen_view(xl, axes_tx(ax, (float)(cap->x_origin + (cap->count - 1) / cap->sample_rate)));
+            widen_view(yl, axes_ty(ax, lo));
+            widen_view(yl, axes_ty(ax, hi));
+        }
+    }
+
+    // Linked axes fit their whole group, using the bounds each member measured last
+    float gx[2] = { xl[0], xl[1] }, gy[2] = { yl[0], yl[1] };
+    widen_by_group(ax->x_link, 0, gx);
+    widen_by_group(ax->y_link, 2, gy);
+    xl = gx;
+    yl = gy;
+
+    ax->x_min = 1e38f;  ax->x_max = -1e38f;
+    ax->y_min = 1e38f;  ax->y_max = -1e38f;
+    if (xl[0] <= xl[1]) {
+        ax->x_min = scale_inverse(ax->xscale, ax->x_linthresh, xl[0]);
+        ax->x_max = scale_inverse(ax->xscale, ax->x_linthresh, xl[1]);
+    }
+    if (yl[0] <= yl[1]) {
+        ax->y_min = scale_inverse(ax->yscale, ax->y_linthresh, yl[0]);
+        ax->y_max = scale_inverse(ax->yscale, ax->y_linthresh, yl[1]);
+    }
+    link_propagate(ax->x_link, ax->x_min, ax->x_max);
+    link_propagate(ax->y_link, ax->y_min, ax->y_max);
+}
+
+/**
+ * @brief Drains all thread-fed series of a Figure (see plot_stream()).
+ * * Called from figure_render() and the FigureManager on the render thread. Each 
+ * stream hands over everything its producer published since the last frame in one 
+ * batch; axes that received data are rescaled and the figure is marked dirty.
+ * * @param fig Pointer to the Figure.
+ * @return true if any new samples arrived.
+ */
+bool figure_consume_streams(Figure* fig) {
+    if (!fig) return false;
+    bool any = false;
+    for (int i = 0; i < fig->axes_count; i++) {
+        Axes* ax = &fig->axes[i];
+        bool changed = false;
+        for (int l = 0; l < ax->line_count; l++) {
+            if (ax->lines[l].stream && series_consume_stream(&ax->lines[l]) > 0) {
+                pick_invalidate(ax->lines[l].pick);
+                runs_invalidate(ax->lines[l].runs);
+                scale_cache_invalidate(ax->lines[l].scaled);
+                fill_invalidate(ax->lines[l].fill);
+                changed = true;
+            }
+        }
+        if (changed) axes_invalidate_cache(ax);
+        if (changed && ax->projection == PROJECTION_2D) axes_autoscale(ax);
+        any = any || changed;
+    }
+    if (any) fig->dirty = true;
+    return any;
+}
+
+/**
+ * @brief Flags a Figure for redraw, e.g. after its data arrays were modified.
+ * * The FigureManager only redraws dirty figures; show() redraws every frame. 
+ * Also drops the hover/pick and NaN-run indexes, fill triangles and cached 3D images, since in-place edits 
+ * can't be detected.
+ * * @param fig Pointer to the Figure.
+ */
+void figure_mark_dirty(Figure* fig) {
+    if (!fig) return;
+    fig->dirty = true;
+    for (int i = 0; i < fig->axes_count; i++) {
+        for (int l = 0; l < fig->axes[i].line_count; l++) {
+            series_invalidate(NULL, &fig->axes[i].lines[l]);
+        }
+        axes_invalidate_cache(&fig->axes[i]);
+    }
+}
+
+/**
+ * @brief Drops the derived data of one series after it was edited in place.
+ * * Cheaper than figure_mark_dirty() when only one series changed (e.g. its color 
+ * or thickness from the toolbar): the other series keep their indexes and batches.
+ * * @param ax Axes owning the series, whose cached 3D image is dropped too (may be NULL).
+ * @param s  The edited series.
+ */
+void series_invalidate(Axes* ax, Series* s) {
+    if (!s) return;
+    pick_invalidate(s->pick);
+    runs_invalidate(s->runs);
+    scale_cache_invalidate(s->scaled);
+    fill_invalidate(s->fill);
+    if (ax) axes_invalidate_cache(ax);
+}
+
+/**
+ * @brief Reports whether the user asked to close the figure's window (or quit).
+ * * Intended for hosts that drive the figure from their own loop: keep calling 
+ * figure_handle_event() and figure_render() until this returns true, then decide 
+ * yourself when to call destroy_figure().
+ * * @param fig Pointer to the Figure.
+ * @return true once a close or quit request has been received.
+ */
+bool figure_should_close(Figure* fig) {
+    return !fig || fig->close_requested;
+}
+
+/**
+ * @brief Enables or disables vertical sync for the figure's renderer.
+ * * With vsync on, figure_render() blocks in SDL_RenderPresent() until the next 
+ * display refresh, and show() stops adding its own fixed 16 ms sleep. Hosts with 
+ * their own frame pacing should leave it off (the default).
+ * * @param fig      Pointer to the Figure.
+ * @param interval 0 = off, 1 = every refresh, 2 = every second refresh, -1 = adaptive.
+ * @return true if the renderer accepted the setting.
+ */
+bool figure_set_vsync(Figure* fig, int interval) {
+    if (!fig) return false;
+    // Without a renderer yet, the interval is applied when it is created
+    if (fig->renderer && !SDL_SetRenderVSync(fig->renderer, interval)) return false;
+    fig->vsync = interval;
+    return true;
+}
+
+/**
+ * @brief Starts recording every frame the figure renders (including inside show()).
+ * * Frames are read back right before they are presented, queued, and encoded on a 
+ * background thread. When the encoder falls behind, frames are dropped instead of 
+ * stalling the render loop; in Y4M output the previous frame is repeated over the 
+ * gap so playback keeps real-time pacing.
+ * * @param fig    Pointer to the Figure to record.
+ * @param path   "capture.y4m" for RECORD_Y4M, or a file prefix for RECORD_PNG_SEQUENCE.
+ * @param format RECORD_Y4M or RECORD_PNG_SEQUENCE.
+ * @param fps    Capture rate in frames per second.
+ * @return true if recording started. A recording already in progress is finished first.
+ */
+bool figure_start_recording(Figure* fig, const char* path, RecordFormat format, int fps) {
+    if (!fig || !path) return false;
+    figure_stop_recording(fig);
+    fig->recorder = recorder_start(path, format, fps);
+    return fig->recorder != NULL;
+}
+
+/**
+ * @brief Stops the figure's recording, waiting for queued frames to be written.
+ * * @param fig Pointer to the Figure. Does nothing if it is not recording.
+ */
+void figure_stop_recording(Figure* fig) {
+    if (!fig || !fig->recorder) return;
+    recorder_stop(fig->recorder);
+    fig->recorder = NULL;
 }
 
 /**
@@ -814,86 +1515,34 @@ void set_title(Axes* ax, const char* title) {
  * * @param fig Pointer to the Figure to be displayed.
  * * @note This function is BLOCKING. It will not return until the user closes 
  * the window. For real-time data updates, do not use this function; 
- * instead, implement your own loop and call render_axes() manually.
+ * instead, implement your own loop around figure_handle_event(), 
+ * figure_render() and figure_should_close(), or register the figure with 
+ * a FigureManager.
+ * * @note Every frame is redrawn, but data arrays edited in place from another 
+ * thread still need figure_mark_dirty() for hover tooltips and 3D views to follow.
  * * @warning Because this function calls destroy_figure() internally, the 'fig' 
  * pointer will be invalid after this function returns.
  */
 void show(Figure* fig) {
     if (!fig) return;
 
-    bool running = true;
     SDL_Event event;
-    Toolbar* tb = (Toolbar*)fig->toolbar; // Cast the pointer
-    
+    fig->close_requested = false;
 
-    while (running) {
+    while (!fig->close_requested) {
         while (SDL_PollEvent(&event)) {
-            // Handle Global Quit
-            if (event.type == SDL_EVENT_QUIT) {
-                running = false;
-            }
-            // For multiwindow support
-            if (event.type == SDL_EVENT_WINDOW_CLOSE_REQUESTED) {
-                // 1. Check main window (Safe, because fig always exists)
-                if (event.window.windowID == SDL_GetWindowID(fig->window)) {
-                    running = false;
-                }
-                // 2. ONLY check toolbar if tb is NOT NULL
-                else if (tb != NULL && tb->window != NULL) {
-                    if (event.window.windowID == SDL_GetWindowID(tb->window)) {
-                        running = false; 
-                    }
-                }
-            }
-            if (tb != NULL) {
-                handle_toolbar_events(tb, &event);
-            }
-
-            // Route events to Graph Window (Resizing)
-            if (event.type == SDL_EVENT_WINDOW_RESIZED) {
-                if (event.window.windowID == SDL_GetWindowID(fig->window)) {
-                    update_layout(fig, event.window.data1, event.window.data2);
-                }
-            }
-
-            if (event.type == SDL_EVENT_MOUSE_MOTION) {
-                // Check if left mouse button is held down
-                if (event.motion.state & SDL_BUTTON_LMASK) {
-                    // We only want to rotate the axes the mouse is actually over
-                    for (int i = 0; i < fig->axes_count; i++) {
-                        Axes* ax = &fig->axes[i];
-                        if (ax->projection == PROJECTION_3D) {
-                            // Sensitivity: 0.5 degrees per pixel moved
-                            ax->phi   += event.motion.xrel * 0.5f; 
-                            ax->theta -= event.motion.yrel * 0.5f;
-                            
-                            // Keep theta within reasonable bounds so the graph doesn't flip
-                            if (ax->theta > 89.0f) ax->theta = 89.0f;
-                            if (ax->theta < -89.0f) ax->theta = -89.0f;
-                        }
-                    }
-                }
-            }
-        }
-
-        // --- RENDER GRAPH WINDOW ---
-        SDL_SetRenderDrawColor(fig->renderer, 255, 255, 255, 255);
-        SDL_RenderClear(fig->renderer);
-        for (int i = 0; i < fig->axes_count; i++) {
-            render_axes(fig->renderer, fig->font, &fig->axes[i]);
+            figure_handle_event(fig, &event);
         }
-        SDL_RenderPresent(fig->renderer);
+        figure_update_camera(fig);
 
-        // --- RENDER TOOLBAR WINDOW ---
-        if (tb != NULL) {
-            render_toolbar(tb, fig->font);
-        }
+        // Redraw every frame: callers may be updating their data arrays live. Hover
+        // indexes and 3D images are keyed on pointers, so such edits need figure_mark_dirty()
+        figure_render(fig);
+        if (fig->vsync == 0) SDL_Delay(16); // With vsync the present call paces us
 
-        SDL_Delay(16);
     }
 
-    // Clean up
-    if (tb != NULL) destroy_toolbar(tb); //Destroy figure already has destroy_toolbar
+    // Clean up (destroy_figure also destroys the toolbar)
     destroy_figure(fig);
 }
 
@@ -910,8 +1559,10 @@ void show(Figure* fig) {
  * @warning This function requires the SDL_image library to be initialized.
  */
 void save_figure_as_png(Figure* fig, const char* filename) {
-    // 1. Grab the pixels from the renderer into a surface
-    // NULL reads the entire viewport
+    // 1. Draw the current state (into a hidden window if none exists yet), then
+    // grab the pixels from the renderer into a surface. NULL reads the entire viewport
+    if (!fig || !filename || !figure_realize(fig, false)) return;
+    figure_draw(fig);
     SDL_Surface* surface = SDL_RenderReadPixels(fig->renderer, NULL);
     
     if (surface) {
@@ -941,11 +1592,13 @@ void set_projection(Axes* ax, ProjectionType proj) {
     if (!ax) return;
     
     ax->projection = proj;
+    if (proj == PROJECTION_3D) axes_unshare(ax, true, true); // Links are 2D only
     
     if (proj == PROJECTION_3D) {
         ax->phi = 300.0f;
         ax->theta = 30.0f; 
         ax->zoom = 1.0f;
+        ax->pan_x = ax->pan_y = 0.0f;
         
         // Initialize Z bounds to something sensible
         ax->z_min = -1.0f;
@@ -954,6 +1607,7 @@ void set_projection(Axes* ax, ProjectionType proj) {
         ax->y_label= "Y-Axis";
         ax->z_label= "Z-Axis";
     }
+    axes_invalidate_cache(ax);
 }
 
 
@@ -1002,8 +1656,8 @@ static void project_3d(Axes* ax, float x, float y, float z, float* px, float* py
     // Scale the projected points to fit the screen area
     float scale = (ax->rect.w < ax->rect.h ? ax->rect.w : ax->rect.h) * 0.4f * ax->zoom;
 
-    *px = cx + x2 * scale;
-    *py = cy - y2 * scale; // Subtract because SDL Y-axis goes down
+    *px = cx + (x2 + ax->pan_x) * scale;
+    *py = cy + (ax->pan_y - y2) * scale; // y2 is negated because SDL Y-axis goes down
 }
 
 /**
@@ -1012,15 +1666,15 @@ static void project_3d(Axes* ax, float x, float y, float z, float* px, float* py
  * Axes' min/max bounds, projects them into 2D screen space, and draws the 
  * connecting edges to form a cube. This "cage" provides necessary depth 
  * cues for the user to interpret the 3D data.
- * * @param renderer The SDL_Renderer used for drawing lines.
- * @param ax       Pointer to the Axes struct containing 3D bounds and 
+ * * @param cv The Canvas used for drawing lines.
+ * @param ax Pointer to the Axes struct containing 3D bounds and 
  * camera rotation state (phi/theta).
  * * @note This function connects:
  * - 4 edges for the bottom face (z_min)
  * - 4 edges for the top face (z_max)
  * - 4 vertical edges connecting top and bottom faces.
  */
-void draw_3d_box(SDL_Renderer* renderer, Axes* ax) {
+void draw_3d_box(Canvas* cv, Axes* ax) {
     float corners[8][3] = {
         {ax->x_min, ax->y_min, ax->z_min}, {ax->x_max, ax->y_min, ax->z_min},
         {ax->x_max, ax->y_max, ax->z_min}, {ax->x_min, ax->y_max, ax->z_min},
@@ -1033,12 +1687,12 @@ void draw_3d_box(SDL_Renderer* renderer, Axes* ax) {
         project_3d(ax, corners[i][0], corners[i][1], corners[i][2], &px[i], &py[i]);
     }
 
-    SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255); // Light gray cage
+    canvas_set_color(cv, (SDL_Color){200, 200, 200, 255}); // Light gray cage
     
     // Connect bottom 4, top 4, and vertical 4
     for (int i = 0; i < 4; i++) {
-        SDL_RenderLine(renderer, px[i], py[i], px[(i+1)%4], py[(i+1)%4]);         // Bottom
-        SDL_RenderLine(renderer, px[i+4], py[i+4], px[((i+1)%4)+4], py[((i+1)%4)+4]); // Top
-        SDL_RenderLine(renderer, px[i], py[i], px[i+4], py[i+4]);               // Verticals
+        canvas_line(cv, px[i], py[i], px[(i+1)%4], py[(i+1)%4]);         // Bottom
+        canvas_line(cv, px[i+4], py[i+4], px[((i+1)%4)+4], py[((i+1)%4)+4]); // Top
+        canvas_line(cv, px[i], py[i], px[i+4], py[i+4]);               // Verticals
     }
-}
\ No newline at end of file
+}
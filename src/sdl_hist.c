@@ -0,0 +1,401 @@
+#include <SDL3/SDL.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_hist.h"
+#include "sdl_canvas.h"
+#include "sdl_scale.h"
+#include "sdl_link.h"
+
+// Samples whose bin indices are computed together before the counts are touched
+#define HIST_BLOCK 1024
+
+// --- Binning kernels -----------------------------------------------------------
+
+/**
+ * @brief Bins one block of samples into @p counts (bins + 1 entries, the last one 
+ * collects rejects).
+ * * The index computation is branch-free (selects instead of ifs) so compilers 
+ * vectorize it; only the increments are scalar. Whether a sample is in range is 
+ * decided on the value against [lo, hi], not on the scaled index, so rounding in 
+ * the float reciprocal can't reject the maximum of an auto-ranged histogram.
+ */
+static void bin_block(const float* v, int n, float lo, float hi, float inv_width, int bins, Uint32* counts) {
+    int idx[HIST_BLOCK];
+    float last = (float)bins - 0.5f;
+    float reject = (float)bins;
+    for (int i = 0; i < n; i++) {
+        float t = (v[i] - lo) * inv_width;
+        bool ok = v[i] >= lo && v[i] <= hi; // NaN fails both
+        float c = t < last ? t : last;      // Right edge (and rounding past it) belongs to the last bin
+        idx[i] = (int)(ok ? c : reject);
+    }
+    for (int i = 0; i < n; i++) counts[idx[i]]++;
+}
+
+static void minmax_block(const float* v, size_t n, float* mn, float* mx) {
+    float lo = *mn, hi = *mx;
+    for (size_t i = 0; i < n; i++) {
+        bool finite = fabsf(v[i]) <= FLT_MAX; // False for NaN and +-Inf
+        lo = (finite && v[i] < lo) ? v[i] : lo;
+        hi = (finite && v[i] > hi) ? v[i] : hi;
+    }
+    *mn = lo;
+    *mx = hi;
+}
+
+typedef struct {
+    const float* samples;
+    size_t count;
+    bool find_range;      // Pass 1: min/max; pass 2: bin
+    float lo, hi, inv_width;
+    int bins;
+    Uint32* counts;       // Private partial histogram (bins + 1)
+    float mn, mx;
+} HistJob;
+
+static int hist_worker(void* data) {
+    HistJob* job = (HistJob*)data;
+    if (job->find_range) {
+        job->mn = INFINITY;
+        job->mx = -INFINITY;
+        minmax_block(job->samples, job->count, &job->mn, &job->mx);
+        return 0;
+    }
+    memset(job->counts, 0, sizeof(Uint32) * (job->bins + 1));
+    for (size_t i = 0; i < job->count; i += HIST_BLOCK) {
+        size_t n = job->count - i < HIST_BLOCK ? job->count - i : HIST_BLOCK;
+        bin_block(job->samples + i, (int)n, job->lo, job->hi, job->inv_width, job->bins, job->counts);
+    }
+    return 0;
+}
+
+// Runs one pass over the samples on up to HIST_MAX_THREADS threads
+static void run_jobs(HistJob* jobs, int threads) {
+    SDL_Thread* workers[HIST_MAX_THREADS];
+    for (int t = 1; t < threads; t++) {
+        workers[t] = SDL_CreateThread(hist_worker, "hist_worker", &jobs[t]);
+    }
+    hist_worker(&jobs[0]); // The calling thread takes the first slice
+    for (int t = 1; t < threads; t++) {
+        if (workers[t]) {
+            SDL_WaitThread(workers[t], NULL);
+        } else {
+            hist_worker(&jobs[t]); // Thread creation failed: do it inline
+        }
+    }
+}
+
+// --- Range management ------------------------------------------------------------
+
+static double hist_hi(const Histogram* h) {
+    return h->lo + h->bins * h->width;
+}
+
+/**
+ * @brief Widens an auto-ranged histogram until it covers [mn, mx].
+ * * Each step doubles the bin width and merges bins pairwise, so existing counts 
+ * stay exact without revisiting old samples. Growing downwards also moves the 
+ * origin down by a whole number of old bins, which keeps every old bin inside 
+ * exactly one new one.
+ */
+static void hist_grow(Histogram* h, float mn, float mx) {
+    for (int step = 0; step < 64 && (mn < h->lo || mx > hist_hi(h)); step++) {
+        int shift = (mn < h->lo) ? h->bins : 0; // In old bins
+        Uint64* merged = calloc(h->bins, sizeof(Uint64));
+        if (!merged) return;
+        for (int i = 0; i < h->bins; i++) {
+            int j = (i + shift) / 2;
+            if (j < h->bins) merged[j] += h->counts[i];
+        }
+        memcpy(h->counts, merged, sizeof(Uint64) * h->bins);
+        free(merged);
+        h->lo -= shift * h->width;
+        h->width *= 2.0;
+    }
+}
+
+// Refreshes the Series view of the counts and widens the Axes to show every bar
+static void hist_sync(Histogram* h) {
+    h->max_count = 0;
+    for (int i = 0; i < h->bins; i++) {
+        h->centers[i] = (float)(h->lo + (i + 0.5) * h->width);
+        h->heights[i] = (float)h->counts[i];
+        if (h->counts[i] > h->max_count) h->max_count = h->counts[i];
+    }
+
+    Axes* ax = h->ax;
+    if (!ax || !(h->has_range || !h->auto_range)) return;
+    if (axes_full_rescan(ax)) {
+        axes_autoscale(ax); // The zero baseline can't go on a log axis; linked groups refit
+        return;
+    }
+    float lo = (float)h->lo, hi = (float)hist_hi(h);
+    if (lo < ax->x_min) ax->x_min = lo;
+    if (hi > ax->x_max) ax->x_max = hi;
+    if (0.0f < ax->y_min) ax->y_min = 0.0f;
+    if ((float)h->max_count > ax->y_max) ax->y_max = (float)h->max_count;
+}
+
+/**
+ * @brief Bins more samples into a histogram.
+ * * Large batches are split across CPU cores: every thread fills a private 
+ * partial histogram over a contiguous slice and the partials are summed at the 
+ * end, so threads never contend on shared counters. Auto-ranged histograms first 
+ * find the batch's finite min/max (also in parallel) and widen their range to fit.
+ * * @param h       Pointer to the Histogram (from hist(), hist_range() or hist_stream()).
+ * @param samples Values to bin. NaN/Inf and out-of-range values are counted in h->rejected.
+ * @param count   Number of values.
+ * * @note Call from the render thread (or between frames), then figure_mark_dirty().
+ */
+void hist_add(Histogram* h, const float* samples, size_t count) {
+    if (!h || !samples || count == 0) return;
+
+    int threads = 1;
+    if (count >= HIST_PARALLEL_MIN) {
+        threads = SDL_GetNumLogicalCPUCores();
+        if (threads < 1) threads = 1;
+        if (threads > HIST_MAX_THREADS) threads = HIST_MAX_THREADS;
+        if ((size_t)threads > count / (HIST_PARALLEL_MIN / 4)) threads = (int)(count / (HIST_PARALLEL_MIN / 4));
+    }
+    HistJob jobs[HIST_MAX_THREADS];
+    size_t per_thread = (count + threads - 1) / threads;
+    for (int t = 0; t < threads; t++) {
+        size_t begin = t * per_thread;
+        jobs[t].samples = samples + begin;
+        jobs[t].count = begin < count ? (count - begin < per_thread ? count - begin : per_thread) : 0;
+        jobs[t].bins = h->bins;
+        jobs[t].counts = NULL;
+    }
+
+    // --- STEP 1: Auto range: find the batch's extent and grow to cover it ---
+    if (h->auto_range) {
+        for (int t = 0; t < threads; t++) jobs[t].find_range = true;
+        run_jobs(jobs, threads);
+        float mn = INFINITY, mx = -INFINITY;
+        for (int t = 0; t < threads; t++) {
+            if (jobs[t].mn < mn) mn = jobs[t].mn;
+            if (jobs[t].mx > mx) mx = jobs[t].mx;
+        }
+        if (mn > mx) { // Nothing finite in this batch
+            h->rejected += count;
+            return;
+        }
+        if (!h->has_range) {
+            h->has_range = true;
+            h->lo = (mn < mx) ? mn : mn - 0.5;
+            h->width = (mn < mx) ? ((double)mx - mn) / h->bins : 1.0 / h->bins;
+        } else {
+            hist_grow(h, mn, mx);
+        }
+    }
+
+    // --- STEP 2: Per-thread partial histograms ---
+    Uint32* partials = malloc(sizeof(Uint32) * (h->bins + 1) * threads);
+    if (!partials) return;
+    for (int t = 0; t < threads; t++) {
+        jobs[t].find_range = false;
+        jobs[t].lo = (float)h->lo;
+        jobs[t].hi = (float)hist_hi(h);
+        jobs[t].inv_width = (float)(1.0 / h->width);
+        jobs[t].counts = partials + (size_t)t * (h->bins + 1);
+    }
+    run_jobs(jobs, threads);
+
+    // --- STEP 3: Merge ---
+    for (int t = 0; t < threads; t++) {
+        const Uint32* c = jobs[t].counts;
+        for (int i = 0; i < h->bins; i++) h->counts[i] += c[i];
+        h->rejected += c[h->bins];
+        h->total += jobs[t].count - c[h->bins];
+    }
+    free(partials);
+    hist_sync(h);
+}
+
+/**
+ * @brief Resets all counts (and, for auto range, the range) of a histogram.
+ */
+void hist_clear(Histogram* h) {
+    if (!h) return;
+    memset(h->counts, 0, sizeof(Uint64) * h->bins);
+    h->total = h->rejected = 0;
+    if (h->auto_range) h->has_range = false;
+    hist_sync(h);
+}
+
+static Histogram* hist_create(Axes* ax, int bins, bool auto_range, double lo, double hi) {
+    Histogram* h = calloc(1, sizeof(Histogram));
+    if (!h) return NULL;
+    h->bins = bins;
+    h->auto_range = auto_range;
+    h->lo = lo;
+    h->width = auto_range ? 1.0 : (hi - lo) / bins;
+    h->counts = calloc(bins, sizeof(Uint64));
+    h->centers = calloc(bins, sizeof(float));
+    h->heights = calloc(bins, sizeof(float));
+    if (!h->counts || !h->centers || !h->heights) {
+        hist_destroy(h);
+        return NULL;
+    }
+    h->ax = ax;
+    return h;
+}
+
+// Registers a PLOT_HIST series backed by 'h'
+static void hist_attach(Axes* ax, Histogram* h, SDL_Color color) {
+    plot(ax, h->centers, h->heights, 0, color);
+    Series* s = &ax->lines[ax->line_count - 1];
+    s->type = PLOT_HIST;
+    s->hist = h;
+    s->count = h->bins;
+}
+
+// Sturges' rule, used when no bin count is given
+static int auto_bins(int count) {
+    int bins = (count > 1) ? (int)ceil(log2((double)count)) + 1 : 1;
+    return bins < HIST_MAX_BINS ? bins : HIST_MAX_BINS;
+}
+
+/**
+ * @brief Adds a histogram of raw samples (Matplotlib's ax.hist).
+ * * The bin range follows the data: it starts at the samples' min/max and widens 
+ * (merging bins pairwise) when hist_add() brings values outside it.
+ * * @param ax      Pointer to the Axes.
+ * @param samples Values to bin (copied into counts; the array is not kept).
+ * @param count   Number of values.
+ * @param bins    Number of bins, or <= 0 to pick one from the sample count.
+ * @param color   Bar color.
+ * @return The Histogram behind the series (for hist_add()), or NULL on failure.
+ */
+Histogram* hist(Axes* ax, const float* samples, int count, int bins, SDL_Color color) {
+    if (!ax) return NULL;
+    if (bins <= 0) bins = auto_bins(count);
+    if (bins > HIST_MAX_BINS) bins = HIST_MAX_BINS;
+
+    Histogram* h = hist_create(ax, bins, true, 0.0, 0.0);
+    if (!h) return NULL;
+    hist_attach(ax, h, color);
+    if (samples && count > 0) hist_add(h, samples, (size_t)count);
+    return h;
+}
+
+/**
+ * @brief Adds a histogram with fixed, equal-width bins over [lo, hi].
+ * * Values outside the range are not drawn; they are counted in h->rejected.
+ * * @return The Histogram behind the series, or NULL if the range or bin count is invalid.
+ */
+Histogram* hist_range(Axes* ax, const float* samples, int count, int bins, float lo, float hi, SDL_Color color) {
+    if (!ax || !(hi > lo)) return NULL;
+    if (bins <= 0) bins = auto_bins(count);
+    if (bins > HIST_MAX_BINS) bins = HIST_MAX_BINS;
+
+    Histogram* h = hist_create(ax, bins, false, lo, hi);
+    if (!h) return NULL;
+    hist_attach(ax, h, color);
+    hist_sync(h);
+    if (samples && count > 0) hist_add(h, samples, (size_t)count);
+    return h;
+}
+
+/**
+ * @brief Adds an auto-ranged histogram fed from a producer thread.
+ * * Push values with hist_push(). Every frame the render thread bins whatever 
+ * arrived since the last one straight out of the stream's ring, so the cost per 
+ * frame is proportional to the new samples, not to everything seen so far.
+ * * @param capacity Values the ring holds between two frames (<= 0 = HIST_STREAM_RING, 
+ * about 63M values/s at 60 fps). Size it for the producer's peak rate per frame.
+ * @return The stream to push into, or NULL on failure.
+ */
+SeriesStream* hist_stream(Axes* ax, int bins, int capacity, SDL_Color color) {
+    if (!ax) return NULL;
+    if (bins <= 0) bins = 64;
+    if (bins > HIST_MAX_BINS) bins = HIST_MAX_BINS;
+
+    Histogram* h = hist_create(ax, bins, true, 0.0, 0.0);
+    if (!h) return NULL;
+    SeriesStream* st = plot_value_stream(ax, capacity > 0 ? capacity : HIST_STREAM_RING, color);
+    if (!st) {
+        hist_destroy(h);
+        return NULL;
+    }
+    Series* s = &ax->lines[ax->line_count - 1];
+    s->type = PLOT_HIST;
+    s->hist = h;
+    s->x = h->centers;
+    s->y = h->heights;
+    s->count = h->bins;
+    return st;
+}
+
+/**
+ * @brief Pushes values into a stream created by hist_stream(). Never blocks.
+ * * @return The number of values accepted. When more than the ring's capacity arrives 
+ * between two frames, the rest is dropped (not binned) and counted in `stream->dropped`.
+ */
+int hist_push(SeriesStream* stream, const float* values, int count) {
+    return stream_push_values(stream, values, count);
+}
+
+/**
+ * @brief Draws a histogram series as one batch of bar quads.
+ * * Bars are clipped to the visible range and empty bins are skipped, so even 
+ * thousands of bins cost a single geometry submission.
+ */
+void render_hist(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi) {
+    const Histogram* h = s->hist;
+    if (!h || h->bins <= 0 || (h->auto_range && !h->has_range)) return;
+
+    SDL_Vertex* verts = arena_alloc_array(cv->arena, SDL_Vertex, h->bins * 4);
+    int* indices = arena_alloc_array(cv->arena, int, h->bins * 6);
+    if (!verts || !indices) return;
+
+    float x_scale = ax->rect.w / (x_hi - x_lo);
+    float y_scale = ax->rect.h / (y_hi - y_lo);
+    float left = ax->rect.x, right = ax->rect.x + ax->rect.w;
+    float top = ax->rect.y, bottom = ax->rect.y + ax->rect.h;
+    float base = bottom - (axes_ty(ax, 0.0f) - y_lo) * y_scale;
+    if (!isfinite(base)) base = bottom; // Log axis: bars rise from the bottom edge
+    if (base > bottom) base = bottom;
+    if (base < top) base = top;
+    SDL_FColor fc = { s->color.r / 255.0f, s->color.g / 255.0f, s->color.b / 255.0f, 1.0f };
+
+    int n = 0;
+    for (int i = 0; i < h->bins; i++) {
+        if (h->counts[i] == 0) continue;
+        float x0 = left + (axes_tx(ax, (float)(h->lo + i * h->width)) - x_lo) * x_scale;
+        float x1 = left + (axes_tx(ax, (float)(h->lo + (i + 1) * h->width)) - x_lo) * x_scale;
+        float y0 = bottom - (axes_ty(ax, (float)h->counts[i]) - y_lo) * y_scale;
+        if (x0 < left) x0 = left;
+        if (x1 > right) x1 = right;
+        if (y0 < top) y0 = top;
+        if (x1 <= x0 || y0 >= base) continue;
+
+        SDL_Vertex* v = &verts[n * 4];
+        v[0].position = (SDL_FPoint){ x0, y0 };
+        v[1].position = (SDL_FPoint){ x1, y0 };
+        v[2].position = (SDL_FPoint){ x1, base };
+        v[3].position = (SDL_FPoint){ x0, base };
+        for (int k = 0; k < 4; k++) {
+            v[k].color = fc;
+            v[k].tex_coord = (SDL_FPoint){ 0, 0 };
+        }
+        int* idx = &indices[n * 6];
+        idx[0] = n * 4; idx[1] = n * 4 + 1; idx[2] = n * 4 + 2;
+        idx[3] = n * 4; idx[4] = n * 4 + 2; idx[5] = n * 4 + 3;
+        n++;
+    }
+    canvas_geometry(cv, verts, n * 4, indices, n * 6);
+}
+
+/**
+ * @brief Frees a histogram. Called by destroy_figure().
+ */
+void hist_destroy(Histogram* h) {
+    if (!h) return;
+    free(h->counts);
+    free(h->centers);
+    free(h->heights);
+    free(h);
+}
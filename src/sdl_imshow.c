@@ -0,0 +1,302 @@
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_imshow.h"
+#include "sdl_canvas.h"
+#include "sdl_scale.h"
+
+// Resamples the 256-entry colormap into a finer table of ready-to-store pixels
+static void heatmap_build_lut(Heatmap* hm, Colormap cmap) {
+    const SDL_Color* base = colormap_lut(cmap != COLORMAP_NONE ? cmap : COLORMAP_VIRIDIS);
+    for (int i = 0; i < HEATMAP_LUT_SIZE; i++) {
+        float pos = (float)i / (HEATMAP_LUT_SIZE - 1) * (COLORMAP_SIZE - 1);
+        int k = (int)pos;
+        if (k > COLORMAP_SIZE - 2) k = COLORMAP_SIZE - 2;
+        float f = pos - k;
+        SDL_Color a = base[k], b = base[k + 1];
+        Uint8 px[4] = {
+            (Uint8)(a.r + (b.r - a.r) * f + 0.5f),
+            (Uint8)(a.g + (b.g - a.g) * f + 0.5f),
+            (Uint8)(a.b + (b.b - a.b) * f + 0.5f),
+            255
+        };
+        memcpy(&hm->lut[i], px, 4); // Byte order of SDL_PIXELFORMAT_RGBA32 on any host
+    }
+}
+
+// Min/max over finite values; falls back to [0, 1] when no value is finite
+static void heatmap_scan_range(Heatmap* hm) {
+    float lo = INFINITY, hi = -INFINITY;
+    size_t n = (size_t)hm->rows * hm->cols;
+    for (size_t i = 0; i < n; i++) {
+        float v = hm->data[i];
+        if (!isfinite(v)) continue; // NaN and +-Inf cells take the end colors
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+    if (lo > hi) { lo = 0.0f; hi = 1.0f; }
+    if (!(hi > lo)) hi = lo + 1.0f;
+    hm->vmin = lo;
+    hm->vmax = hi;
+}
+
+static void heatmap_mark_dirty(Heatmap* hm, int lo, int hi) {
+    if (hm->dirty_hi <= hm->dirty_lo) {
+        hm->dirty_lo = lo;
+        hm->dirty_hi = hi;
+        return;
+    }
+    if (lo < hm->dirty_lo) hm->dirty_lo = lo;
+    if (hi > hm->dirty_hi) hm->dirty_hi = hi;
+}
+
+/**
+ * @brief Converts one row of values into packed pixels through the heatmap's LUT.
+ * * The loop body is branch-free (compare/select to clamp, then a table load), so
+ * the index computation vectorizes and the cost is a few cycles per pixel. Values
+ * below vmin and NaN get the first color; values above vmax get the last.
+ * * @param hm     Pointer to the Heatmap (for vmin/vmax and the LUT).
+ * @param values Input row.
+ * @param out    Destination pixels (SDL_PIXELFORMAT_RGBA32).
+ * @param count  Number of values.
+ */
+void heatmap_convert_row(const Heatmap* hm, const float* values, Uint32* out, int count) {
+    const float scale = (HEATMAP_LUT_SIZE - 1) / (hm->vmax - hm->vmin);
+    const float offset = -hm->vmin * scale + 0.5f;
+    const float top = (float)(HEATMAP_LUT_SIZE - 1);
+    const Uint32* lut = hm->lut;
+    for (int i = 0; i < count; i++) {
+        float t = values[i] * scale + offset;
+        t = (t > 0.0f) ? t : 0.0f; // Also catches NaN
+        t = (t < top) ? t : top;
+        out[i] = lut[(int)t];
+    }
+}
+
+/**
+ * @brief Shows a float matrix as a colormapped image (Matplotlib's ax.imshow).
+ * * Row 0 is drawn at the top, as in an image. By default cell (r, c) covers 
+ * x in [c, c+1] and y in [rows-r-1, rows-r]; see imshow_set_extent(). The color 
+ * limits come from the data's finite min/max unless set with imshow_set_clim().
+ * * @param ax   Pointer to the Axes.
+ * @param data rows * cols values, row-major. The array is not copied and must 
+ * outlive the figure (like plot()'s x/y).
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param cmap Colormap (COLORMAP_NONE = viridis).
+ * @return The Heatmap behind the series, or NULL on failure.
+ */
+Heatmap* imshow(Axes* ax, const float* data, int rows, int cols, Colormap cmap) {
+    if (!ax || !data || rows <= 0 || cols <= 0) return NULL;
+    Heatmap* hm = calloc(1, sizeof(Heatmap));
+    if (!hm) return NULL;
+    hm->data = data;
+    hm->rows = rows;
+    hm->cols = cols;
+    hm->auto_clim = true;
+    hm->ax = ax;
+    heatmap_build_lut(hm, cmap);
+    heatmap_scan_range(hm);
+    heatmap_mark_dirty(hm, 0, rows);
+    hm->extent_x[0] = 0.0f;
+    hm->extent_x[1] = (float)cols;
+    hm->extent_y[0] = 0.0f;
+    hm->extent_y[1] = (float)rows;
+
+    plot(ax, hm->extent_x, hm->extent_y, 2, (SDL_Color){0, 0, 0, 255});
+    Series* s = &ax->lines[ax->line_count - 1];
+    s->type = PLOT_IMAGE;
+    s->image = hm;
+    s->colormap = cmap;
+    return hm;
+}
+
+/**
+ * @brief Marks rows whose values changed in place, so only they are re-uploaded.
+ * * Call figure_mark_dirty() afterwards. Color limits are left alone, so a partial 
+ * update never forces the rest of the image to be converted again.
+ * * @param hm        Pointer to the Heatmap.
+ * @param first_row First changed row.
+ * @param num_rows  Number of changed rows.
+ */
+void imshow_update_rows(Heatmap* hm, int first_row, int num_rows) {
+    if (!hm || num_rows <= 0) return;
+    int lo = first_row < 0 ? 0 : first_row;
+    int hi = first_row + num_rows > hm->rows ? hm->rows : first_row + num_rows;
+    if (hi > lo) heatmap_mark_dirty(hm, lo, hi);
+}
+
+/**
+ * @brief Points the heatmap at a new matrix of the same shape (e.g. a new frame).
+ * * Rescans the color limits unless they were fixed with imshow_set_clim().
+ */
+void imshow_set_data(Heatmap* hm, const float* data) {
+    if (!hm || !data) return;
+    hm->data = data;
+    if (hm->auto_clim) heatmap_scan_range(hm);
+    heatmap_mark_dirty(hm, 0, hm->rows);
+}
+
+/**
+ * @brief Fixes the values mapped to the ends of the colormap.
+ */
+void imshow_set_clim(Heatmap* hm, float vmin, float vmax) {
+    if (!hm || !(vmax > vmin)) return;
+    hm->vmin = vmin;
+    hm->vmax = vmax;
+    hm->auto_clim = false;
+    heatmap_mark_dirty(hm, 0, hm->rows);
+}
+
+/**
+ * @brief Places the image in data coordinates (Matplotlib's extent=).
+ * * @param x0 Left edge. @param x1 Right edge.
+ * @param y0 Bottom edge (last row). @param y1 Top edge (row 0).
+ */
+void imshow_set_extent(Heatmap* hm, float x0, float x1, float y0, float y1) {
+    if (!hm || x0 == x1 || y0 == y1) return;
+    hm->extent_x[0] = x0 < x1 ? x0 : x1;
+    hm->extent_x[1] = x0 < x1 ? x1 : x0;
+    hm->extent_y[0] = y0 < y1 ? y0 : y1;
+    hm->extent_y[1] = y0 < y1 ? y1 : y0;
+    if (hm->ax->projection == PROJECTION_2D) axes_autoscale(hm->ax);
+}
+
+// Converts the dirty rows straight into the locked texture (no intermediate copy)
+static void heatmap_upload(Heatmap* hm) {
+    SDL_Rect r = { 0, hm->dirty_lo, hm->cols, hm->dirty_hi - hm->dirty_lo };
+    void* pixels;
+    int pitch;
+    if (!SDL_LockTexture(hm->texture, &r, &pixels, &pitch)) return;
+    for (int row = 0; row < r.h; row++) {
+        heatmap_convert_row(hm, hm->data + (size_t)(r.y + row) * hm->cols,
+                            (Uint32*)((Uint8*)pixels + (size_t)row * pitch), hm->cols);
+    }
+    SDL_UnlockTexture(hm->texture);
+    hm->dirty_lo = hm->dirty_hi = 0;
+}
+
+// Unpacks one LUT entry (bytes in SDL_PIXELFORMAT_RGBA32 order)
+static SDL_Color heatmap_color(const Heatmap* hm, float value) {
+    Uint32 px;
+    Uint8 b[4];
+    heatmap_convert_row(hm, &value, &px, 1);
+    memcpy(b, &px, 4);
+    return (SDL_Color){ b[0], b[1], b[2], b[3] };
+}
+
+/**
+ * @brief Draws the cells inside the clip rect as filled rects, for canvases without 
+ * textures (SVG and the anti-aliased raster export).
+ * * Cells smaller than an output pixel are sampled (nearest cell), and runs of equal 
+ * color along a row are merged, so the output stays proportional to the area drawn 
+ * rather than to the matrix size.
+ */
+static void heatmap_render_cells(Canvas* cv, const Heatmap* hm, float sx0, float sx1, float sy0, float sy1,
+                                 float cx0, float cx1, float cy0, float cy1) {
+    float cw = (sx1 - sx0) / hm->cols, ch = (sy1 - sy0) / hm->rows;
+    int step_c = (int)(1.0f / (cw * cv->scale)), step_r = (int)(1.0f / (ch * cv->scale));
+    if (step_c < 1) step_c = 1;
+    if (step_r < 1) step_r = 1;
+
+    int c0 = (int)((cx0 - sx0) / cw), c1 = (int)ceilf((cx1 - sx0) / cw);
+    int r0 = (int)((cy0 - sy0) / ch), r1 = (int)ceilf((cy1 - sy0) / ch);
+    if (c1 > hm->cols) c1 = hm->cols;
+    if (r1 > hm->rows) r1 = hm->rows;
+    c0 -= c0 % step_c;
+    r0 -= r0 % step_r;
+    if (c0 >= c1 || r0 >= r1) return;
+
+    for (int r = r0; r < r1; r += step_r) {
+        const float* row = hm->data + (size_t)r * hm->cols;
+        float top = sy0 + r * ch, bottom = sy0 + (r + step_r) * ch;
+        if (top < cy0) top = cy0;
+        if (bottom > cy1) bottom = cy1;
+        if (bottom <= top) continue;
+
+        int run = c0;
+        SDL_Color color = heatmap_color(hm, row[c0]);
+        for (int c = c0 + step_c; ; c += step_c) {
+            bool end = c >= c1;
+            SDL_Color next = color;
+            if (!end) {
+                next = heatmap_color(hm, row[c]);
+                if (memcmp(&next, &color, sizeof(color)) == 0) continue;
+            }
+            float left = sx0 + run * cw, right = sx0 + (end ? c1 : c) * cw;
+            if (left < cx0) left = cx0;
+            if (right > cx1) right = cx1;
+            if (right > left) {
+                SDL_FRect cell = { left, top, right - left, bottom - top };
+                canvas_set_color(cv, color);
+                canvas_rect(cv, &cell, true);
+            }
+            if (end) break;
+            run = c;
+            color = next;
+        }
+    }
+}
+
+/**
+ * @brief Draws a heatmap series clipped to the axes: one textured quad on SDL 
+ * canvases, filled cell rects on SVG and raster ones.
+ */
+void render_heatmap(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi) {
+    Heatmap* hm = s->image;
+    if (!hm) return;
+
+    // --- STEP 1: Texture (created on first use, on the renderer that draws it) ---
+    if (cv->renderer && (!hm->texture || hm->texture_owner != cv->renderer)) {
+        if (hm->texture) SDL_DestroyTexture(hm->texture);
+        hm->texture = SDL_CreateTexture(cv->renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, hm->cols, hm->rows);
+        hm->texture_owner = cv->renderer;
+        if (!hm->texture) return;
+        SDL_SetTextureScaleMode(hm->texture, SDL_SCALEMODE_NEAREST); // Crisp cells
+        heatmap_mark_dirty(hm, 0, hm->rows);
+    }
+    if (cv->renderer && hm->dirty_hi > hm->dirty_lo) heatmap_upload(hm);
+
+    // --- STEP 2: Clip the image rect to the axes, trimming texture coordinates to match ---
+    float x_scale = ax->rect.w / (x_hi - x_lo);
+    float y_scale = ax->rect.h / (y_hi - y_lo);
+    float bottom = ax->rect.y + ax->rect.h;
+    // On scaled axes the image is stretched linearly between its mapped edges
+    float sx0 = ax->rect.x + (axes_tx(ax, hm->extent_x[0]) - x_lo) * x_scale;
+    float sx1 = ax->rect.x + (axes_tx(ax, hm->extent_x[1]) - x_lo) * x_scale;
+    float sy0 = bottom - (axes_ty(ax, hm->extent_y[1]) - y_lo) * y_scale; // Top edge (row 0)
+    float sy1 = bottom - (axes_ty(ax, hm->extent_y[0]) - y_lo) * y_scale;
+    if (!(sx1 > sx0) || !(sy1 > sy0)) return;
+
+    float cx0 = sx0 > ax->rect.x ? sx0 : ax->rect.x;
+    float cx1 = sx1 < ax->rect.x + ax->rect.w ? sx1 : ax->rect.x + ax->rect.w;
+    float cy0 = sy0 > ax->rect.y ? sy0 : ax->rect.y;
+    float cy1 = sy1 < bottom ? sy1 : bottom;
+    if (cx1 <= cx0 || cy1 <= cy0) return;
+    if (!cv->renderer) {
+        heatmap_render_cells(cv, hm, sx0, sx1, sy0, sy1, cx0, cx1, cy0, cy1);
+        return;
+    }
+
+    float u0 = (cx0 - sx0) / (sx1 - sx0), u1 = (cx1 - sx0) / (sx1 - sx0);
+    float v0 = (cy0 - sy0) / (sy1 - sy0), v1 = (cy1 - sy0) / (sy1 - sy0);
+    SDL_Vertex v[4] = {
+        { { cx0, cy0 }, { 1, 1, 1, 1 }, { u0, v0 } },
+        { { cx1, cy0 }, { 1, 1, 1, 1 }, { u1, v0 } },
+        { { cx1, cy1 }, { 1, 1, 1, 1 }, { u1, v1 } },
+        { { cx0, cy1 }, { 1, 1, 1, 1 }, { u0, v1 } }
+    };
+    static const int idx[6] = { 0, 1, 2, 0, 2, 3 };
+    canvas_image(cv, hm->texture, v, 4, idx, 6);
+}
+
+/**
+ * @brief Frees a heatmap and its texture (not the data). Called by destroy_figure() 
+ * before the renderer is destroyed.
+ */
+void heatmap_destroy(Heatmap* hm) {
+    if (!hm) return;
+    if (hm->texture) SDL_DestroyTexture(hm->texture);
+    free(hm);
+}
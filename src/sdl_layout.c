@@ -0,0 +1,461 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "sdl_layout.h"
+#include "sdl_ticks.h"
+#include "sdl_scale.h"
+#include "sdl_link.h"
+#include "sdl_context.h"
+#include "sdl_startup.h"
+
+// Spacing constants, in pixels. The TICK_* values mirror render_axes_2d.
+#define FIGURE_PAD 8.0f       // Between the outermost decorations and the window edge
+#define DECOR_PAD 6.0f        // Around each axes' decorations
+#define LABEL_GAP 8.0f        // Between tick labels and an axis label
+#define TICK_MARK 5.0f        // Tick length
+#define TICK_LABEL_X 10.0f    // Y tick labels end this far left of the axes
+#define TICK_LABEL_Y 15.0f    // X tick labels are centered this far below the axes
+#define MIN_CELL 20.0f        // Smallest plot area when the window is too small
+
+/**
+ * @brief Allocates a layout with the default grid (1 column, or 2 for several axes).
+ * * @param axes_count Number of Axes in the Figure.
+ * @return The new layout, or NULL if allocation fails.
+ */
+struct FigureLayout* layout_create(int axes_count) {
+    struct FigureLayout* L = calloc(1, sizeof(*L));
+    if (!L) return NULL;
+    L->slots = calloc(axes_count > 0 ? axes_count : 1, sizeof(GridSlot));
+    L->margins = calloc(axes_count > 0 ? axes_count : 1, sizeof(AxesMargins));
+    if (!L->slots || !L->margins) {
+        layout_destroy(L);
+        return NULL;
+    }
+    L->count = axes_count;
+    for (int i = 0; i < LAYOUT_MAX_TRACKS; i++) {
+        L->width_ratios[i] = 1.0f;
+        L->height_ratios[i] = 1.0f;
+    }
+
+    int cols = (axes_count > 1) ? 2 : 1;
+    L->cols = cols;
+    L->rows = (axes_count + cols - 1) / cols;
+    if (L->rows < 1) L->rows = 1;
+    for (int i = 0; i < axes_count; i++) {
+        L->slots[i] = (GridSlot){ i / cols, i % cols, 1, 1 };
+    }
+    L->dirty = true;
+    return L;
+}
+
+/**
+ * @brief Frees a layout created by layout_create().
+ */
+void layout_destroy(struct FigureLayout* layout) {
+    if (!layout) return;
+    free(layout->slots);
+    free(layout->margins);
+    free(layout);
+}
+
+/**
+ * @brief Measures every printable ASCII glyph of a font.
+ * * Context fonts are measured once when opened (see context_font_metrics()).
+ */
+void layout_measure_font(FontMetrics* fm, TTF_Font* font) {
+    fm->font = font;
+    fm->height = font ? (float)TTF_GetFontHeight(font) : 16.0f;
+    for (int c = 0; c < 128; c++) {
+        int w = 0, h = 0;
+        char s[2] = { (char)c, '\0' };
+        if (c >= 32 && c < 127 && font && TTF_GetStringSize(font, s, 1, &w, &h)) {
+            fm->advance[c] = (float)w;
+        } else {
+            fm->advance[c] = fm->height * 0.5f;
+        }
+    }
+}
+
+/**
+ * @brief Estimates the rendered width of a string from cached glyph advances.
+ * * Ignores kerning, which is well within the layout's padding. Non-ASCII bytes 
+ * count as half a line height each.
+ */
+float layout_text_width(const FontMetrics* fm, const char* text) {
+    if (!text) return 0.0f;
+    float w = 0.0f;
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        w += (*p < 128) ? fm->advance[*p] : fm->height * 0.5f;
+    }
+    return w;
+}
+
+// Widest label the tick locator would produce for a view (without creating textures)
+static float widest_tick_label(const FontMetrics* fm, AxisScale scale, float linthresh, float lo, float hi, float extent, float spacing) {
+    TickCache tc;
+    ticks_init(&tc);
+    scale_update_ticks(&tc, scale, linthresh, lo, hi, extent, spacing);
+    float widest = 0.0f;
+    for (int i = 0; i < tc.count; i++) {
+        float w = layout_text_width(fm, tc.labels[i]);
+        if (w > widest) widest = w;
+    }
+    return widest;
+}
+
+/**
+ * @brief Computes the space an Axes needs for its tick labels, axis labels and title.
+ * * Mirrors where render_axes_2d() places each decoration, using the font's cached 
+ * metrics. Results are cached per Axes and only recomputed when the limits, labels, 
+ * projection or the plot area the ticks were estimated for change.
+ * * @return true if the margins differ from the previous measurement.
+ */
+static bool measure_axes(struct FigureLayout* L, Axes* ax, int i) {
+    AxesMargins* m = &L->margins[i];
+    const GridSlot* s = &L->slots[i];
+    bool hide_x = L->share_x && s->row + s->row_span < L->rows;
+    bool hide_y = L->share_y && s->col > 0;
+
+    float extent_w = ax->rect.w > 0 ? ax->rect.w : (float)L->width / L->cols;
+    float extent_h = ax->rect.h > 0 ? ax->rect.h : (float)L->height / L->rows;
+    if (m->valid && m->key_limits[0] == ax->x_min && m->key_limits[1] == ax->x_max &&
+        m->key_limits[2] == ax->y_min && m->key_limits[3] == ax->y_max &&
+        m->key_extent[0] == extent_w && m->key_extent[1] == extent_h &&
+        m->key_title == ax->title && m->key_xlabel == ax->x_label && m->key_ylabel == ax->y_label &&
+        m->key_projection == ax->projection && m->key_format == ax->x_format &&
+        m->key_hide_x == hide_x && m->key_hide_y == hide_y &&
+        m->key_scale[0] == ax->xscale && m->key_scale[1] == ax->yscale) {
+        return false;
+    }
+    AxesMargins old = *m;
+
+    m->valid = true;
+    m->key_limits[0] = ax->x_min;  m->key_limits[1] = ax->x_max;
+    m->key_limits[2] = ax->y_min;  m->key_limits[3] = ax->y_max;
+    m->key_extent[0] = extent_w;   m->key_extent[1] = extent_h;
+    m->key_title = ax->title;  m->key_xlabel = ax->x_label;  m->key_ylabel = ax->y_label;
+    m->key_projection = ax->projection;
+    m->key_format = ax->x_format;
+    m->key_hide_x = hide_x;  m->key_hide_y = hide_y;
+    m->key_scale[0] = ax->xscale;  m->key_scale[1] = ax->yscale;
+
+    const FontMetrics* fm = &L->metrics;
+    float lh = fm->height;
+    m->hide_x = hide_x;
+    m->hide_y = hide_y;
+    m->title_offset = m->xlabel_offset = m->ylabel_offset = 0.0f;
+
+    if (ax->projection == PROJECTION_3D) {
+        // The cube is inset within the rect; its labels need about a line around it
+        m->left = m->right = m->top = m->bottom = lh;
+    } else {
+        // --- Tick labels (estimated with the same locator the renderer uses) ---
+        float y_ticks_w = 0.0f, x_tick_w = 0.0f;
+        if (ax->x_min <= ax->x_max) {
+            float x_lo, x_hi, y_lo, y_hi;
+            axes_view_2d(ax, &x_lo, &x_hi, &y_lo, &y_hi);
+            y_ticks_w = widest_tick_label(fm, ax->yscale, ax->y_linthresh, y_lo, y_hi, extent_h, lh * 2.5f);
+            x_tick_w = (ax->x_format == TICKS_TIME) ? layout_text_width(fm, "00:00:00.000")
+                                                    : widest_tick_label(fm, ax->xscale, ax->x_linthresh, x_lo, x_hi, extent_w, 60.0f);
+        }
+
+        // --- Left: tick labels, then the (horizontal) y label ---
+        if (hide_y) {
+            m->left = TICK_MARK + DECOR_PAD;
+        } else {
+            m->left = TICK_LABEL_X + y_ticks_w + DECOR_PAD;
+            if (ax->y_label) {
+                float w = layout_text_width(fm, ax->y_label);
+                m->ylabel_offset = TICK_LABEL_X + y_ticks_w + LABEL_GAP + w / 2.0f;
+                m->left += LABEL_GAP + w;
+            }
+        }
+
+        // --- Bottom: tick labels, then the x label ---
+        if (hide_x) {
+            m->bottom = TICK_MARK + DECOR_PAD;
+        } else {
+            m->bottom = TICK_LABEL_Y + lh / 2.0f + DECOR_PAD;
+            m->xlabel_offset = TICK_LABEL_Y + lh + LABEL_GAP / 2.0f;
+            if (ax->x_label) m->bottom += LABEL_GAP / 2.0f + lh;
+        }
+
+        // --- Top: title. Right: half of the last x tick label can overhang ---
+        m->title_offset = DECOR_PAD + lh / 2.0f;
+        m->top = ax->title ? DECOR_PAD * 2.0f + lh : DECOR_PAD;
+        m->right = (hide_x ? 0.0f : x_tick_w / 2.0f) + DECOR_PAD;
+    }
+
+    return old.left != m->left || old.right != m->right || old.top != m->top ||
+           old.bottom != m->bottom || old.title_offset != m->title_offset ||
+           old.xlabel_offset != m->xlabel_offset || old.ylabel_offset != m->ylabel_offset ||
+           old.hide_x != m->hide_x || old.hide_y != m->hide_y;
+}
+
+// Splits 'available' pixels between 'n' tracks by ratio
+static void split_tracks(float* out, const float* ratios, int n, float available) {
+    float total = 0.0f;
+    for (int i = 0; i < n; i++) total += ratios[i] > 0 ? ratios[i] : 1.0f;
+    if (available < n * MIN_CELL) available = n * MIN_CELL;
+    for (int i = 0; i < n; i++) out[i] = available * (ratios[i] > 0 ? ratios[i] : 1.0f) / total;
+}
+
+/**
+ * @brief Places every Axes from the grid description and the measured margins.
+ * * Each column gets the largest left margin of the axes starting in it and the 
+ * largest right margin of the axes ending in it (likewise for rows), so 
+ * neighbouring decorations never overlap and no space is reserved for labels 
+ * that are not there. The remaining space is split between plot areas by the 
+ * width/height ratios; a spanning axes covers the gaps between its cells.
+ */
+static void solve(Figure* fig, struct FigureLayout* L) {
+    float lm[LAYOUT_MAX_TRACKS] = {0}, rm[LAYOUT_MAX_TRACKS] = {0};
+    float tm[LAYOUT_MAX_TRACKS] = {0}, bm[LAYOUT_MAX_TRACKS] = {0};
+    for (int i = 0; i < L->count; i++) {
+        const GridSlot* s = &L->slots[i];
+        const AxesMargins* m = &L->margins[i];
+        int c1 = s->col + s->col_span - 1, r1 = s->row + s->row_span - 1;
+        if (m->left > lm[s->col]) lm[s->col] = m->left;
+        if (m->right > rm[c1]) rm[c1] = m->right;
+        if (m->top > tm[s->row]) tm[s->row] = m->top;
+        if (m->bottom > bm[r1]) bm[r1] = m->bottom;
+    }
+
+    float used_w = 2.0f * FIGURE_PAD, used_h = 2.0f * FIGURE_PAD;
+    for (int c = 0; c < L->cols; c++) used_w += lm[c] + rm[c];
+    for (int r = 0; r < L->rows; r++) used_h += tm[r] + bm[r];
+
+    float col_w[LAYOUT_MAX_TRACKS], row_h[LAYOUT_MAX_TRACKS];
+    float col_x[LAYOUT_MAX_TRACKS], row_y[LAYOUT_MAX_TRACKS];
+    split_tracks(col_w, L->width_ratios, L->cols, L->width - used_w);
+    split_tracks(row_h, L->height_ratios, L->rows, L->height - used_h);
+
+    float x = FIGURE_PAD;
+    for (int c = 0; c < L->cols; c++) {
+        col_x[c] = x + lm[c];
+        x = col_x[c] + col_w[c] + rm[c];
+    }
+    float y = FIGURE_PAD;
+    for (int r = 0; r < L->rows; r++) {
+        row_y[r] = y + tm[r];
+        y = row_y[r] + row_h[r] + bm[r];
+    }
+
+    for (int i = 0; i < L->count && i < fig->axes_count; i++) {
+        const GridSlot* s = &L->slots[i];
+        const AxesMargins* m = &L->margins[i];
+        Axes* ax = &fig->axes[i];
+        int c1 = s->col + s->col_span - 1, r1 = s->row + s->row_span - 1;
+        ax->rect.x = col_x[s->col];
+        ax->rect.y = row_y[s->row];
+        ax->rect.w = col_x[c1] + col_w[c1] - col_x[s->col];
+        ax->rect.h = row_y[r1] + row_h[r1] - row_y[s->row];
+        ax->title_offset = m->title_offset;
+        ax->xlabel_offset = m->xlabel_offset;
+        ax->ylabel_offset = m->ylabel_offset;
+        ax->hide_x_ticklabels = m->hide_x;
+        ax->hide_y_ticklabels = m->hide_y;
+    }
+    L->dirty = false;
+}
+
+// Shared rows/columns show one set of tick labels, so they become link groups
+static void link_shared_tracks(Figure* fig, struct FigureLayout* L) {
+    for (int j = 0; j < L->count && j < fig->axes_count; j++) {
+        axes_unshare(&fig->axes[j], L->share_x, L->share_y);
+    }
+    for (int j = 1; j < L->count && j < fig->axes_count; j++) {
+        Axes* b = &fig->axes[j];
+        if (b->projection != PROJECTION_2D) continue;
+        bool x_done = !L->share_x, y_done = !L->share_y;
+        // Join the first earlier axes of the same column (row)
+        for (int i = 0; i < j && !(x_done && y_done); i++) {
+            Axes* a = &fig->axes[i];
+            if (a->projection != PROJECTION_2D) continue;
+            if (!x_done && L->slots[i].col == L->slots[j].col && L->slots[i].col_span == L->slots[j].col_span) {
+                axes_share_x(a, b);
+                x_done = true;
+            }
+            if (!y_done && L->slots[i].row == L->slots[j].row && L->slots[i].row_span == L->slots[j].row_span) {
+                axes_share_y(a, b);
+                y_done = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Records a new figure size. The grid is re-solved on the next layout_update().
+ * * Cheap enough to call for every resize event.
+ */
+void layout_resize(Figure* fig, int width, int height) {
+    if (!fig || !fig->layout) return;
+    if (fig->layout->width != width || fig->layout->height != height) {
+        fig->layout->width = width;
+        fig->layout->height = height;
+        fig->layout->dirty = true;
+    }
+}
+
+/**
+ * @brief Brings the Axes rects up to date with the figure's size and content.
+ * * Called at the start of every frame. Re-measures only axes whose limits or 
+ * labels changed, and re-solves the grid only if a margin, the grid or the figure 
+ * size actually changed, so a steady frame costs a few comparisons per axes.
+ * * @param fig Pointer to the Figure.
+ * @return true if any Axes moved or was resized.
+ */
+bool layout_update(Figure* fig) {
+    if (!fig || !fig->layout) return false;
+    struct FigureLayout* L = fig->layout;
+
+    if (links_sync(fig)) fig->dirty = true;
+    figure_ensure_font(fig); // Opened lazily (see figure_realize)
+    if (L->metrics.height <= 0 || L->metrics.font != fig->font) {
+        const FontMetrics* shared = context_font_metrics(fig->font);
+        if (shared) {
+            L->metrics = *shared;
+        } else {
+            layout_measure_font(&L->metrics, fig->font);
+        }
+        for (int i = 0; i < L->count; i++) L->margins[i].valid = false;
+        L->dirty = true;
+    }
+
+    bool changed = L->dirty;
+    for (int i = 0; i < L->count && i < fig->axes_count; i++) {
+        if (measure_axes(L, &fig->axes[i], i)) changed = true;
+    }
+    if (!changed) return false;
+
+    solve(fig, L);
+    // Tick extents depend on the rects: settle once more (margins rarely move twice)
+    bool again = false;
+    for (int i = 0; i < L->count && i < fig->axes_count; i++) {
+        if (measure_axes(L, &fig->axes[i], i)) again = true;
+    }
+    if (again) solve(fig, L);
+    fig->dirty = true;
+    return true;
+}
+
+/**
+ * @brief Creates a Figure with a rows x cols grid of Axes (like plt.subplots(rows, cols)).
+ * * Axes are numbered row by row. Use layout_set_span() and layout_set_ratios() 
+ * to build dashboards with unequal cells.
+ * * @param title  Window title (and default title of every Axes).
+ * @param width  Window width in pixels.
+ * @param height Window height in pixels.
+ * @param rows   Number of grid rows.
+ * @param cols   Number of grid columns.
+ * @return The new Figure, or NULL on failure.
+ */
+Figure* subplots_grid(const char* title, int width, int height, int rows, int cols) {
+    if (rows < 1 || cols < 1 || rows > LAYOUT_MAX_TRACKS || cols > LAYOUT_MAX_TRACKS) {
+        fprintf(stderr, "subplots_grid: invalid grid %dx%d\n", rows, cols);
+        return NULL;
+    }
+    Figure* fig = subplots(title, width, height, rows * cols);
+    if (fig) layout_set_grid(fig, rows, cols);
+    return fig;
+}
+
+/**
+ * @brief Changes the grid and places the Axes in it row by row, one cell each.
+ * * Like every layout_set_* call, this only records the change: the rects are solved 
+ * on the next frame or export, so configuring a figure never opens the font. Call 
+ * update_layout() to solve right away.
+ * * @param fig  Pointer to the Figure.
+ * @param rows Number of grid rows.
+ * @param cols Number of grid columns.
+ * @return false if the grid is invalid or has fewer cells than the figure has Axes.
+ */
+bool layout_set_grid(Figure* fig, int rows, int cols) {
+    if (!fig || !fig->layout) return false;
+    if (rows < 1 || cols < 1 || rows > LAYOUT_MAX_TRACKS || cols > LAYOUT_MAX_TRACKS ||
+        rows * cols < fig->axes_count) {
+        fprintf(stderr, "layout_set_grid: a %dx%d grid cannot hold %d axes\n", rows, cols, fig->axes_count);
+        return false;
+    }
+    struct FigureLayout* L = fig->layout;
+    L->rows = rows;
+    L->cols = cols;
+    for (int i = 0; i < L->count; i++) {
+        L->slots[i] = (GridSlot){ i / cols, i % cols, 1, 1 };
+        L->margins[i].valid = false;
+    }
+    if (L->share_x || L->share_y) link_shared_tracks(fig, L);
+    L->dirty = true;
+    fig->dirty = true; // Solved on the next frame or export, like layout_resize()
+    return true;
+}
+
+/**
+ * @brief Moves an Axes to a (possibly multi-cell) region of the grid.
+ * * Overlapping regions are allowed; the Axes drawn last ends up on top.
+ * * @param fig        Pointer to the Figure.
+ * @param axes_index Index of the Axes to move.
+ * @param row        Top row of the region.
+ * @param col        Left column of the region.
+ * @param row_span   Number of rows covered (>= 1).
+ * @param col_span   Number of columns covered (>= 1).
+ * @return false if the region does not fit in the grid.
+ */
+bool layout_set_span(Figure* fig, int axes_index, int row, int col, int row_span, int col_span) {
+    if (!fig || !fig->layout || axes_index < 0 || axes_index >= fig->layout->count) return false;
+    struct FigureLayout* L = fig->layout;
+    if (row < 0 || col < 0 || row_span < 1 || col_span < 1 ||
+        row + row_span > L->rows || col + col_span > L->cols) {
+        fprintf(stderr, "layout_set_span: region (%d,%d) %dx%d is outside the %dx%d grid\n",
+                row, col, row_span, col_span, L->rows, L->cols);
+        return false;
+    }
+    L->slots[axes_index] = (GridSlot){ row, col, row_span, col_span };
+    L->margins[axes_index].valid = false;
+    if (L->share_x || L->share_y) link_shared_tracks(fig, L);
+    L->dirty = true;
+    fig->dirty = true; // Solved on the next frame or export, like layout_resize()
+    return true;
+}
+
+/**
+ * @brief Sets relative column widths and row heights (like Matplotlib's width_ratios).
+ * * @param fig           Pointer to the Figure.
+ * @param width_ratios  One value per column, or NULL to make all columns equal.
+ * @param height_ratios One value per row, or NULL to make all rows equal.
+ */
+void layout_set_ratios(Figure* fig, const float* width_ratios, const float* height_ratios) {
+    if (!fig || !fig->layout) return;
+    struct FigureLayout* L = fig->layout;
+    for (int c = 0; c < L->cols; c++) L->width_ratios[c] = width_ratios ? width_ratios[c] : 1.0f;
+    for (int r = 0; r < L->rows; r++) L->height_ratios[r] = height_ratios ? height_ratios[r] : 1.0f;
+    L->dirty = true;
+    fig->dirty = true; // Solved on the next frame or export, like layout_resize()
+}
+
+/**
+ * @brief Shares x limits down each column and/or y limits along each row.
+ * * Each column (row) becomes a link group, as if its axes were joined with 
+ * axes_share_x() (axes_share_y()): limits fit the group's data and changes to one 
+ * member reach all of them. Only the bottom axes of a column (leftmost of a row) 
+ * draws tick labels and the axis label. The space this frees goes to the plots.
+ * * Turning sharing off, or changing the grid, replaces the axis' existing groups.
+ * * @param fig     Pointer to the Figure.
+ * @param share_x Share x between axes in the same column.
+ * @param share_y Share y between axes in the same row.
+ */
+void layout_set_shared(Figure* fig, bool share_x, bool share_y) {
+    if (!fig || !fig->layout) return;
+    struct FigureLayout* L = fig->layout;
+    // Dissolve groups being turned off, then rebuild the enabled ones
+    for (int i = 0; i < L->count && i < fig->axes_count; i++) {
+        axes_unshare(&fig->axes[i], L->share_x && !share_x, L->share_y && !share_y);
+    }
+    L->share_x = share_x;
+    L->share_y = share_y;
+    if (share_x || share_y) link_shared_tracks(fig, L);
+    fig->layout->dirty = true;
+    fig->dirty = true; // Solved on the next frame or export, like layout_resize()
+}
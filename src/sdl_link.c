@@ -0,0 +1,239 @@
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sdl_link.h"
+
+static AxesLink** link_slot(Axes* ax, bool y_axis) {
+    return y_axis ? &ax->y_link : &ax->x_link;
+}
+
+static float* lim_lo(Axes* ax, bool y_axis) { return y_axis ? &ax->y_min : &ax->x_min; }
+static float* lim_hi(Axes* ax, bool y_axis) { return y_axis ? &ax->y_max : &ax->x_max; }
+
+static bool link_add(AxesLink* link, Axes* ax) {
+    if (link->count == link->capacity) {
+        int cap = link->capacity ? link->capacity * 2 : 4;
+        Axes** m = realloc(link->members, sizeof(Axes*) * (size_t)cap);
+        if (!m) return false;
+        link->members = m;
+        link->capacity = cap;
+    }
+    link->members[link->count++] = ax;
+    *link_slot(ax, link->y_axis) = link;
+    return true;
+}
+
+static AxesLink* link_create(Axes* ax, bool y_axis) {
+    AxesLink* link = calloc(1, sizeof(AxesLink));
+    if (!link) return NULL;
+    link->y_axis = y_axis;
+    link->lo = 1e38f;
+    link->hi = -1e38f;
+    ticks_init(&link->ticks);
+    if (!link_add(link, ax)) {
+        free(link);
+        return NULL;
+    }
+    return link;
+}
+
+static void link_free(AxesLink* link) {
+    ticks_invalidate(&link->ticks); // Label textures
+    free(link->members);
+    free(link);
+}
+
+/**
+ * @brief Copies limits to every member of a link.
+ * * Only members whose limits actually differ are touched; their tick caches and 
+ * margins then refresh on the next frame through their usual view keys, while 
+ * axes outside the group keep everything they cached.
+ */
+void link_propagate(AxesLink* link, float lo, float hi) {
+    if (!link) return;
+    link->lo = lo;
+    link->hi = hi;
+    for (int i = 0; i < link->count; i++) {
+        Axes* m = link->members[i];
+        float* mlo = lim_lo(m, link->y_axis);
+        float* mhi = lim_hi(m, link->y_axis);
+        if (*mlo == lo && *mhi == hi) continue;
+        *mlo = lo;
+        *mhi = hi;
+    }
+}
+
+// Joins the groups of two axes (creating them as needed) and refits the limits
+static void axes_share(Axes* ax, Axes* other, bool y_axis) {
+    if (!ax || !other || ax == other) return;
+    if (ax->projection != PROJECTION_2D || other->projection != PROJECTION_2D || ax->arena != other->arena) {
+        fprintf(stderr, "Only 2D axes of the same figure can share limits\n");
+        return;
+    }
+    AxesLink** a = link_slot(ax, y_axis);
+    AxesLink** b = link_slot(other, y_axis);
+    if (*a && *a == *b) return;
+    bool a_new = !*a, b_new = !*b;
+
+    if (!*a && !(*a = link_create(ax, y_axis))) return;
+    AxesLink* link = *a;
+    if (*b) {
+        AxesLink* old = *b;
+        for (int i = 0; i < old->count; i++) link_add(link, old->members[i]);
+        link_free(old);
+    } else {
+        link_add(link, other);
+    }
+
+    // Members of existing groups keep their data bounds current; axes joining 
+    // their first group measure theirs now. The last refit sees all of them.
+    if (a_new) axes_autoscale(ax);
+    if (b_new || !a_new) axes_autoscale(other);
+}
+
+/**
+ * @brief Links the x limits of two axes (Matplotlib's ax.sharex).
+ * * The axes join one group, together with anything either was already linked 
+ * to. From then on, any change to one member's x limits (set_xlim(), autoscaling, 
+ * new data) is copied to every member once, and autoscaling fits the data of 
+ * the whole group. Members whose plot areas are equally wide also share one set 
+ * of x ticks and label textures.
+ * * @param ax    Pointer to a 2D Axes.
+ * @param other Pointer to another 2D Axes of the same Figure.
+ * * @note Members should use the same x scale; set_xscale() applies it to the 
+ * whole group.
+ */
+void axes_share_x(Axes* ax, Axes* other) {
+    axes_share(ax, other, false);
+}
+
+/**
+ * @brief Links the y limits of two axes (Matplotlib's ax.sharey).
+ * * @see axes_share_x()
+ */
+void axes_share_y(Axes* ax, Axes* other) {
+    axes_share(ax, other, true);
+}
+
+static void axes_leave(Axes* ax, bool y_axis) {
+    AxesLink** slot = link_slot(ax, y_axis);
+    AxesLink* link = *slot;
+    if (!link) return;
+    *slot = NULL;
+    for (int i = 0; i < link->count; i++) {
+        if (link->members[i] != ax) continue;
+        for (int j = i + 1; j < link->count; j++) link->members[j - 1] = link->members[j];
+        link->count--;
+        break;
+    }
+    if (link->count <= 1) {
+        if (link->count == 1) *link_slot(link->members[0], y_axis) = NULL;
+        link_free(link);
+    } else {
+        ticks_invalidate(&link->ticks); // The leader may have changed
+    }
+}
+
+/**
+ * @brief Removes an Axes from its x and/or y groups. Its current limits are kept.
+ * * @param ax     Pointer to the Axes.
+ * @param x_axis Leave the x group.
+ * @param y_axis Leave the y group.
+ */
+void axes_unshare(Axes* ax, bool x_axis, bool y_axis) {
+    if (!ax) return;
+    if (x_axis) axes_leave(ax, false);
+    if (y_axis) axes_leave(ax, true);
+}
+
+/**
+ * @brief Sets the x limits of an Axes (Matplotlib's ax.set_xlim), e.g. to pan or zoom.
+ * * Linked axes (see axes_share_x()) follow in the same call.
+ * * @note The limits hold until the next autoscale (new data, a stream batch or 
+ * a scale change).
+ */
+void set_xlim(Axes* ax, float lo, float hi) {
+    if (!ax) return;
+    ax->x_min = lo;
+    ax->x_max = hi;
+    link_propagate(ax->x_link, lo, hi);
+}
+
+/**
+ * @brief Sets the y limits of an Axes (Matplotlib's ax.set_ylim).
+ * * @see set_xlim()
+ */
+void set_ylim(Axes* ax, float lo, float hi) {
+    if (!ax) return;
+    ax->y_min = lo;
+    ax->y_max = hi;
+    link_propagate(ax->y_link, lo, hi);
+}
+
+// Picks up limits written directly to a member since the last frame
+static bool link_sync(AxesLink* link) {
+    float lo = 1e38f, hi = -1e38f;
+    bool moved = false;
+    for (int i = 0; i < link->count; i++) {
+        Axes* m = link->members[i];
+        float mlo = *lim_lo(m, link->y_axis), mhi = *lim_hi(m, link->y_axis);
+        if (mlo == link->lo && mhi == link->hi) continue;
+        moved = true;
+        if (mlo > mhi) continue; // Empty
+        if (mlo < lo) lo = mlo;
+        if (mhi > hi) hi = mhi;
+    }
+    if (!moved) return false;
+    if (lo > hi) { // Only empty members moved: restore the group's limits
+        lo = link->lo;
+        hi = link->hi;
+    }
+    link_propagate(link, lo, hi);
+    return true;
+}
+
+/**
+ * @brief Reconciles every link group of a Figure, called once per frame by layout_update().
+ * * Members whose limits were edited directly (rather than through set_xlim() or 
+ * autoscaling, which propagate immediately) are merged with the group: if several 
+ * members moved, the group takes the union of their new limits. A steady frame 
+ * costs two comparisons per linked axes.
+ * * @return true if any member's limits changed.
+ */
+bool links_sync(Figure* fig) {
+    if (!fig) return false;
+    bool changed = false;
+    for (int i = 0; i < fig->axes_count; i++) {
+        Axes* ax = &fig->axes[i];
+        // Each group is handled by its leader only
+        if (ax->x_link && ax->x_link->members[0] == ax && link_sync(ax->x_link)) changed = true;
+        if (ax->y_link && ax->y_link->members[0] == ax && link_sync(ax->y_link)) changed = true;
+    }
+    return changed;
+}
+
+/**
+ * @brief Returns the TickCache an axis should use: the group's shared one when the 
+ * Axes matches its leader's extent and tick format, otherwise its own.
+ */
+TickCache* axes_tick_cache(Axes* ax, bool y_axis) {
+    TickCache* own = y_axis ? &ax->y_ticks : &ax->x_ticks;
+    AxesLink* link = *link_slot(ax, y_axis);
+    if (!link) return own;
+    Axes* lead = link->members[0];
+    if (lead == ax) return &link->ticks;
+    if (y_axis) {
+        return fabsf(ax->rect.h - lead->rect.h) < 0.5f ? &link->ticks : own;
+    }
+    bool same = fabsf(ax->rect.w - lead->rect.w) < 0.5f && ax->x_format == lead->x_format &&
+                ax->x_time_origin == lead->x_time_origin;
+    return same ? &link->ticks : own;
+}
+
+// Drops an axis' own ticks and those of its group (e.g. after a format or scale change)
+void axes_invalidate_ticks(Axes* ax, bool y_axis) {
+    ticks_invalidate(y_axis ? &ax->y_ticks : &ax->x_ticks);
+    AxesLink* link = *link_slot(ax, y_axis);
+    if (link) ticks_invalidate(&link->ticks);
+}
@@ -0,0 +1,294 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sdl_pick.h"
+#include "sdl_canvas.h"
+#include "sdl_scale.h"
+
+// Default hover radius in pixels
+#define HOVER_RADIUS_PX 12.0f
+
+static bool grow_int(int** buf, int needed) {
+    int* p = realloc(*buf, sizeof(int) * (size_t)needed);
+    if (!p) return false;
+    *buf = p;
+    return true;
+}
+
+static bool grow_float(float** buf, int needed) {
+    float* p = realloc(*buf, sizeof(float) * (size_t)needed);
+    if (!p) return false;
+    *buf = p;
+    return true;
+}
+
+/**
+ * @brief Rebuilds the grid for a series if its data or the view changed.
+ * * A counting sort over grid cells: one pass maps every point to the screen and 
+ * counts points per cell, a prefix sum turns counts into offsets, and a second 
+ * pass scatters indices and screen positions so each cell is contiguous. 
+ * Off-screen and non-finite points are left out. O(n), no per-point allocations.
+ */
+static bool pick_rebuild(PickIndex* pi, const Axes* ax, Series* s) {
+    float view[4];
+    axes_view_2d(ax, &view[0], &view[1], &view[2], &view[3]);
+
+    if (pi->valid && pi->key_x == s->x && pi->key_y == s->y && pi->key_count == s->count &&
+        pi->key_view[0] == view[0] && pi->key_view[1] == view[1] &&
+        pi->key_view[2] == view[2] && pi->key_view[3] == view[3] &&
+        pi->key_rect.x == ax->rect.x && pi->key_rect.y == ax->rect.y &&
+        pi->key_rect.w == ax->rect.w && pi->key_rect.h == ax->rect.h) {
+        return true;
+    }
+
+    int cols = (int)ceilf(ax->rect.w / PICK_CELL_PX);
+    int rows = (int)ceilf(ax->rect.h / PICK_CELL_PX);
+    if (cols < 1) cols = 1;
+    if (rows < 1) rows = 1;
+    int cells = cols * rows;
+
+    if (cells + 1 > pi->cell_capacity) {
+        if (!grow_int(&pi->cell_start, cells + 1)) return false;
+        pi->cell_capacity = cells + 1;
+    }
+    if (s->count > pi->point_capacity) {
+        if (!grow_int(&pi->entry_index, s->count) || !grow_int(&pi->scratch, s->count) ||
+            !grow_float(&pi->entry_x, s->count) || !grow_float(&pi->entry_y, s->count)) {
+            return false;
+        }
+        pi->point_capacity = s->count;
+    }
+
+    float sx = ax->rect.w / (view[1] - view[0]);
+    float sy = ax->rect.h / (view[3] - view[2]);
+    const float *xs, *ys;
+    series_scaled(ax, s, &xs, &ys); // View units on log/symlog axes
+    float bottom = ax->rect.y + ax->rect.h;
+
+    // Pass 1: cell of every point, and counts per cell
+    for (int c = 0; c <= cells; c++) pi->cell_start[c] = 0;
+    for (int i = 0; i < s->count; i++) {
+        float px = (xs[i] - view[0]) * sx;
+        float py = (ys[i] - view[2]) * sy;
+        int cell = -1;
+        if (px >= 0.0f && px < ax->rect.w && py >= 0.0f && py < ax->rect.h) { // Also rejects NaN
+            int cx = (int)(px / PICK_CELL_PX);
+            int cy = (int)((ax->rect.h - py) / PICK_CELL_PX);
+            if (cx >= cols) cx = cols - 1;
+            if (cy >= rows) cy = rows - 1;
+            cell = cy * cols + cx;
+            pi->cell_start[cell + 1]++;
+        }
+        pi->scratch[i] = cell;
+    }
+
+    // Prefix sum: cell_start[c] = first entry of cell c
+    for (int c = 0; c < cells; c++) pi->cell_start[c + 1] += pi->cell_start[c];
+
+    // Pass 2: scatter (cell_start[c] temporarily advances to the end of cell c)
+    for (int i = 0; i < s->count; i++) {
+        int cell = pi->scratch[i];
+        if (cell < 0) continue;
+        int e = pi->cell_start[cell]++;
+        pi->entry_index[e] = i;
+        pi->entry_x[e] = ax->rect.x + (xs[i] - view[0]) * sx;
+        pi->entry_y[e] = bottom - (ys[i] - view[2]) * sy;
+    }
+    for (int c = cells; c > 0; c--) pi->cell_start[c] = pi->cell_start[c - 1];
+    pi->cell_start[0] = 0;
+
+    pi->cols = cols;
+    pi->rows = rows;
+    pi->key_x = s->x;
+    pi->key_y = s->y;
+    pi->key_count = s->count;
+    for (int k = 0; k < 4; k++) pi->key_view[k] = view[k];
+    pi->key_rect = ax->rect;
+    pi->valid = true;
+    return true;
+}
+
+// Nearest indexed point within 'radius' of (mx, my); returns the entry or -1
+static int pick_query(const PickIndex* pi, const SDL_FRect* rect, float mx, float my, float radius, float* best_d2) {
+    int cx0 = (int)floorf((mx - radius - rect->x) / PICK_CELL_PX);
+    int cx1 = (int)floorf((mx + radius - rect->x) / PICK_CELL_PX);
+    int cy0 = (int)floorf((my - radius - rect->y) / PICK_CELL_PX);
+    int cy1 = (int)floorf((my + radius - rect->y) / PICK_CELL_PX);
+    if (cx0 < 0) cx0 = 0;
+    if (cy0 < 0) cy0 = 0;
+    if (cx1 >= pi->cols) cx1 = pi->cols - 1;
+    if (cy1 >= pi->rows) cy1 = pi->rows - 1;
+
+    int best = -1;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            int cell = cy * pi->cols + cx;
+            for (int e = pi->cell_start[cell]; e < pi->cell_start[cell + 1]; e++) {
+                float dx = pi->entry_x[e] - mx;
+                float dy = pi->entry_y[e] - my;
+                float d2 = dx * dx + dy * dy;
+                if (d2 < *best_d2) {
+                    *best_d2 = d2;
+                    best = e;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Forces the index to be rebuilt on the next query.
+ * * Needed when a series' arrays are modified in place (same pointers and count).
+ */
+void pick_invalidate(PickIndex* pi) {
+    if (pi) pi->valid = false;
+}
+
+/**
+ * @brief Frees a PickIndex and all of its buffers.
+ */
+void pick_destroy(PickIndex* pi) {
+    if (!pi) return;
+    free(pi->cell_start);
+    free(pi->entry_index);
+    free(pi->entry_x);
+    free(pi->entry_y);
+    free(pi->scratch);
+    free(pi);
+}
+
+/**
+ * @brief Finds the data point nearest to a window position.
+ * * Only 2D axes whose plot area contains the position are searched. Each series 
+ * keeps a uniform grid of its on-screen points that is built on first use and 
+ * rebuilt only when the data pointers, point count, view limits or layout change, 
+ * so repeated queries (e.g. on every mouse move) only scan the few grid cells 
+ * within @p radius - well under a millisecond even for million-point scatters.
+ * * @param fig     Pointer to the Figure.
+ * @param mouse_x Window x coordinate.
+ * @param mouse_y Window y coordinate.
+ * @param radius  Maximum distance in pixels.
+ * @param out     Receives the hit (axes_index is -1 if nothing was within range).
+ * @return true if a point was found.
+ * * @note If you modify series data in place, call figure_mark_dirty() so the 
+ * indexes are rebuilt.
+ */
+bool figure_pick(Figure* fig, float mouse_x, float mouse_y, float radius, PickResult* out) {
+    if (!fig || !out) return false;
+    out->axes_index = -1;
+
+    SDL_FPoint mouse = { mouse_x, mouse_y };
+    for (int a = 0; a < fig->axes_count; a++) {
+        Axes* ax = &fig->axes[a];
+        if (ax->projection != PROJECTION_2D || !SDL_PointInRectFloat(&mouse, &ax->rect)) continue;
+
+        float best_d2 = radius * radius;
+        for (int l = 0; l < ax->line_count; l++) {
+            Series* s = &ax->lines[l];
+            if (s->count <= 0 || s->spectro || s->image) continue; // Images have no points to pick
+            if (!s->pick) {
+                s->pick = calloc(1, sizeof(PickIndex));
+                if (!s->pick) continue;
+            }
+            if (!pick_rebuild(s->pick, ax, s)) continue;
+
+            int e = pick_query(s->pick, &ax->rect, mouse_x, mouse_y, radius, &best_d2);
+            if (e >= 0) {
+                int i = s->pick->entry_index[e];
+                out->axes_index = a;
+                out->series_index = l;
+                out->point_index = i;
+                out->x = s->x[i];
+                out->y = s->y[i];
+                out->screen_x = s->pick->entry_x[e];
+                out->screen_y = s->pick->entry_y[e];
+                out->distance = sqrtf(best_d2);
+            }
+        }
+        return out->axes_index >= 0;
+    }
+    return false;
+}
+
+/**
+ * @brief Enables or disables hover tooltips (enabled by default).
+ */
+void figure_set_hover(Figure* fig, bool enabled) {
+    if (!fig) return;
+    fig->hover_enabled = enabled;
+    if (!enabled && fig->hover.axes_index >= 0) {
+        fig->hover.axes_index = -1;
+        fig->dirty = true;
+    }
+}
+
+/**
+ * @brief Updates the hover target for a new cursor position.
+ * * @return true if the target changed (the figure is then marked dirty).
+ */
+bool figure_update_hover(Figure* fig, float mouse_x, float mouse_y) {
+    if (!fig || !fig->hover_enabled) return false;
+
+    PickResult hit;
+    figure_pick(fig, mouse_x, mouse_y, HOVER_RADIUS_PX, &hit);
+    bool changed = hit.axes_index != fig->hover.axes_index ||
+                   (hit.axes_index >= 0 && (hit.series_index != fig->hover.series_index ||
+                                            hit.point_index != fig->hover.point_index));
+    fig->hover = hit;
+    if (changed) fig->dirty = true;
+    return changed;
+}
+
+/**
+ * @brief Draws the hover highlight and a tooltip with the point's values.
+ * * The values are re-read from the series on every frame, so the tooltip follows
+ * live data. If the point no longer exists the tooltip disappears.
+ */
+void render_hover(Canvas* cv, Figure* fig) {
+    PickResult* h = &fig->hover;
+    if (!fig->hover_enabled || h->axes_index < 0 || h->axes_index >= fig->axes_count) return;
+    Axes* ax = &fig->axes[h->axes_index];
+    if (h->series_index >= ax->line_count) return;
+    Series* s = &ax->lines[h->series_index];
+    if (h->point_index >= s->count) return;
+
+    float x = s->x[h->point_index], y = s->y[h->point_index];
+    float lo_x, hi_x, lo_y, hi_y;
+    axes_view_2d(ax, &lo_x, &hi_x, &lo_y, &hi_y);
+    float px = ax->rect.x + (axes_tx(ax, x) - lo_x) / (hi_x - lo_x) * ax->rect.w;
+    float py = ax->rect.y + ax->rect.h - (axes_ty(ax, y) - lo_y) / (hi_y - lo_y) * ax->rect.h;
+
+    // --- STEP 1: Highlight the point ---
+    SDL_FRect ring = { px - 5.0f, py - 5.0f, 10.0f, 10.0f };
+    canvas_set_color(cv, (SDL_Color){0, 0, 0, 255});
+    canvas_rect(cv, &ring, false);
+
+    // --- STEP 2: Tooltip text ---
+    char xbuf[TICK_LABEL_LEN], text[96];
+    if (ax->x_format == TICKS_TIME) {
+        format_time_label(xbuf, sizeof(xbuf), ax->x_time_origin + x, 0.001);
+    } else {
+        snprintf(xbuf, sizeof(xbuf), "%.6g", x);
+    }
+    if (s->label[0]) {
+        snprintf(text, sizeof(text), "%s: %s, %.6g", s->label, xbuf, y);
+    } else {
+        snprintf(text, sizeof(text), "%s, %.6g", xbuf, y);
+    }
+
+    // --- STEP 3: Box, kept inside the window ---
+    int tw = 0, th = 0;
+    if (!cv->font || !TTF_GetStringSize(cv->font, text, 0, &tw, &th)) return;
+    SDL_FRect box = { px + 12.0f, py - th - 14.0f, tw + 12.0f, th + 6.0f };
+    if (box.x + box.w > cv->width) box.x = px - 12.0f - box.w;
+    if (box.y < 0) box.y = py + 12.0f;
+
+    canvas_set_color(cv, (SDL_Color){255, 255, 225, 235});
+    canvas_rect(cv, &box, true);
+    canvas_set_color(cv, s->color);
+    canvas_rect(cv, &box, false);
+    canvas_text(cv, text, box.x + box.w / 2.0f, box.y + box.h / 2.0f, false, (SDL_Color){0, 0, 0, 255});
+}
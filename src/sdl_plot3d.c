@@ -0,0 +1,364 @@
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <string.h>
+#include "sdl_plot3d.h"
+#include "sdl_canvas.h"
+#include "sdl_camera.h"
+
+// Depth keys cover view-space z in [-DEPTH_RANGE, DEPTH_RANGE]; the data cube 
+// spans at most +-sqrt(3)
+#define DEPTH_RANGE 2.0f
+
+/**
+ * @brief Folds an Axes' limits, camera angles, zoom and rect into a View3D.
+ * * Produces exactly the mapping of project_3d() in sdl_graphs.c: normalize to 
+ * [-1, 1], rotate by azimuth (phi) around Z then elevation (theta) around X, and 
+ * scale orthographically into the axes rect (shifted by the camera pan).
+ */
+void view3d_setup(const Axes* ax, View3D* v) {
+    float ranges[3] = { ax->x_max - ax->x_min, ax->y_max - ax->y_min, ax->z_max - ax->z_min };
+    float mins[3] = { ax->x_min, ax->y_min, ax->z_min };
+    float k[3], b[3]; // normalized = k * value + b
+    for (int i = 0; i < 3; i++) {
+        k[i] = (ranges[i] > 0) ? 2.0f / ranges[i] : 0.0f;
+        b[i] = (ranges[i] > 0) ? -2.0f * mins[i] / ranges[i] - 1.0f : 0.0f;
+    }
+
+    float rad_phi = ax->phi * (M_PI / 180.0f);
+    float rad_theta = ax->theta * (M_PI / 180.0f);
+    float cp = cosf(rad_phi), sp = sinf(rad_phi);
+    float ct = cosf(rad_theta), st = sinf(rad_theta);
+    float rot[3][3] = {
+        { cp,      -sp,      0.0f },
+        { sp * ct,  cp * ct, -st  },
+        { sp * st,  cp * st,  ct  }
+    };
+
+    v->scale = (ax->rect.w < ax->rect.h ? ax->rect.w : ax->rect.h) * 0.4f * ax->zoom;
+    float cx = ax->rect.x + ax->rect.w / 2.0f + ax->pan_x * v->scale;
+    float cy = ax->rect.y + ax->rect.h / 2.0f + ax->pan_y * v->scale;
+
+    float* rows[3] = { v->sx, v->sy, v->sz };
+    float gain[3] = { v->scale, -v->scale, 1.0f }; // Screen y grows downwards
+    float offset[3] = { cx, cy, 0.0f };
+    for (int r = 0; r < 3; r++) {
+        float c = 0.0f;
+        for (int i = 0; i < 3; i++) {
+            rows[r][i] = gain[r] * rot[r][i] * k[i];
+            c += rot[r][i] * b[i];
+        }
+        rows[r][3] = gain[r] * c + offset[r];
+    }
+}
+
+/**
+ * @brief Projects a whole series at once (screen positions and depths).
+ * * @param depth May be NULL when depth is not needed (e.g. line series).
+ */
+void view3d_project_bulk(const View3D* v, const float* x, const float* y, const float* z, int count, SDL_FPoint* out, float* depth) {
+    for (int i = 0; i < count; i++) {
+        out[i].x = v->sx[0] * x[i] + v->sx[1] * y[i] + v->sx[2] * z[i] + v->sx[3];
+        out[i].y = v->sy[0] * x[i] + v->sy[1] * y[i] + v->sy[2] * z[i] + v->sy[3];
+    }
+    if (depth) {
+        for (int i = 0; i < count; i++) {
+            depth[i] = v->sz[0] * x[i] + v->sz[1] * y[i] + v->sz[2] * z[i] + v->sz[3];
+        }
+    }
+}
+
+static inline Uint16 depth_key(float d) {
+    float t = (d + DEPTH_RANGE) / (2.0f * DEPTH_RANGE);
+    if (!(t > 0.0f)) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    return (Uint16)(t * 65535.0f);
+}
+
+/**
+ * @brief Sorts primitive indices far-to-near with a two-pass LSD radix sort.
+ * * O(n) with two sequential scatter passes over 16-bit depth keys; the result 
+ * ends up back in @p keys / @p idx.
+ */
+static void radix_sort_depth(Uint16* keys, Uint32* idx, Uint16* tmp_keys, Uint32* tmp_idx, int n) {
+    int counts[256];
+    for (int shift = 0; shift < 16; shift += 8) {
+        Uint16* src_k = (shift == 0) ? keys : tmp_keys;
+        Uint32* src_i = (shift == 0) ? idx : tmp_idx;
+        Uint16* dst_k = (shift == 0) ? tmp_keys : keys;
+        Uint32* dst_i = (shift == 0) ? tmp_idx : idx;
+
+        memset(counts, 0, sizeof(counts));
+        for (int i = 0; i < n; i++) counts[(src_k[i] >> shift) & 0xFF]++;
+        int sum = 0;
+        for (int b = 0; b < 256; b++) {
+            int c = counts[b];
+            counts[b] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; i++) {
+            int pos = counts[(src_k[i] >> shift) & 0xFF]++;
+            dst_k[pos] = src_k[i];
+            dst_i[pos] = src_i[i];
+        }
+    }
+}
+
+typedef struct {
+    Uint16* keys;
+    Uint32* idx;
+    Uint16* tmp_keys;
+    Uint32* tmp_idx;
+} DepthOrder;
+
+static bool depth_order_alloc(FrameArena* arena, DepthOrder* o, int n) {
+    o->keys = arena_alloc_array(arena, Uint16, n);
+    o->idx = arena_alloc_array(arena, Uint32, n);
+    o->tmp_keys = arena_alloc_array(arena, Uint16, n);
+    o->tmp_idx = arena_alloc_array(arena, Uint32, n);
+    return o->keys && o->idx && o->tmp_keys && o->tmp_idx;
+}
+
+static inline SDL_FColor to_fcolor(SDL_Color c, float shade) {
+    return (SDL_FColor){ c.r / 255.0f * shade, c.g / 255.0f * shade, c.b / 255.0f * shade, c.a / 255.0f };
+}
+
+static inline SDL_Color point_color(const Axes* ax, const Series* s, const SDL_Color* lut, float z) {
+    if (!lut) return s->color;
+    float range = ax->z_max - ax->z_min;
+    return colormap_lookup(lut, range > 0 ? (z - ax->z_min) / range : 0.5f);
+}
+
+// Square markers, far to near, submitted in PLOT3D_BATCH_PRIMS-sized geometry batches
+static void render_scatter_3d(Canvas* cv, Axes* ax, Series* s, const View3D* v) {
+    int n = s->count;
+    SDL_FPoint* pts = arena_alloc_array(cv->arena, SDL_FPoint, n);
+    float* depth = arena_alloc_array(cv->arena, float, n);
+    DepthOrder o;
+    if (!pts || !depth || !depth_order_alloc(cv->arena, &o, n)) return;
+    view3d_project_bulk(v, s->x, s->y, s->z, n, pts, depth);
+
+    // --- STEP 1: Cull points outside the axes rect (also drops NaN) ---
+    float size = s->marker_size > 0 ? s->marker_size : 3.0f;
+    float half = size / 2.0f;
+    float x0 = ax->rect.x - half, x1 = ax->rect.x + ax->rect.w + half;
+    float y0 = ax->rect.y - half, y1 = ax->rect.y + ax->rect.h + half;
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        if (pts[i].x >= x0 && pts[i].x <= x1 && pts[i].y >= y0 && pts[i].y <= y1) {
+            o.keys[m] = depth_key(depth[i]);
+            o.idx[m] = (Uint32)i;
+            m++;
+        }
+    }
+
+    // --- STEP 2: Far to near ---
+    radix_sort_depth(o.keys, o.idx, o.tmp_keys, o.tmp_idx, m);
+
+    // --- STEP 3: Expand into quads and submit ---
+    int batch = m < PLOT3D_BATCH_PRIMS ? m : PLOT3D_BATCH_PRIMS;
+    SDL_Vertex* verts = arena_alloc_array(cv->arena, SDL_Vertex, batch * 4);
+    int* indices = arena_alloc_array(cv->arena, int, batch * 6);
+    if (!verts || !indices) return;
+    const SDL_Color* lut = colormap_lut(s->colormap);
+
+    for (int start = 0; start < m; start += batch) {
+        int count = (m - start < batch) ? m - start : batch;
+        for (int k = 0; k < count; k++) {
+            int i = (int)o.idx[start + k];
+            SDL_FColor fc = to_fcolor(point_color(ax, s, lut, s->z[i]), 1.0f);
+            SDL_Vertex* q = &verts[k * 4];
+            q[0].position = (SDL_FPoint){ pts[i].x - half, pts[i].y - half };
+            q[1].position = (SDL_FPoint){ pts[i].x + half, pts[i].y - half };
+            q[2].position = (SDL_FPoint){ pts[i].x + half, pts[i].y + half };
+            q[3].position = (SDL_FPoint){ pts[i].x - half, pts[i].y + half };
+            for (int c = 0; c < 4; c++) {
+                q[c].color = fc;
+                q[c].tex_coord = (SDL_FPoint){ 0, 0 };
+            }
+            int* idx = &indices[k * 6];
+            idx[0] = k * 4; idx[1] = k * 4 + 1; idx[2] = k * 4 + 2;
+            idx[3] = k * 4; idx[4] = k * 4 + 2; idx[5] = k * 4 + 3;
+        }
+        canvas_geometry(cv, verts, count * 4, indices, count * 6);
+    }
+}
+
+/**
+ * @brief Draws a gridded surface as depth-sorted, shaded quads.
+ * * Vertices are projected once; each grid cell is culled if it is degenerate, 
+ * off-screen, contains NaN, or (with cull_backfaces) faces away from the viewer. 
+ * Remaining cells are radix-sorted far-to-near and emitted in geometry batches, 
+ * colored per vertex from the colormap and darkened by how obliquely they face 
+ * the camera so the shape reads without a wireframe.
+ */
+static void render_surface_3d(Canvas* cv, Axes* ax, Series* s, const View3D* v) {
+    int rows = s->grid_rows, cols = s->grid_cols;
+    if (rows < 2 || cols < 2 || rows * cols > s->count) return;
+    int n = rows * cols;
+    int quads = (rows - 1) * (cols - 1);
+
+    SDL_FPoint* pts = arena_alloc_array(cv->arena, SDL_FPoint, n);
+    float* depth = arena_alloc_array(cv->arena, float, n);
+    float* shade = arena_alloc_array(cv->arena, float, quads);
+    DepthOrder o;
+    if (!pts || !depth || !shade || !depth_order_alloc(cv->arena, &o, quads)) return;
+    view3d_project_bulk(v, s->x, s->y, s->z, n, pts, depth);
+
+    // --- STEP 1: Cull and key every cell ---
+    int m = 0;
+    for (int r = 0; r < rows - 1; r++) {
+        for (int c = 0; c < cols - 1; c++) {
+            int i0 = r * cols + c, i1 = i0 + 1, i2 = i0 + cols + 1, i3 = i0 + cols;
+            SDL_FPoint a = pts[i0], b = pts[i1], p2 = pts[i2], d = pts[i3];
+
+            float minx = fminf(fminf(a.x, b.x), fminf(p2.x, d.x));
+            float maxx = fmaxf(fmaxf(a.x, b.x), fmaxf(p2.x, d.x));
+            float miny = fminf(fminf(a.y, b.y), fminf(p2.y, d.y));
+            float maxy = fmaxf(fmaxf(a.y, b.y), fmaxf(p2.y, d.y));
+            if (!(maxx >= ax->rect.x && minx <= ax->rect.x + ax->rect.w &&
+                  maxy >= ax->rect.y && miny <= ax->rect.y + ax->rect.h)) continue; // Off-screen
+
+            // Twice the signed screen area (y down: front faces are negative)
+            float area = (a.x * b.y - b.x * a.y) + (b.x * p2.y - p2.x * b.y) +
+                         (p2.x * d.y - d.x * p2.y) + (d.x * a.y - a.x * d.y);
+            // fminf/fmaxf skip NaN operands, but any NaN or Inf corner poisons the area
+            if (!isfinite(area) || area == 0.0f || (s->cull_backfaces && area > 0.0f)) continue;
+
+            // View-space normal from the diagonals; shade by its facing ratio
+            float ux = p2.x - a.x, uy = a.y - p2.y, uz = (depth[i2] - depth[i0]) * v->scale;
+            float wx = d.x - b.x, wy = b.y - d.y, wz = (depth[i3] - depth[i1]) * v->scale;
+            float nx = uy * wz - uz * wy, ny = uz * wx - ux * wz, nz = ux * wy - uy * wx;
+            float len = sqrtf(nx * nx + ny * ny + nz * nz);
+            shade[m] = (len > 0) ? 0.55f + 0.45f * fabsf(nz) / len : 1.0f;
+
+            o.keys[m] = depth_key((depth[i0] + depth[i1] + depth[i2] + depth[i3]) * 0.25f);
+            o.idx[m] = (Uint32)(r * (cols - 1) + c);
+            m++;
+        }
+    }
+
+    // Shades were stored in cull order; carry them through the sort via the index
+    float* shade_by_quad = arena_alloc_array(cv->arena, float, quads);
+    if (!shade_by_quad) return;
+    for (int k = 0; k < m; k++) shade_by_quad[o.idx[k]] = shade[k];
+
+    // --- STEP 2: Far to near ---
+    radix_sort_depth(o.keys, o.idx, o.tmp_keys, o.tmp_idx, m);
+
+    // --- STEP 3: Emit ---
+    int batch = m < PLOT3D_BATCH_PRIMS ? m : PLOT3D_BATCH_PRIMS;
+    SDL_Vertex* verts = arena_alloc_array(cv->arena, SDL_Vertex, batch * 4);
+    int* indices = arena_alloc_array(cv->arena, int, batch * 6);
+    if (!verts || !indices) return;
+    const SDL_Color* lut = colormap_lut(s->colormap);
+
+    for (int start = 0; start < m; start += batch) {
+        int count = (m - start < batch) ? m - start : batch;
+        for (int k = 0; k < count; k++) {
+            int q = (int)o.idx[start + k];
+            int r = q / (cols - 1), c = q % (cols - 1);
+            int corner[4] = { r * cols + c, r * cols + c + 1, (r + 1) * cols + c + 1, (r + 1) * cols + c };
+            SDL_Vertex* vq = &verts[k * 4];
+            for (int j = 0; j < 4; j++) {
+                vq[j].position = pts[corner[j]];
+                vq[j].color = to_fcolor(point_color(ax, s, lut, s->z[corner[j]]), shade_by_quad[q]);
+                vq[j].tex_coord = (SDL_FPoint){ 0, 0 };
+            }
+            int* idx = &indices[k * 6];
+            idx[0] = k * 4; idx[1] = k * 4 + 1; idx[2] = k * 4 + 2;
+            idx[3] = k * 4; idx[4] = k * 4 + 2; idx[5] = k * 4 + 3;
+        }
+        canvas_geometry(cv, verts, count * 4, indices, count * 6);
+    }
+}
+
+/**
+ * @brief Renders one 3D series (line, scatter or surface) with a shared View3D.
+ * * @param cv The Canvas to draw into.
+ * @param ax The 3D Axes the series belongs to.
+ * @param s  The Series to draw.
+ * @param v  The camera, from view3d_setup() (computed once per Axes per frame).
+ */
+void render_series_3d(Canvas* cv, Axes* ax, Series* s, const View3D* v) {
+    if (!s->x || !s->y || !s->z || s->count <= 0) return;
+
+    if (s->type == PLOT_SCATTER) {
+        render_scatter_3d(cv, ax, s, v);
+    } else if (s->type == PLOT_SURFACE) {
+        render_surface_3d(cv, ax, s, v);
+    } else if (s->count >= 2) {
+        SDL_FPoint* pts = arena_alloc_array(cv->arena, SDL_FPoint, s->count);
+        if (!pts) return;
+        view3d_project_bulk(v, s->x, s->y, s->z, s->count, pts, NULL);
+        canvas_set_color(cv, s->color);
+        canvas_polyline(cv, pts, s->count, s->thickness, s->style);
+    }
+}
+
+/**
+ * @brief Adds a 3D scatter (point cloud) series.
+ * * Points are depth-sorted every frame so nearer points cover farther ones. Use 
+ * set_colormap() to color points by their z value.
+ * * @param ax    Pointer to the Axes (switched to PROJECTION_3D if needed).
+ * @param x     Array of x-coordinates.
+ * @param y     Array of y-coordinates.
+ * @param z     Array of z-coordinates.
+ * @param count Number of points.
+ * @param color Marker color (when no colormap is set).
+ * @param size  Marker edge length in pixels.
+ */
+void scatter3D(Axes* ax, float* x, float* y, float* z, int count, SDL_Color color, float size) {
+    int before = ax ? ax->line_count : 0;
+    plot3D(ax, x, y, z, count, color);
+    if (!ax || ax->line_count == before) return;
+
+    Series* s = &ax->lines[ax->line_count - 1];
+    s->type = PLOT_SCATTER;
+    s->marker_size = size;
+}
+
+/**
+ * @brief Adds a surface over a rows x cols grid (Matplotlib's plot_surface).
+ * * @param ax   Pointer to the Axes (switched to PROJECTION_3D if needed).
+ * @param x    rows * cols x-coordinates, row-major.
+ * @param y    rows * cols y-coordinates, row-major.
+ * @param z    rows * cols heights, row-major.
+ * @param rows Number of grid rows (>= 2).
+ * @param cols Number of grid columns (>= 2).
+ * @param cmap Colormap applied to z (COLORMAP_NONE shades a flat gray).
+ */
+void plot_surface(Axes* ax, float* x, float* y, float* z, int rows, int cols, Colormap cmap) {
+    if (rows < 2 || cols < 2) return;
+    int before = ax ? ax->line_count : 0;
+    plot3D(ax, x, y, z, rows * cols, (SDL_Color){180, 180, 180, 255});
+    if (!ax || ax->line_count == before) return;
+
+    Series* s = &ax->lines[ax->line_count - 1];
+    s->type = PLOT_SURFACE;
+    s->grid_rows = rows;
+    s->grid_cols = cols;
+    s->colormap = cmap;
+}
+
+/**
+ * @brief Colors a 3D series by z using a colormap (COLORMAP_NONE restores its color).
+ */
+void set_colormap(Axes* ax, int series_idx, Colormap cmap) {
+    if (ax && series_idx >= 0 && series_idx < ax->line_count) {
+        ax->lines[series_idx].colormap = cmap;
+        axes_invalidate_cache(ax); // Not part of the CameraKey
+    }
+}
+
+/**
+ * @brief Enables back-face culling for a surface series.
+ * * Off by default, since open surfaces are usually meant to be seen from both 
+ * sides. Front faces are those whose grid cells (row r, column c -> c+1 -> row r+1)
+ * wind counter-clockwise on screen.
+ */
+void set_backface_culling(Axes* ax, int series_idx, bool enabled) {
+    if (ax && series_idx >= 0 && series_idx < ax->line_count) {
+        ax->lines[series_idx].cull_backfaces = enabled;
+        axes_invalidate_cache(ax);
+    }
+}
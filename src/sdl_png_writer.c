@@ -0,0 +1,298 @@
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_png_writer.h"
+
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+
+static uint32_t crc_table[256];
+static bool crc_ready = false;
+
+static void crc_init(void) {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crc_table[n] = c;
+    }
+    crc_ready = true;
+}
+
+static uint32_t crc_update(uint32_t crc, const uint8_t* buf, size_t len) {
+    for (size_t i = 0; i < len; i++) crc = crc_table[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static void put_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24); p[1] = (uint8_t)(v >> 16); p[2] = (uint8_t)(v >> 8); p[3] = (uint8_t)v;
+}
+
+static void write_chunk(PngWriter* pw, const char* type, const uint8_t* data, uint32_t len) {
+    uint8_t header[8];
+    put_be32(header, len);
+    memcpy(header + 4, type, 4);
+    uint32_t crc = crc_update(0xFFFFFFFFu, header + 4, 4);
+    crc = crc_update(crc, data, len) ^ 0xFFFFFFFFu;
+    uint8_t trailer[4];
+    put_be32(trailer, crc);
+
+    if (fwrite(header, 1, 8, pw->file) != 8 ||
+        (len && fwrite(data, 1, len, pw->file) != len) ||
+        fwrite(trailer, 1, 4, pw->file) != 4) {
+        pw->failed = true;
+    }
+}
+
+// --- Deflate output ---------------------------------------------------------
+
+static void emit_byte(PngWriter* pw, uint8_t b) {
+    pw->idat[pw->idat_len++] = b;
+    if (pw->idat_len == PNG_IDAT_SIZE) {
+        write_chunk(pw, "IDAT", pw->idat, (uint32_t)pw->idat_len);
+        pw->idat_len = 0;
+    }
+}
+
+// Deflate packs bits LSB first
+static void put_bits(PngWriter* pw, uint32_t value, int count) {
+    pw->bit_buffer |= value << pw->bit_count;
+    pw->bit_count += count;
+    while (pw->bit_count >= 8) {
+        emit_byte(pw, (uint8_t)pw->bit_buffer);
+        pw->bit_buffer >>= 8;
+        pw->bit_count -= 8;
+    }
+}
+
+// Huffman codes are stored MSB first, so reverse them before packing
+static void put_code(PngWriter* pw, uint32_t code, int length) {
+    uint32_t rev = 0;
+    for (int i = 0; i < length; i++) {
+        rev = (rev << 1) | (code & 1);
+        code >>= 1;
+    }
+    put_bits(pw, rev, length);
+}
+
+static void put_literal(PngWriter* pw, int sym) {
+    if (sym < 144)      put_code(pw, 0x30 + sym, 8);
+    else if (sym < 256) put_code(pw, 0x190 + (sym - 144), 9);
+    else if (sym < 280) put_code(pw, sym - 256, 7);
+    else                put_code(pw, 0xC0 + (sym - 280), 8);
+}
+
+static const uint16_t len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static void put_match(PngWriter* pw, int length, int distance) {
+    int l = 28;
+    while (len_base[l] > length) l--;
+    put_literal(pw, 257 + l);
+    if (len_extra[l]) put_bits(pw, (uint32_t)(length - len_base[l]), len_extra[l]);
+
+    int d = 29;
+    while (dist_base[d] > distance) d--;
+    put_code(pw, (uint32_t)d, 5);
+    if (dist_extra[d]) put_bits(pw, (uint32_t)(distance - dist_base[d]), dist_extra[d]);
+}
+
+static inline uint32_t hash3(const uint8_t* p) {
+    return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & (PNG_HASH_SIZE - 1);
+}
+
+// Keep the last 32 KB as match history and rebase the hash table
+static void slide_window(PngWriter* pw) {
+    int drop = pw->window_len - PNG_WINDOW_SIZE;
+    memmove(pw->window, pw->window + drop, PNG_WINDOW_SIZE);
+    pw->window_len = PNG_WINDOW_SIZE;
+    for (int i = 0; i < PNG_HASH_SIZE; i++) {
+        pw->hash_head[i] = (pw->hash_head[i] >= drop) ? pw->hash_head[i] - drop : -1;
+    }
+}
+
+// Largest chunk that always fits in the buffer behind 32 KB of history
+#define PNG_CHUNK_SIZE (PNG_BUFFER_SIZE - PNG_WINDOW_SIZE)
+
+// Greedy LZ77 over one chunk of input, matching against up to 32 KB of history
+static void deflate_chunk(PngWriter* pw, const uint8_t* data, int len) {
+    if (pw->window_len + len > PNG_BUFFER_SIZE && pw->window_len > PNG_WINDOW_SIZE) slide_window(pw);
+    int start = pw->window_len;
+    memcpy(pw->window + start, data, len);
+    pw->window_len += len;
+
+    uint8_t* w = pw->window;
+    int end = pw->window_len;
+    int p = start;
+    while (p < end) {
+        int best = 0;
+        if (end - p >= MIN_MATCH) {
+            uint32_t h = hash3(w + p);
+            int cand = pw->hash_head[h];
+            pw->hash_head[h] = p;
+            if (cand >= 0 && p - cand <= PNG_WINDOW_SIZE) {
+                int max = (end - p < MAX_MATCH) ? end - p : MAX_MATCH;
+                while (best < max && w[cand + best] == w[p + best]) best++;
+            }
+            if (best >= MIN_MATCH) {
+                put_match(pw, best, p - cand);
+                for (int k = 1; k < best && p + k + MIN_MATCH <= end; k++) {
+                    pw->hash_head[hash3(w + p + k)] = p + k;
+                }
+                p += best;
+                continue;
+            }
+        }
+        put_literal(pw, w[p]);
+        p++;
+    }
+}
+
+// Compresses any amount of input (rows wider than the buffer are split into chunks)
+static void deflate_bytes(PngWriter* pw, const uint8_t* data, int len) {
+    // Adler-32 of the uncompressed stream (NMAX chunks avoid overflow)
+    for (int i = 0; i < len; ) {
+        int n = (len - i < 5552) ? len - i : 5552;
+        for (int k = 0; k < n; k++) {
+            pw->adler_a += data[i + k];
+            pw->adler_b += pw->adler_a;
+        }
+        pw->adler_a %= 65521;
+        pw->adler_b %= 65521;
+        i += n;
+    }
+
+    for (int i = 0; i < len; i += PNG_CHUNK_SIZE) {
+        deflate_chunk(pw, data + i, (len - i < PNG_CHUNK_SIZE) ? len - i : PNG_CHUNK_SIZE);
+    }
+}
+
+// --- Public API -------------------------------------------------------------
+
+/**
+ * @brief Creates a PNG file and writes its header (8-bit RGB, no interlacing).
+ * * @param filename Destination path.
+ * @param width    Image width in pixels.
+ * @param height   Image height in pixels.
+ * @return A writer to feed rows into, or NULL on failure.
+ */
+PngWriter* png_writer_open(const char* filename, int width, int height) {
+    if (!filename || width <= 0 || height <= 0) return NULL;
+    if (!crc_ready) crc_init();
+
+    PngWriter* pw = calloc(1, sizeof(PngWriter));
+    if (!pw) return NULL;
+    pw->width = width;
+    pw->height = height;
+    pw->adler_a = 1;
+    pw->window = malloc(PNG_BUFFER_SIZE);
+    pw->hash_head = malloc(sizeof(int) * PNG_HASH_SIZE);
+    pw->idat = malloc(PNG_IDAT_SIZE);
+    pw->row = malloc((size_t)width * 3 + 1);
+    pw->file = fopen(filename, "wb");
+    if (!pw->window || !pw->hash_head || !pw->idat || !pw->row || !pw->file) {
+        if (pw->file) fclose(pw->file);
+        free(pw->window); free(pw->hash_head); free(pw->idat); free(pw->row); free(pw);
+        return NULL;
+    }
+    for (int i = 0; i < PNG_HASH_SIZE; i++) pw->hash_head[i] = -1;
+
+    static const uint8_t signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    if (fwrite(signature, 1, 8, pw->file) != 8) pw->failed = true;
+
+    uint8_t ihdr[13];
+    put_be32(ihdr, (uint32_t)width);
+    put_be32(ihdr + 4, (uint32_t)height);
+    ihdr[8] = 8;   // Bit depth
+    ihdr[9] = 2;   // Color type: RGB
+    ihdr[10] = 0;  // Deflate
+    ihdr[11] = 0;  // Adaptive filtering
+    ihdr[12] = 0;  // No interlace
+    write_chunk(pw, "IHDR", ihdr, 13);
+
+    // zlib header, then one open-ended fixed-Huffman block
+    emit_byte(pw, 0x78);
+    emit_byte(pw, 0x01);
+    put_bits(pw, 0, 1);   // BFINAL = 0
+    put_bits(pw, 1, 2);   // BTYPE = fixed Huffman
+    return pw;
+}
+
+/**
+ * @brief Compresses and writes a band of RGB scanlines.
+ * * Each row is stored with the PNG "Sub" filter, which turns flat plot backgrounds 
+ * into runs of zeros that compress extremely well.
+ * * @param pw    The writer returned by png_writer_open().
+ * @param rgb   Pointer to the first row (3 bytes per pixel).
+ * @param pitch Bytes between the starts of consecutive rows.
+ * @param rows  Number of rows to write.
+ * @return false if an I/O error occurred.
+ */
+bool png_writer_write_rows(PngWriter* pw, const uint8_t* rgb, int pitch, int rows) {
+    if (!pw || !rgb) return false;
+    int stride = pw->width * 3;
+    for (int r = 0; r < rows && pw->rows_written < pw->height; r++) {
+        const uint8_t* src = rgb + (size_t)r * pitch;
+        pw->row[0] = 1; // Sub filter
+        for (int i = 0; i < stride; i++) {
+            pw->row[i + 1] = (uint8_t)(src[i] - (i >= 3 ? src[i - 3] : 0));
+        }
+        deflate_bytes(pw, pw->row, stride + 1);
+        pw->rows_written++;
+    }
+    return !pw->failed;
+}
+
+/**
+ * @brief Finishes the deflate stream, writes IEND and closes the file.
+ * * Missing rows (if fewer than `height` were written) are filled with black.
+ * * @param pw The writer to close. It is freed by this call.
+ * @return true if the whole file was written successfully.
+ */
+bool png_writer_close(PngWriter* pw) {
+    if (!pw) return false;
+
+    if (pw->rows_written < pw->height) {
+        uint8_t* blank = calloc((size_t)pw->width, 3);
+        if (blank) {
+            while (pw->rows_written < pw->height) png_writer_write_rows(pw, blank, 0, 1);
+            free(blank);
+        } else {
+            pw->failed = true;
+        }
+    }
+
+    put_literal(pw, 256);                   // End of the open block
+    put_bits(pw, 1, 1); put_bits(pw, 1, 2); // Empty final block
+    put_literal(pw, 256);
+    if (pw->bit_count > 0) put_bits(pw, 0, 8 - pw->bit_count);
+
+    uint32_t adler = (pw->adler_b << 16) | pw->adler_a;
+    emit_byte(pw, (uint8_t)(adler >> 24));
+    emit_byte(pw, (uint8_t)(adler >> 16));
+    emit_byte(pw, (uint8_t)(adler >> 8));
+    emit_byte(pw, (uint8_t)adler);
+    if (pw->idat_len > 0) write_chunk(pw, "IDAT", pw->idat, (uint32_t)pw->idat_len);
+    write_chunk(pw, "IEND", NULL, 0);
+
+    bool ok = !pw->failed;
+    if (fclose(pw->file) != 0) ok = false;
+    free(pw->window);
+    free(pw->hash_head);
+    free(pw->idat);
+    free(pw->row);
+    free(pw);
+    return ok;
+}
@@ -0,0 +1,389 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_raster.h"
+#include "sdl_canvas.h"
+
+static inline int clampi(int v, int lo, int hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// dst += (src - dst) * alpha, with alpha in 0..255
+static inline void blend_pixel(Uint8* p, SDL_Color c, int alpha) {
+    p[0] = (Uint8)(p[0] + (((c.r - p[0]) * alpha + 127) / 255));
+    p[1] = (Uint8)(p[1] + (((c.g - p[1]) * alpha + 127) / 255));
+    p[2] = (Uint8)(p[2] + (((c.b - p[2]) * alpha + 127) / 255));
+    p[3] = (Uint8)(p[3] + (((255 - p[3]) * alpha + 127) / 255));
+}
+
+static void grow_dirty(RasterTarget* rt, int x0, int y0, int x1, int y1) {
+    if (x0 < rt->dirty_x0) rt->dirty_x0 = x0;
+    if (y0 < rt->dirty_y0) rt->dirty_y0 = y0;
+    if (x1 > rt->dirty_x1) rt->dirty_x1 = x1;
+    if (y1 > rt->dirty_y1) rt->dirty_y1 = y1;
+}
+
+static void reset_dirty(RasterTarget* rt) {
+    rt->dirty_x0 = rt->width;
+    rt->dirty_y0 = rt->height;
+    rt->dirty_x1 = -1;
+    rt->dirty_y1 = -1;
+}
+
+/**
+ * @brief Accumulates the coverage of one round-capped segment into the mask.
+ * * For every row the segment can touch, the horizontal span of the capsule is 
+ * computed first, and only that span is visited. Inside it each pixel's coverage 
+ * is its distance to the segment mapped through a 1 px ramp. The inner loop is 
+ * branch-free so the compiler can vectorize it.
+ * * Coverage is combined with max() rather than added, so consecutive segments 
+ * meet in clean round joins instead of darker overlapping blobs.
+ */
+static void capsule_coverage(RasterTarget* rt, float x0, float y0, float x1, float y1, float half) {
+    float r = half + 0.5f; // Outer edge of the anti-aliasing ramp
+    float dx = x1 - x0, dy = y1 - y0;
+    float len2 = dx * dx + dy * dy;
+    float inv_len2 = (len2 > 0.0f) ? 1.0f / len2 : 0.0f;
+
+    int ymin = clampi((int)floorf(fminf(y0, y1) - r), 0, rt->height - 1);
+    int ymax = clampi((int)ceilf(fmaxf(y0, y1) + r), 0, rt->height - 1);
+    if (fmaxf(y0, y1) + r < 0.0f || fminf(y0, y1) - r > rt->height) return;
+
+    for (int py = ymin; py <= ymax; py++) {
+        float cy = py + 0.5f;
+
+        // Part of the segment within r of this row, widened by r on both sides
+        float ta = 0.0f, tb = 1.0f;
+        if (dy != 0.0f) {
+            ta = (cy - r - y0) / dy;
+            tb = (cy + r - y0) / dy;
+            if (ta > tb) { float t = ta; ta = tb; tb = t; }
+            ta = fmaxf(ta, 0.0f);
+            tb = fminf(tb, 1.0f);
+            if (ta > tb) continue;
+        } else if (fabsf(cy - y0) > r) {
+            continue;
+        }
+        float xa = x0 + ta * dx, xb = x0 + tb * dx;
+        int xs = clampi((int)floorf(fminf(xa, xb) - r), 0, rt->width - 1);
+        int xe = clampi((int)ceilf(fmaxf(xa, xb) + r), 0, rt->width - 1);
+        if (fmaxf(xa, xb) + r < 0.0f || fminf(xa, xb) - r > rt->width) continue;
+
+        Uint8* row = rt->coverage + (size_t)py * rt->width;
+        float ey0 = cy - y0;
+        for (int px = xs; px <= xe; px++) {
+            float ex0 = (px + 0.5f) - x0;
+            float t = fminf(fmaxf((ex0 * dx + ey0 * dy) * inv_len2, 0.0f), 1.0f);
+            float ex = ex0 - t * dx, ey = ey0 - t * dy;
+            float c = fminf(fmaxf(r - sqrtf(ex * ex + ey * ey), 0.0f), 1.0f);
+            Uint8 v = (Uint8)(c * 255.0f + 0.5f);
+            row[px] = row[px] > v ? row[px] : v;
+        }
+        grow_dirty(rt, xs, py, xe, py);
+    }
+}
+
+// Blends the accumulated mask with one color and clears it for the next primitive
+static void composite_coverage(RasterTarget* rt, SDL_Color color) {
+    for (int y = rt->dirty_y0; y <= rt->dirty_y1; y++) {
+        Uint8* cov = rt->coverage + (size_t)y * rt->width;
+        Uint8* px = rt->pixels + (size_t)y * rt->pitch;
+        for (int x = rt->dirty_x0; x <= rt->dirty_x1; x++) {
+            if (cov[x]) {
+                blend_pixel(px + x * 4, color, cov[x] * color.a / 255);
+                cov[x] = 0;
+            }
+        }
+    }
+    reset_dirty(rt);
+}
+
+/**
+ * @brief Allocates an RGBA raster and its coverage mask.
+ * * @param rt     Pointer to the RasterTarget to initialize.
+ * @param width  Width in pixels.
+ * @param height Height in pixels.
+ * @return true on success.
+ */
+bool raster_init(RasterTarget* rt, int width, int height) {
+    if (!rt || width <= 0 || height <= 0) return false;
+    rt->width = width;
+    rt->height = height;
+    rt->pitch = width * 4;
+    rt->pixels = malloc((size_t)rt->pitch * height);
+    rt->coverage = calloc((size_t)width * height, 1);
+    reset_dirty(rt);
+    if (!rt->pixels || !rt->coverage) {
+        raster_destroy(rt);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Frees the memory owned by a RasterTarget.
+ * * @param rt Pointer to the RasterTarget.
+ */
+void raster_destroy(RasterTarget* rt) {
+    if (!rt) return;
+    free(rt->pixels);
+    free(rt->coverage);
+    rt->pixels = NULL;
+    rt->coverage = NULL;
+}
+
+/**
+ * @brief Fills the entire raster with one color.
+ */
+void raster_clear(RasterTarget* rt, SDL_Color color) {
+    for (int y = 0; y < rt->height; y++) {
+        Uint8* p = rt->pixels + (size_t)y * rt->pitch;
+        for (int x = 0; x < rt->width; x++, p += 4) {
+            p[0] = color.r; p[1] = color.g; p[2] = color.b; p[3] = color.a;
+        }
+    }
+}
+
+/**
+ * @brief Draws an anti-aliased polyline with round joins and caps.
+ * * The whole series is accumulated into the coverage mask and blended once, so 
+ * semi-transparent lines do not darken where segments overlap. Dash patterns 
+ * follow the arc length across vertices, matching DrawDashedThickLine's 10/5 px 
+ * dashes and 3/3 px dots.
+ * * @param rt        The RasterTarget to draw into.
+ * @param pts       Vertices in pixel coordinates.
+ * @param count     Number of vertices.
+ * @param thickness Line width in pixels (values below 1 are drawn 1 px wide).
+ * @param style     STYLE_SOLID, STYLE_DASHED or STYLE_DOTTED.
+ * @param color     Line color (alpha is honored).
+ */
+void raster_polyline(RasterTarget* rt, const SDL_FPoint* pts, int count, float thickness, LineStyle style, SDL_Color color) {
+    if (!rt || !pts || count < 2) return;
+    float half = (thickness > 1.0f ? thickness : 1.0f) / 2.0f;
+
+    if (style == STYLE_SOLID) {
+        for (int i = 0; i < count - 1; i++) {
+            capsule_coverage(rt, pts[i].x, pts[i].y, pts[i+1].x, pts[i+1].y, half);
+        }
+    } else {
+        float on = (style == STYLE_DASHED) ? 10.0f : 3.0f;
+        float off = (style == STYLE_DASHED) ? 5.0f : 3.0f;
+        float phase = 0.0f; // Distance into the current on+off period
+        for (int i = 0; i < count - 1; i++) {
+            float dx = pts[i+1].x - pts[i].x, dy = pts[i+1].y - pts[i].y;
+            float len = sqrtf(dx * dx + dy * dy);
+            float pos = 0.0f;
+            while (len > 0.0f && pos < len) {
+                float remaining = (phase < on) ? on - phase : on + off - phase;
+                float end = fminf(pos + remaining, len);
+                if (phase < on) {
+                    capsule_coverage(rt, pts[i].x + dx * pos / len, pts[i].y + dy * pos / len,
+                                     pts[i].x + dx * end / len, pts[i].y + dy * end / len, half);
+                }
+                phase = fmodf(phase + (end - pos), on + off);
+                pos = end;
+            }
+        }
+    }
+    composite_coverage(rt, color);
+}
+
+/**
+ * @brief Fills a rectangle, anti-aliasing fractional edges by area coverage.
+ */
+void raster_fill_rect(RasterTarget* rt, float x, float y, float w, float h, SDL_Color color) {
+    if (!rt || w <= 0 || h <= 0) return;
+    int x0 = clampi((int)floorf(x), 0, rt->width), x1 = clampi((int)ceilf(x + w), 0, rt->width);
+    int y0 = clampi((int)floorf(y), 0, rt->height), y1 = clampi((int)ceilf(y + h), 0, rt->height);
+
+    for (int py = y0; py < y1; py++) {
+        float cy = fminf(py + 1.0f, y + h) - fmaxf((float)py, y);
+        Uint8* row = rt->pixels + (size_t)py * rt->pitch;
+        for (int px = x0; px < x1; px++) {
+            float cx = fminf(px + 1.0f, x + w) - fmaxf((float)px, x);
+            int alpha = (int)(cx * cy * color.a + 0.5f);
+            if (alpha > 0) blend_pixel(row + px * 4, color, alpha);
+        }
+    }
+}
+
+/**
+ * @brief Fills triangles (pixel-center sampling, color of each triangle's first vertex).
+ * * Texture coordinates are ignored; this covers the flat-colored geometry the 
+ * plotting code emits.
+ */
+void raster_triangles(RasterTarget* rt, const SDL_Vertex* v, int num_vertices, const int* indices, int num_indices) {
+    if (!rt || !v) return;
+    int tri_count = indices ? num_indices / 3 : num_vertices / 3;
+
+    for (int t = 0; t < tri_count; t++) {
+        const SDL_Vertex* a = &v[indices ? indices[t * 3] : t * 3];
+        const SDL_Vertex* b = &v[indices ? indices[t * 3 + 1] : t * 3 + 1];
+        const SDL_Vertex* c = &v[indices ? indices[t * 3 + 2] : t * 3 + 2];
+
+        float area = (b->position.x - a->position.x) * (c->position.y - a->position.y) -
+                     (b->position.y - a->position.y) * (c->position.x - a->position.x);
+        if (area == 0.0f) continue;
+        float sign = area > 0 ? 1.0f : -1.0f;
+
+        int x0 = clampi((int)floorf(fminf(a->position.x, fminf(b->position.x, c->position.x))), 0, rt->width - 1);
+        int x1 = clampi((int)ceilf(fmaxf(a->position.x, fmaxf(b->position.x, c->position.x))), 0, rt->width - 1);
+        int y0 = clampi((int)floorf(fminf(a->position.y, fminf(b->position.y, c->position.y))), 0, rt->height - 1);
+        int y1 = clampi((int)ceilf(fmaxf(a->position.y, fmaxf(b->position.y, c->position.y))), 0, rt->height - 1);
+
+        SDL_FColor fc = a->color;
+        SDL_Color col = { (Uint8)(fc.r * 255.0f), (Uint8)(fc.g * 255.0f), (Uint8)(fc.b * 255.0f), (Uint8)(fc.a * 255.0f) };
+
+        for (int py = y0; py <= y1; py++) {
+            float cy = py + 0.5f;
+            Uint8* row = rt->pixels + (size_t)py * rt->pitch;
+            for (int px = x0; px <= x1; px++) {
+                float cx = px + 0.5f;
+                float w0 = ((b->position.x - a->position.x) * (cy - a->position.y) - (b->position.y - a->position.y) * (cx - a->position.x)) * sign;
+                float w1 = ((c->position.x - b->position.x) * (cy - b->position.y) - (c->position.y - b->position.y) * (cx - b->position.x)) * sign;
+                float w2 = ((a->position.x - c->position.x) * (cy - c->position.y) - (a->position.y - c->position.y) * (cx - c->position.x)) * sign;
+                if (w0 >= 0 && w1 >= 0 && w2 >= 0) blend_pixel(row + px * 4, col, col.a);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Alpha-blends an SDL_Surface (e.g. rendered text) onto the raster.
+ * * @param rt      The RasterTarget to draw into.
+ * @param surface Source surface in any pixel format.
+ * @param x       Destination left edge.
+ * @param y       Destination top edge.
+ */
+void raster_blit_surface(RasterTarget* rt, SDL_Surface* surface, int x, int y) {
+    if (!rt || !surface) return;
+    SDL_Surface* src = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    if (!src) return;
+
+    for (int sy = 0; sy < src->h; sy++) {
+        int dy = y + sy;
+        if (dy < 0 || dy >= rt->height) continue;
+        const Uint8* s = (const Uint8*)src->pixels + (size_t)sy * src->pitch;
+        Uint8* d = rt->pixels + (size_t)dy * rt->pitch;
+        for (int sx = 0; sx < src->w; sx++) {
+            int dx = x + sx;
+            if (dx < 0 || dx >= rt->width || s[sx * 4 + 3] == 0) continue;
+            SDL_Color c = { s[sx * 4], s[sx * 4 + 1], s[sx * 4 + 2], 255 };
+            blend_pixel(d + dx * 4, c, s[sx * 4 + 3]);
+        }
+    }
+    SDL_DestroySurface(src);
+}
+
+// --- Canvas backend ---------------------------------------------------------
+
+static SDL_FPoint* raster_map_points(Canvas* cv, const SDL_FPoint* pts, int count) {
+    if (!canvas_is_transformed(cv)) return (SDL_FPoint*)pts;
+    SDL_FPoint* out = arena_alloc_array(cv->arena, SDL_FPoint, count);
+    if (!out) return NULL;
+    for (int i = 0; i < count; i++) {
+        out[i].x = canvas_px(cv, pts[i].x);
+        out[i].y = canvas_py(cv, pts[i].y);
+    }
+    return out;
+}
+
+static void rc_set_color(Canvas* cv, SDL_Color color) {
+    (void)cv; (void)color; // Every primitive reads cv->color
+}
+
+static void rc_line(Canvas* cv, float x1, float y1, float x2, float y2) {
+    SDL_FPoint pts[2] = { { canvas_px(cv, x1), canvas_py(cv, y1) }, { canvas_px(cv, x2), canvas_py(cv, y2) } };
+    raster_polyline(cv->raster, pts, 2, cv->scale, STYLE_SOLID, cv->color);
+}
+
+static void rc_polyline(Canvas* cv, const SDL_FPoint* pts, int count, float thickness, LineStyle style) {
+    SDL_FPoint* mapped = raster_map_points(cv, pts, count);
+    if (!mapped) return;
+    raster_polyline(cv->raster, mapped, count, (thickness > 1.0f ? thickness : 1.0f) * cv->scale, style, cv->color);
+}
+
+static void rc_rect(Canvas* cv, const SDL_FRect* r, bool filled) {
+    if (filled) {
+        raster_fill_rect(cv->raster, canvas_px(cv, r->x), canvas_py(cv, r->y), r->w * cv->scale, r->h * cv->scale, cv->color);
+    } else {
+        SDL_FPoint pts[5] = {
+            { r->x, r->y }, { r->x + r->w, r->y }, { r->x + r->w, r->y + r->h }, { r->x, r->y + r->h }, { r->x, r->y }
+        };
+        for (int i = 0; i < 5; i++) {
+            pts[i].x = canvas_px(cv, pts[i].x);
+            pts[i].y = canvas_py(cv, pts[i].y);
+        }
+        raster_polyline(cv->raster, pts, 5, cv->scale, STYLE_SOLID, cv->color);
+    }
+}
+
+static void rc_markers(Canvas* cv, const SDL_FPoint* centers, int count, float size) {
+    float s = size * cv->scale;
+    for (int i = 0; i < count; i++) {
+        raster_fill_rect(cv->raster, canvas_px(cv, centers[i].x) - s / 2.0f, canvas_py(cv, centers[i].y) - s / 2.0f, s, s, cv->color);
+    }
+}
+
+static void rc_geometry(Canvas* cv, const SDL_Vertex* vertices, int num_vertices, const int* indices, int num_indices) {
+    if (canvas_is_transformed(cv)) {
+        SDL_Vertex* v = arena_alloc_array(cv->arena, SDL_Vertex, num_vertices);
+        if (!v) return;
+        for (int i = 0; i < num_vertices; i++) {
+            v[i] = vertices[i];
+            v[i].position.x = canvas_px(cv, vertices[i].position.x);
+            v[i].position.y = canvas_py(cv, vertices[i].position.y);
+        }
+        vertices = v;
+    }
+    raster_triangles(cv->raster, vertices, num_vertices, indices, num_indices);
+}
+
+static void rc_image(Canvas* cv, SDL_Texture* texture, const SDL_Vertex* v, int num_vertices, const int* indices, int num_indices) {
+    (void)cv; (void)texture; (void)v; (void)num_vertices; (void)indices; (void)num_indices; // GPU-only content
+}
+
+static void rc_text(Canvas* cv, const char* text, float x, float y, bool right_align, SDL_Color color) {
+    TTF_Font* font = cv->text_font ? cv->text_font : cv->font;
+    if (!font) return;
+    SDL_Surface* surface = TTF_RenderText_Blended(font, text, 0, color);
+    if (!surface) return;
+    float px = canvas_px(cv, x), py = canvas_py(cv, y);
+    float left = right_align ? px - surface->w : px - surface->w / 2.0f;
+    raster_blit_surface(cv->raster, surface, (int)lroundf(left), (int)lroundf(py - surface->h / 2.0f));
+    SDL_DestroySurface(surface);
+}
+
+static void rc_tick_label(Canvas* cv, TickCache* tc, int i, float x, float y, bool right_align, SDL_Color color) {
+    rc_text(cv, tc->labels[i], x, y, right_align, color);
+}
+
+static const CanvasOps raster_canvas_ops = {
+    rc_set_color, rc_line, rc_polyline, rc_rect, rc_markers, rc_geometry, rc_image, rc_text, rc_tick_label
+};
+
+/**
+ * @brief Prepares a Canvas that draws anti-aliased output into a RasterTarget.
+ * * No SDL_Renderer is involved, so this works headless. Combine with 
+ * canvas_set_transform() to render a band of a larger image.
+ * * @param cv    Pointer to the Canvas to initialize.
+ * @param rt    The RasterTarget to draw into.
+ * @param font  The TTF_Font used for text metrics (and text, unless a scaled font is set).
+ * @param arena Scratch memory for transformed vertices.
+ */
+void canvas_init_raster(Canvas* cv, RasterTarget* rt, TTF_Font* font, FrameArena* arena) {
+    cv->ops = &raster_canvas_ops;
+    cv->color = (SDL_Color){0, 0, 0, 255};
+    cv->font = font;
+    cv->arena = arena;
+    cv->renderer = NULL;
+    cv->out = NULL;
+    cv->raster = rt;
+    cv->width = rt ? (float)rt->width : 0.0f;
+    cv->height = rt ? (float)rt->height : 0.0f;
+    cv->scale = 1.0f;
+    cv->origin_x = cv->origin_y = 0.0f;
+    cv->text_font = NULL;
+}
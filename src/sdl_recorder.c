@@ -0,0 +1,242 @@
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_recorder.h"
+
+static inline Uint8 clamp_u8(int v) {
+    return (Uint8)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+/**
+ * @brief Converts a packed RGB24 image into planar YUV 4:2:0 (full-range BT.601).
+ * * Pixels outside the source (when the window shrank after recording started) are 
+ * written as white so the video keeps a constant size.
+ */
+static void rgb_to_yuv420(const SDL_Surface* rgb, Uint8* yuv, int width, int height) {
+    int cw = (width + 1) / 2, ch = (height + 1) / 2;
+    Uint8* y_plane = yuv;
+    Uint8* u_plane = yuv + (size_t)width * height;
+    Uint8* v_plane = u_plane + (size_t)cw * ch;
+
+    for (int y = 0; y < height; y++) {
+        const Uint8* row = (const Uint8*)rgb->pixels + (size_t)y * rgb->pitch;
+        for (int x = 0; x < width; x++) {
+            int r = 255, g = 255, b = 255;
+            if (y < rgb->h && x < rgb->w) { r = row[x * 3]; g = row[x * 3 + 1]; b = row[x * 3 + 2]; }
+            y_plane[(size_t)y * width + x] = clamp_u8((77 * r + 150 * g + 29 * b + 128) >> 8);
+        }
+    }
+
+    // Chroma from the average of each 2x2 block
+    for (int cy = 0; cy < ch; cy++) {
+        for (int cx = 0; cx < cw; cx++) {
+            int r = 0, g = 0, b = 0;
+            for (int k = 0; k < 4; k++) {
+                int x = cx * 2 + (k & 1), y = cy * 2 + (k >> 1);
+                if (x >= width) x = width - 1;
+                if (y >= height) y = height - 1;
+                if (y < rgb->h && x < rgb->w) {
+                    const Uint8* p = (const Uint8*)rgb->pixels + (size_t)y * rgb->pitch + x * 3;
+                    r += p[0]; g += p[1]; b += p[2];
+                } else {
+                    r += 255; g += 255; b += 255;
+                }
+            }
+            r /= 4; g /= 4; b /= 4;
+            u_plane[(size_t)cy * cw + cx] = clamp_u8(((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128);
+            v_plane[(size_t)cy * cw + cx] = clamp_u8(((128 * r - 107 * g - 21 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+static void encode_y4m(FrameRecorder* rec, const RecordedFrame* frame, SDL_Surface* rgb) {
+    if (!rec->file) {
+        // The first frame fixes the video size (4:2:0 needs even dimensions)
+        rec->width = rgb->w & ~1;
+        rec->height = rgb->h & ~1;
+        if (rec->width <= 0 || rec->height <= 0) { rec->failed = true; return; }
+        rec->yuv = malloc((size_t)rec->width * rec->height * 3 / 2);
+        rec->file = fopen(rec->path, "wb");
+        if (!rec->yuv || !rec->file) { rec->failed = true; return; }
+        fprintf(rec->file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", rec->width, rec->height, rec->fps);
+    }
+
+    size_t size = (size_t)rec->width * rec->height * 3 / 2;
+    // Hold the previous frame (still in rec->yuv) over the dropped slots, so playback
+    // keeps wall-clock timing and this frame shows up at its own slot. Drops before
+    // the first frame have nothing to hold and are covered by the frame itself.
+    int held = (rec->frames_written == 0) ? 0 : frame->repeat - 1; // Slots showing the previous frame
+    for (int i = 0; i < frame->repeat; i++) {
+        if (i == held) rgb_to_yuv420(rgb, rec->yuv, rec->width, rec->height);
+        if (fputs("FRAME\n", rec->file) == EOF || fwrite(rec->yuv, 1, size, rec->file) != size) {
+            rec->failed = true;
+            return;
+        }
+        rec->frames_written++;
+    }
+}
+
+static void encode_png(FrameRecorder* rec, const RecordedFrame* frame, SDL_Surface* rgb) {
+    // Numbered by timeline slot: gaps in the sequence show where frames were dropped
+    char name[600];
+    snprintf(name, sizeof(name), "%s_%05d.png", rec->path, frame->index);
+    if (IMG_SavePNG(rgb, name)) {
+        rec->frames_written++;
+    } else {
+        rec->failed = true;
+    }
+}
+
+static int recorder_thread(void* data) {
+    FrameRecorder* rec = (FrameRecorder*)data;
+
+    for (;;) {
+        SDL_LockMutex(rec->lock);
+        while (rec->queue_count == 0 && !rec->stopping) {
+            SDL_WaitCondition(rec->ready, rec->lock);
+        }
+        if (rec->queue_count == 0) { // Stopping and fully drained
+            SDL_UnlockMutex(rec->lock);
+            break;
+        }
+        RecordedFrame frame = rec->queue[rec->queue_head];
+        SDL_UnlockMutex(rec->lock);
+
+        // Encode outside the lock so capture never waits on the disk
+        if (!rec->failed) {
+            SDL_Surface* rgb = SDL_ConvertSurface(frame.surface, SDL_PIXELFORMAT_RGB24);
+            if (rgb) {
+                if (rec->format == RECORD_Y4M) {
+                    encode_y4m(rec, &frame, rgb);
+                } else {
+                    encode_png(rec, &frame, rgb);
+                }
+                SDL_DestroySurface(rgb);
+            } else {
+                rec->failed = true;
+            }
+        }
+        SDL_DestroySurface(frame.surface);
+
+        // Only now free the slot, so at most RECORDER_QUEUE_LEN frames are ever alive
+        SDL_LockMutex(rec->lock);
+        rec->queue_head = (rec->queue_head + 1) % RECORDER_QUEUE_LEN;
+        rec->queue_count--;
+        SDL_UnlockMutex(rec->lock);
+    }
+    return 0;
+}
+
+/**
+ * @brief Starts a recording and its background encoder thread.
+ * * @param path   Output file for RECORD_Y4M (e.g. "capture.y4m"), or the file name 
+ * prefix for RECORD_PNG_SEQUENCE (e.g. "frames/capture").
+ * @param format RECORD_Y4M or RECORD_PNG_SEQUENCE.
+ * @param fps    Capture rate. Frames are sampled on this wall-clock grid regardless 
+ * of how fast the figure renders (<= 0 selects 30).
+ * @return A new FrameRecorder, or NULL on failure.
+ */
+FrameRecorder* recorder_start(const char* path, RecordFormat format, int fps) {
+    if (!path) return NULL;
+
+    FrameRecorder* rec = calloc(1, sizeof(FrameRecorder));
+    if (!rec) return NULL;
+    rec->format = format;
+    rec->fps = (fps > 0) ? fps : 30;
+    snprintf(rec->path, sizeof(rec->path), "%s", path);
+    rec->lock = SDL_CreateMutex();
+    rec->ready = SDL_CreateCondition();
+    rec->start_ns = SDL_GetTicksNS();
+
+    if (rec->lock && rec->ready) {
+        rec->thread = SDL_CreateThread(recorder_thread, "sdl_graphs_recorder", rec);
+    }
+    if (!rec->thread) {
+        fprintf(stderr, "Failed to start recorder: %s\n", SDL_GetError());
+        if (rec->ready) SDL_DestroyCondition(rec->ready);
+        if (rec->lock) SDL_DestroyMutex(rec->lock);
+        free(rec);
+        return NULL;
+    }
+    return rec;
+}
+
+/**
+ * @brief Captures the frame currently being drawn, if one is due.
+ * * Call after drawing and before SDL_RenderPresent(). The pixels are read back and 
+ * handed to the encoder thread; if its queue is full the frame is dropped instead 
+ * of blocking, so a slow disk never lowers the live frame rate.
+ * * @param rec      The active FrameRecorder.
+ * @param renderer The renderer that holds the finished frame.
+ * @return true if a frame was queued, false if none was due or it was dropped.
+ */
+bool recorder_capture(FrameRecorder* rec, SDL_Renderer* renderer) {
+    if (!rec || !renderer) return false;
+
+    // --- STEP 1: Is a timeline slot due? ---
+    Uint64 elapsed = SDL_GetTicksNS() - rec->start_ns;
+    int due = (int)(elapsed * (Uint64)rec->fps / 1000000000ull);
+    if (due < rec->next_index) return false;
+
+    // Slots that passed without a render count as drops
+    rec->pending_drops += due - rec->next_index;
+    rec->frames_dropped += due - rec->next_index;
+    rec->next_index = due + 1;
+
+    // --- STEP 2: Check for room before paying for the read-back ---
+    SDL_LockMutex(rec->lock);
+    bool full = rec->queue_count == RECORDER_QUEUE_LEN;
+    SDL_UnlockMutex(rec->lock);
+    if (full) {
+        rec->pending_drops++;
+        rec->frames_dropped++;
+        return false;
+    }
+
+    SDL_Surface* surface = SDL_RenderReadPixels(renderer, NULL);
+    if (!surface) return false;
+
+    // --- STEP 3: Enqueue (only this thread adds, so the slot is still free) ---
+    SDL_LockMutex(rec->lock);
+    int tail = (rec->queue_head + rec->queue_count) % RECORDER_QUEUE_LEN;
+    rec->queue[tail].surface = surface;
+    rec->queue[tail].index = due;
+    rec->queue[tail].repeat = 1 + rec->pending_drops;
+    rec->queue_count++;
+    SDL_SignalCondition(rec->ready);
+    SDL_UnlockMutex(rec->lock);
+
+    rec->pending_drops = 0;
+    rec->frames_captured++;
+    return true;
+}
+
+/**
+ * @brief Finishes a recording: encodes the queued frames, joins the thread and 
+ * closes the output.
+ * * @param rec The FrameRecorder to stop. It is freed by this call.
+ */
+void recorder_stop(FrameRecorder* rec) {
+    if (!rec) return;
+
+    SDL_LockMutex(rec->lock);
+    rec->stopping = true;
+    SDL_SignalCondition(rec->ready);
+    SDL_UnlockMutex(rec->lock);
+    SDL_WaitThread(rec->thread, NULL);
+
+    if (rec->file && fclose(rec->file) != 0) rec->failed = true;
+    if (rec->failed) {
+        fprintf(stderr, "Recording to %s failed: %s\n", rec->path, SDL_GetError());
+    } else {
+        printf("Recording saved to %s (%d frames captured, %d dropped, %d written)\n",
+               rec->path, rec->frames_captured, rec->frames_dropped, rec->frames_written);
+    }
+
+    free(rec->yuv);
+    SDL_DestroyCondition(rec->ready);
+    SDL_DestroyMutex(rec->lock);
+    free(rec);
+}
@@ -0,0 +1,146 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include "sdl_runs.h"
+
+// v - v is 0 for finite values and NaN for NaN/Inf, so this is a plain compare
+// with no branch or library call and vectorizes like any arithmetic loop.
+static inline int is_finite_pair(float x, float y) {
+    return (x - x == 0.0f) & (y - y == 0.0f);
+}
+
+// Independent accumulators per lane, so the min/max chains don't serialize and
+// the compiler can map each group of lanes onto one SIMD register
+#define BOUNDS_LANES 8
+
+/**
+ * @brief Widens data limits by a series' finite points.
+ * * A point counts only when both coordinates are finite, so NaN/Inf samples 
+ * can no longer drag the limits to infinity. The main loop is branch-free 
+ * (masks and selects over BOUNDS_LANES accumulators), so it costs about the same 
+ * as the unchecked min/max scan it replaces.
+ * * @param x, y   Point coordinates.
+ * @param count  Number of points.
+ * @param x_min, x_max, y_min, y_max Limits to widen (in/out).
+ * @return The number of points skipped as non-finite.
+ */
+int finite_bounds(const float* x, const float* y, int count, float* x_min, float* x_max, float* y_min, float* y_max) {
+    float x_lo[BOUNDS_LANES], x_hi[BOUNDS_LANES], y_lo[BOUNDS_LANES], y_hi[BOUNDS_LANES];
+    int bad[BOUNDS_LANES];
+    for (int k = 0; k < BOUNDS_LANES; k++) {
+        x_lo[k] = *x_min; x_hi[k] = *x_max;
+        y_lo[k] = *y_min; y_hi[k] = *y_max;
+        bad[k] = 0;
+    }
+
+    int i = 0;
+    for (; i + BOUNDS_LANES <= count; i += BOUNDS_LANES) {
+        for (int k = 0; k < BOUNDS_LANES; k++) {
+            float xi = x[i + k], yi = y[i + k];
+            int ok = is_finite_pair(xi, yi);
+            bad[k] += !ok;
+            float xa = ok ? xi : x_lo[k], xb = ok ? xi : x_hi[k];
+            float ya = ok ? yi : y_lo[k], yb = ok ? yi : y_hi[k];
+            x_lo[k] = xa < x_lo[k] ? xa : x_lo[k];
+            x_hi[k] = xb > x_hi[k] ? xb : x_hi[k];
+            y_lo[k] = ya < y_lo[k] ? ya : y_lo[k];
+            y_hi[k] = yb > y_hi[k] ? yb : y_hi[k];
+        }
+    }
+
+    int skipped = 0;
+    for (int k = 0; k < BOUNDS_LANES; k++) {
+        skipped += bad[k];
+        if (x_lo[k] < *x_min) *x_min = x_lo[k];
+        if (x_hi[k] > *x_max) *x_max = x_hi[k];
+        if (y_lo[k] < *y_min) *y_min = y_lo[k];
+        if (y_hi[k] > *y_max) *y_max = y_hi[k];
+    }
+    for (; i < count; i++) {
+        if (!is_finite_pair(x[i], y[i])) {
+            skipped++;
+            continue;
+        }
+        if (x[i] < *x_min) *x_min = x[i];
+        if (x[i] > *x_max) *x_max = x[i];
+        if (y[i] < *y_min) *y_min = y[i];
+        if (y[i] > *y_max) *y_max = y[i];
+    }
+    return skipped;
+}
+
+static int count_non_finite(const float* x, const float* y, int count) {
+    int bad = 0;
+    for (int i = 0; i < count; i++) bad += !is_finite_pair(x[i], y[i]);
+    return bad;
+}
+
+static bool runs_push(RunIndex* ri, int start, int length) {
+    if (ri->count == ri->capacity) {
+        int cap = ri->capacity ? ri->capacity * 2 : 16;
+        int* s = realloc(ri->start, sizeof(int) * (size_t)cap);
+        if (!s) return false;
+        ri->start = s;
+        int* l = realloc(ri->length, sizeof(int) * (size_t)cap);
+        if (!l) return false;
+        ri->length = l;
+        ri->capacity = cap;
+    }
+    ri->start[ri->count] = start;
+    ri->length[ri->count] = length;
+    ri->count++;
+    return true;
+}
+
+/**
+ * @brief Returns the finite runs of a series, rebuilding them only when its data changed.
+ * * The index is keyed on the arrays being drawn (the series' own, or its scaled 
+ * copy on log axes, see series_scaled()) and count (in-place edits are 
+ * picked up through figure_mark_dirty()). A first branch-free pass counts 
+ * non-finite points; only when it finds some does a second pass record the runs. 
+ * Series without gaps therefore cost one scan when the data changes and a flag 
+ * check per frame.
+ * * @param s Pointer to the Series (its RunIndex is created on first use).
+ * @param x, y Coordinates the series is drawn from.
+ * @return The index, or NULL if it could not be allocated.
+ */
+const RunIndex* series_runs(Series* s, const float* x, const float* y) {
+    if (!s->runs) {
+        s->runs = calloc(1, sizeof(RunIndex));
+        if (!s->runs) return NULL;
+    }
+    RunIndex* ri = s->runs;
+    if (ri->valid && ri->key_x == x && ri->key_y == y && ri->key_count == s->count) return ri;
+
+    ri->valid = false;
+    ri->count = 0;
+    ri->all_finite = count_non_finite(x, y, s->count) == 0;
+    if (ri->all_finite) {
+        if (!runs_push(ri, 0, s->count)) return NULL;
+    } else {
+        int start = -1;
+        for (int i = 0; i <= s->count; i++) {
+            bool ok = i < s->count && is_finite_pair(x[i], y[i]);
+            if (ok && start < 0) start = i;
+            if (!ok && start >= 0) {
+                if (!runs_push(ri, start, i - start)) return NULL;
+                start = -1;
+            }
+        }
+    }
+    ri->key_x = x;
+    ri->key_y = y;
+    ri->key_count = s->count;
+    ri->valid = true;
+    return ri;
+}
+
+void runs_invalidate(RunIndex* ri) {
+    if (ri) ri->valid = false;
+}
+
+void runs_destroy(RunIndex* ri) {
+    if (!ri) return;
+    free(ri->start);
+    free(ri->length);
+    free(ri);
+}
@@ -0,0 +1,159 @@
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdlib.h>
+#include "sdl_scale.h"
+#include "sdl_runs.h"
+#include "sdl_pick.h"
+#include "sdl_ticks.h"
+#include "sdl_fill.h"
+#include "sdl_link.h"
+
+/**
+ * @brief Maps an array through an axis scale.
+ * * The switch is hoisted out of the loops, so each one is a straight run of 
+ * fast_log10() calls that the compiler vectorizes.
+ * * @param scale     Axis scale.
+ * @param linthresh Linear half-width for SCALE_SYMLOG.
+ * @param in        Data values.
+ * @param out       Receives the mapped values (may equal @p in).
+ * @param count     Number of values.
+ */
+void scale_bulk(AxisScale scale, float linthresh, const float* in, float* out, int count) {
+    if (scale == SCALE_LOG) {
+        for (int i = 0; i < count; i++) out[i] = fast_log10(in[i]);
+    } else if (scale == SCALE_SYMLOG) {
+        float inv = 1.0f / linthresh;
+        for (int i = 0; i < count; i++) out[i] = copysignf(fast_log10(1.0f + fabsf(in[i]) * inv), in[i]);
+    } else if (out != in) {
+        memcpy(out, in, sizeof(float) * (size_t)count);
+    }
+}
+
+static bool scale_grow(ScaleCache* sc, int count) {
+    if (count <= sc->capacity) return true;
+    float* x = realloc(sc->x, sizeof(float) * (size_t)count);
+    if (!x) return false;
+    sc->x = x;
+    float* y = realloc(sc->y, sizeof(float) * (size_t)count);
+    if (!y) return false;
+    sc->y = y;
+    sc->capacity = count;
+    return true;
+}
+
+/**
+ * @brief Returns a series' coordinates in view units, i.e. after the axes' scales.
+ * * Linear axes hand back the series' own arrays at no cost. Scaled axes map the 
+ * data once into the series' ScaleCache and reuse it until the arrays, count or 
+ * scales change (in-place edits are picked up through figure_mark_dirty()). 
+ * Non-positive values on a log axis come out as NaN, so they are excluded from 
+ * limits and break lines exactly like missing samples.
+ * * @param ax Pointer to the Axes that owns the series.
+ * @param s  Pointer to the Series.
+ * @param x  Receives the x array to draw.
+ * @param y  Receives the y array to draw.
+ */
+void series_scaled(const Axes* ax, Series* s, const float** x, const float** y) {
+    *x = s->x;
+    *y = s->y;
+    if (ax->xscale == SCALE_LINEAR && ax->yscale == SCALE_LINEAR) return;
+    if (!s->scaled) {
+        s->scaled = calloc(1, sizeof(ScaleCache));
+        if (!s->scaled) return;
+    }
+    ScaleCache* sc = s->scaled;
+
+    // Histogram, spectrogram and image series rewrite their small arrays in place
+    bool owned = s->hist || s->spectro || s->image;
+    if (!sc->valid || owned || sc->key_x != s->x || sc->key_y != s->y || sc->key_count != s->count ||
+        sc->key_xscale != ax->xscale || sc->key_yscale != ax->yscale ||
+        sc->key_xthresh != ax->x_linthresh || sc->key_ythresh != ax->y_linthresh) {
+        sc->valid = false;
+        if (!scale_grow(sc, s->count)) return;
+        if (ax->xscale != SCALE_LINEAR) scale_bulk(ax->xscale, ax->x_linthresh, s->x, sc->x, s->count);
+        if (ax->yscale != SCALE_LINEAR) scale_bulk(ax->yscale, ax->y_linthresh, s->y, sc->y, s->count);
+        sc->key_x = s->x;
+        sc->key_y = s->y;
+        sc->key_count = s->count;
+        sc->key_xscale = ax->xscale;
+        sc->key_yscale = ax->yscale;
+        sc->key_xthresh = ax->x_linthresh;
+        sc->key_ythresh = ax->y_linthresh;
+        sc->valid = true;
+        runs_invalidate(s->runs); // Same buffers, new contents
+    }
+    if (ax->xscale != SCALE_LINEAR) *x = sc->x;
+    if (ax->yscale != SCALE_LINEAR) *y = sc->y;
+}
+
+/**
+ * @brief Updates an axis' ticks with the locator that matches its scale.
+ * * @param view_min, view_max Visible range in view units (log10 for SCALE_LOG).
+ * @return true if the ticks were regenerated.
+ */
+bool scale_update_ticks(TickCache* tc, AxisScale scale, float linthresh, float view_min, float view_max, float extent_px, float min_spacing_px) {
+    switch (scale) {
+        case SCALE_LOG:    return ticks_update_log(tc, view_min, view_max, extent_px, min_spacing_px);
+        case SCALE_SYMLOG: return ticks_update_symlog(tc, linthresh, view_min, view_max, extent_px, min_spacing_px);
+        default:           return ticks_update_numeric(tc, view_min, view_max, extent_px, min_spacing_px);
+    }
+}
+
+void scale_cache_invalidate(ScaleCache* sc) {
+    if (sc) sc->valid = false;
+}
+
+void scale_cache_destroy(ScaleCache* sc) {
+    if (!sc) return;
+    free(sc->x);
+    free(sc->y);
+    free(sc);
+}
+
+// Drops everything derived from the old mapping and refits the limits
+static void axes_scale_changed(Axes* ax, bool y_axis) {
+    axes_invalidate_ticks(ax, y_axis);
+    for (int l = 0; l < ax->line_count; l++) {
+        scale_cache_invalidate(ax->lines[l].scaled);
+        runs_invalidate(ax->lines[l].runs);
+        pick_invalidate(ax->lines[l].pick);
+        fill_invalidate(ax->lines[l].fill);
+    }
+    axes_autoscale(ax);
+}
+
+/**
+ * @brief Sets how x values map onto the axis (Matplotlib's ax.set_xscale).
+ * * @param ax        Pointer to a 2D Axes.
+ * @param scale     SCALE_LINEAR, SCALE_LOG or SCALE_SYMLOG.
+ * @param linthresh SCALE_SYMLOG only: values within +-linthresh are shown roughly 
+ * linearly (<= 0 = 1.0).
+ * * @note The limits are refitted to the data. On a log axis, points with x <= 0 
+ * are not drawn. Axes linked with axes_share_x() switch along.
+ */
+void set_xscale(Axes* ax, AxisScale scale, float linthresh) {
+    if (!ax) return;
+    // Linked axes change together; the last refit sees every member's new bounds
+    int n = ax->x_link ? ax->x_link->count : 1;
+    for (int i = 0; i < n; i++) {
+        Axes* m = ax->x_link ? ax->x_link->members[i] : ax;
+        m->xscale = scale;
+        m->x_linthresh = linthresh > 0.0f ? linthresh : 1.0f;
+        axes_scale_changed(m, false);
+    }
+}
+
+/**
+ * @brief Sets how y values map onto the axis (Matplotlib's ax.set_yscale).
+ * * @see set_xscale()
+ */
+void set_yscale(Axes* ax, AxisScale scale, float linthresh) {
+    if (!ax) return;
+    int n = ax->y_link ? ax->y_link->count : 1;
+    for (int i = 0; i < n; i++) {
+        Axes* m = ax->y_link ? ax->y_link->members[i] : ax;
+        m->yscale = scale;
+        m->y_linthresh = linthresh > 0.0f ? linthresh : 1.0f;
+        axes_scale_changed(m, true);
+    }
+}
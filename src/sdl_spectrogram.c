@@ -0,0 +1,351 @@
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_spectrogram.h"
+#include "sdl_stream.h"
+#include "sdl_canvas.h"
+#include "sdl_scale.h"
+
+// --- FFT -------------------------------------------------------------------------
+
+/**
+ * @brief Precomputes twiddle factors, the bit-reversal permutation and a Hann window.
+ * * @param plan Plan to fill.
+ * @param n    Transform size (power of two, 4..SPECTROGRAM_MAX_FFT).
+ * @return false if @p n is invalid or allocation fails.
+ */
+bool fft_plan_init(FFTPlan* plan, int n) {
+    memset(plan, 0, sizeof(*plan));
+    if (n < 4 || n > SPECTROGRAM_MAX_FFT || (n & (n - 1)) != 0) return false;
+
+    plan->n = n;
+    while ((1 << plan->log2n) < n) plan->log2n++;
+    plan->cos_table = malloc(sizeof(float) * n / 2);
+    plan->sin_table = malloc(sizeof(float) * n / 2);
+    plan->bitrev = malloc(sizeof(int) * n);
+    plan->window = malloc(sizeof(float) * n);
+    plan->re = malloc(sizeof(float) * n);
+    plan->im = malloc(sizeof(float) * n);
+    if (!plan->cos_table || !plan->sin_table || !plan->bitrev || !plan->window || !plan->re || !plan->im) {
+        fft_plan_free(plan);
+        return false;
+    }
+
+    for (int k = 0; k < n / 2; k++) {
+        double a = 2.0 * M_PI * k / n;
+        plan->cos_table[k] = (float)cos(a);
+        plan->sin_table[k] = (float)sin(a);
+    }
+    for (int i = 0; i < n; i++) {
+        int r = 0;
+        for (int b = 0; b < plan->log2n; b++) r |= ((i >> b) & 1) << (plan->log2n - 1 - b);
+        plan->bitrev[i] = r;
+        plan->window[i] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * i / n));
+    }
+    return true;
+}
+
+void fft_plan_free(FFTPlan* plan) {
+    free(plan->cos_table);
+    free(plan->sin_table);
+    free(plan->bitrev);
+    free(plan->window);
+    free(plan->re);
+    free(plan->im);
+    memset(plan, 0, sizeof(*plan));
+}
+
+/**
+ * @brief In-place iterative radix-2 FFT (decimation in time) on split re/im arrays.
+ * * Keeping real and imaginary parts in separate arrays makes each butterfly loop 
+ * a run of independent multiply-adds over contiguous memory, which compilers 
+ * vectorize; twiddles come from the plan's table (stride n / span).
+ */
+void fft_forward(const FFTPlan* plan, float* re, float* im) {
+    int n = plan->n;
+    for (int i = 0; i < n; i++) {
+        int j = plan->bitrev[i];
+        if (j > i) {
+            float t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    for (int span = 1; span < n; span <<= 1) {
+        int stride = n / (span * 2);
+        for (int start = 0; start < n; start += span * 2) {
+            float* ar = re + start;
+            float* ai = im + start;
+            float* br = re + start + span;
+            float* bi = im + start + span;
+            for (int k = 0; k < span; k++) {
+                float wr = plan->cos_table[k * stride];
+                float wi = -plan->sin_table[k * stride];
+                float tr = br[k] * wr - bi[k] * wi;
+                float ti = br[k] * wi + bi[k] * wr;
+                br[k] = ar[k] - tr;
+                bi[k] = ai[k] - ti;
+                ar[k] += tr;
+                ai[k] += ti;
+            }
+        }
+    }
+}
+
+// --- Spectrogram -----------------------------------------------------------------
+
+static void update_extent(Spectrogram* sp) {
+    double dt = sp->hop / (double)sp->sample_rate;
+    Uint64 shown = sp->columns < (Uint64)sp->history ? sp->columns : (Uint64)sp->history;
+    // Column c is centered at (c * hop + fft_size / 2) / sample_rate
+    double newest = ((double)(sp->columns - 1) * sp->hop + sp->plan.n / 2.0) / sp->sample_rate;
+    sp->extent_x[0] = (float)(newest - (shown - 0.5) * dt);
+    sp->extent_x[1] = (float)(newest + 0.5 * dt);
+    sp->extent_y[0] = 0.0f;
+    sp->extent_y[1] = sp->sample_rate / 2.0f;
+}
+
+// Windowed FFT of the current frame -> one row of colormapped pixels
+static void compute_column(Spectrogram* sp) {
+    FFTPlan* p = &sp->plan;
+    for (int i = 0; i < p->n; i++) {
+        p->re[i] = sp->frame[i] * p->window[i];
+        p->im[i] = 0.0f;
+    }
+    fft_forward(p, p->re, p->im);
+
+    Uint8* row = sp->pixels + (size_t)sp->next_row * sp->bins * 4;
+    float inv_range = 1.0f / (sp->db_max - sp->db_min);
+    for (int k = 0; k < sp->bins; k++) {
+        float power = (p->re[k] * p->re[k] + p->im[k] * p->im[k]) * sp->power_norm;
+        float db = 10.0f * log10f(power + 1e-20f);
+        SDL_Color c = colormap_lookup(sp->lut, (db - sp->db_min) * inv_range);
+        row[k * 4 + 0] = c.r;
+        row[k * 4 + 1] = c.g;
+        row[k * 4 + 2] = c.b;
+        row[k * 4 + 3] = 255;
+    }
+
+    sp->next_row = (sp->next_row + 1) % sp->history;
+    if (sp->pending < sp->history) sp->pending++;
+    sp->columns++;
+}
+
+/**
+ * @brief Feeds input samples, computing a new column every `hop` samples.
+ * * @param sp      Pointer to the Spectrogram.
+ * @param samples Input signal.
+ * @param count   Number of samples.
+ * * @note Render thread only (streams created by spectrogram_stream() are fed 
+ * automatically when the figure drains them).
+ */
+void spectrogram_feed(Spectrogram* sp, const float* samples, size_t count) {
+    if (!sp || !samples) return;
+    int n = sp->plan.n;
+    bool any = false;
+    while (count > 0) {
+        size_t take = (size_t)(n - sp->frame_len);
+        if (take > count) take = count;
+        memcpy(sp->frame + sp->frame_len, samples, sizeof(float) * take);
+        sp->frame_len += (int)take;
+        samples += take;
+        count -= take;
+
+        if (sp->frame_len == n) {
+            compute_column(sp);
+            any = true;
+            // Keep the overlap for the next window
+            memmove(sp->frame, sp->frame + sp->hop, sizeof(float) * (n - sp->hop));
+            sp->frame_len = n - sp->hop;
+        }
+    }
+    if (!any) return;
+
+    // Show the new extents: the series gains its two corner points with the first column
+    update_extent(sp);
+    for (int l = 0; l < sp->ax->line_count; l++) {
+        if (sp->ax->lines[l].spectro == sp) sp->ax->lines[l].count = 2;
+    }
+    if (sp->ax->projection == PROJECTION_2D) axes_autoscale(sp->ax);
+}
+
+/**
+ * @brief Changes the dB range mapped onto the colormap (applies to new columns).
+ */
+void spectrogram_set_range(Spectrogram* sp, float db_min, float db_max) {
+    if (!sp || !(db_max > db_min)) return;
+    sp->db_min = db_min;
+    sp->db_max = db_max;
+}
+
+static Spectrogram* spectrogram_create(Axes* ax, float sample_rate, int fft_size, int hop, int history, Colormap cmap) {
+    if (!(sample_rate > 0) || history <= 0) return NULL;
+    Spectrogram* sp = calloc(1, sizeof(Spectrogram));
+    if (!sp) return NULL;
+    if (!fft_plan_init(&sp->plan, fft_size)) {
+        fprintf(stderr, "spectrogram: FFT size %d must be a power of two between 4 and %d\n", fft_size, SPECTROGRAM_MAX_FFT);
+        free(sp);
+        return NULL;
+    }
+    sp->ax = ax;
+    sp->bins = fft_size / 2;
+    sp->hop = (hop > 0 && hop <= fft_size) ? hop : fft_size / 4;
+    sp->sample_rate = sample_rate;
+    sp->db_min = -120.0f;
+    sp->db_max = 0.0f;
+    sp->lut = colormap_lut(cmap != COLORMAP_NONE ? cmap : COLORMAP_VIRIDIS);
+    sp->history = history;
+    sp->frame = malloc(sizeof(float) * fft_size);
+    sp->pixels = calloc((size_t)history * sp->bins, 4);
+    if (!sp->frame || !sp->pixels) {
+        spectrogram_destroy(sp);
+        return NULL;
+    }
+
+    // A sine of amplitude 1 puts (A * sum(w) / 2)^2 into its bin
+    double wsum = 0.0;
+    for (int i = 0; i < fft_size; i++) wsum += sp->plan.window[i];
+    sp->power_norm = (float)(4.0 / (wsum * wsum));
+    return sp;
+}
+
+// Points the Series at the spectrogram's extents so autoscale frames the image
+static void spectrogram_attach(Series* s, Spectrogram* sp) {
+    s->type = PLOT_SPECTROGRAM;
+    s->spectro = sp;
+    s->x = sp->extent_x;
+    s->y = sp->extent_y;
+    s->count = 0; // Becomes 2 once the first column exists
+}
+
+/**
+ * @brief Adds a spectrogram fed by spectrogram_feed() from the render thread.
+ * * @param ax          Pointer to the Axes (x = time in seconds, y = frequency in Hz).
+ * @param sample_rate Input sample rate in Hz.
+ * @param fft_size    Window length (power of two, e.g. 1024).
+ * @param hop         Samples between columns (<= fft_size; 0 = fft_size / 4).
+ * @param history     Number of columns kept on screen.
+ * @param cmap        Colormap for the magnitudes (COLORMAP_NONE = viridis).
+ * @return The Spectrogram, or NULL on failure.
+ */
+Spectrogram* spectrogram(Axes* ax, float sample_rate, int fft_size, int hop, int history, Colormap cmap) {
+    if (!ax) return NULL;
+    Spectrogram* sp = spectrogram_create(ax, sample_rate, fft_size, hop, history, cmap);
+    if (!sp) return NULL;
+    plot(ax, sp->extent_x, sp->extent_y, 0, (SDL_Color){0, 0, 0, 255});
+    spectrogram_attach(&ax->lines[ax->line_count - 1], sp);
+    return sp;
+}
+
+/**
+ * @brief Adds a spectrogram whose signal is pushed from a producer thread.
+ * * Push the signal with spectrogram_push(). Each frame 
+ * the render thread runs the FFTs for whatever arrived and uploads only the new 
+ * texture rows, so the per-frame cost follows the input rate, not the history.
+ * * @return The stream to push into, or NULL on failure.
+ */
+SeriesStream* spectrogram_stream(Axes* ax, float sample_rate, int fft_size, int hop, int history, Colormap cmap) {
+    if (!ax) return NULL;
+    Spectrogram* sp = spectrogram_create(ax, sample_rate, fft_size, hop, history, cmap);
+    if (!sp) return NULL;
+    // The ring must absorb a few frames of input at the full sample rate
+    int ring = (int)(sample_rate / 4.0f);
+    SeriesStream* st = plot_stream(ax, ring > 1 ? ring : 1, (SDL_Color){0, 0, 0, 255});
+    if (!st) {
+        spectrogram_destroy(sp);
+        return NULL;
+    }
+    spectrogram_attach(&ax->lines[ax->line_count - 1], sp);
+    return st;
+}
+
+/**
+ * @brief Pushes signal samples into a stream created by spectrogram_stream(). Never blocks.
+ * * @return The number of samples accepted (see stream_push()).
+ */
+int spectrogram_push(SeriesStream* stream, const float* samples, int count) {
+    return stream_push(stream, samples, samples, count);
+}
+
+// Uploads rows computed since the last frame (one or two rects around the ring seam)
+static void upload_pending(Spectrogram* sp) {
+    int first = (sp->next_row - sp->pending + sp->history) % sp->history;
+    int n = sp->pending;
+    while (n > 0) {
+        int run = (first + n <= sp->history) ? n : sp->history - first;
+        SDL_Rect r = { 0, first, sp->bins, run };
+        SDL_UpdateTexture(sp->texture, &r, sp->pixels + (size_t)first * sp->bins * 4, sp->bins * 4);
+        first = (first + run) % sp->history;
+        n -= run;
+    }
+    sp->pending = 0;
+}
+
+/**
+ * @brief Draws the spectrogram image (SDL canvases only).
+ * * The texture is a ring of rows, one per column of the image, so scrolling never 
+ * moves pixels: the oldest part (after the ring seam) and the newest part are drawn 
+ * as two textured quads whose texture coordinates transpose rows into screen columns.
+ */
+void render_spectrogram(Canvas* cv, Axes* ax, Series* s, float x_lo, float x_hi, float y_lo, float y_hi) {
+    Spectrogram* sp = s->spectro;
+    if (!sp || !cv->renderer || sp->columns == 0) return;
+
+    // --- STEP 1: Texture (created on first use, on the renderer that draws it) ---
+    if (!sp->texture || sp->texture_owner != cv->renderer) {
+        if (sp->texture) SDL_DestroyTexture(sp->texture);
+        sp->texture = SDL_CreateTexture(cv->renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, sp->bins, sp->history);
+        sp->texture_owner = cv->renderer;
+        if (!sp->texture) return;
+        sp->pending = sp->history; // Everything needs uploading
+    }
+    if (sp->pending > 0) upload_pending(sp);
+
+    // --- STEP 2: Two quads, oldest segment first ---
+    int shown = sp->columns < (Uint64)sp->history ? (int)sp->columns : sp->history;
+    int oldest = (sp->next_row - shown + sp->history) % sp->history;
+    float x_scale = ax->rect.w / (x_hi - x_lo);
+    float y_scale = ax->rect.h / (y_hi - y_lo);
+    float bottom = ax->rect.y + ax->rect.h;
+    // On scaled axes the image is stretched linearly between its mapped edges
+    float y0 = bottom - (axes_ty(ax, sp->extent_y[1]) - y_lo) * y_scale; // Nyquist
+    float y1 = bottom - (axes_ty(ax, sp->extent_y[0]) - y_lo) * y_scale; // DC
+    if (!isfinite(y1)) y1 = bottom; // DC on a log axis
+    float left = ax->rect.x + (axes_tx(ax, sp->extent_x[0]) - x_lo) * x_scale;
+    float col_w = (ax->rect.x + (axes_tx(ax, sp->extent_x[1]) - x_lo) * x_scale - left) / shown;
+
+    SDL_Vertex v[8];
+    int idx[12];
+    int quads = 0, done = 0;
+    while (done < shown) {
+        int row = (oldest + done) % sp->history;
+        int run = (row + (shown - done) <= sp->history) ? shown - done : sp->history - row;
+        float xa = left + done * col_w, xb = left + (done + run) * col_w;
+        float va = (float)row / sp->history, vb = (float)(row + run) / sp->history;
+        SDL_Vertex* q = &v[quads * 4];
+        q[0] = (SDL_Vertex){ { xa, y0 }, { 1, 1, 1, 1 }, { 1.0f, va } };
+        q[1] = (SDL_Vertex){ { xb, y0 }, { 1, 1, 1, 1 }, { 1.0f, vb } };
+        q[2] = (SDL_Vertex){ { xb, y1 }, { 1, 1, 1, 1 }, { 0.0f, vb } };
+        q[3] = (SDL_Vertex){ { xa, y1 }, { 1, 1, 1, 1 }, { 0.0f, va } };
+        int* id = &idx[quads * 6];
+        id[0] = quads * 4; id[1] = quads * 4 + 1; id[2] = quads * 4 + 2;
+        id[3] = quads * 4; id[4] = quads * 4 + 2; id[5] = quads * 4 + 3;
+        quads++;
+        done += run;
+    }
+    canvas_image(cv, sp->texture, v, quads * 4, idx, quads * 6);
+}
+
+/**
+ * @brief Frees a spectrogram and its texture. Called by destroy_figure() before 
+ * the renderer is destroyed.
+ */
+void spectrogram_destroy(Spectrogram* sp) {
+    if (!sp) return;
+    if (sp->texture) SDL_DestroyTexture(sp->texture);
+    fft_plan_free(&sp->plan);
+    free(sp->frame);
+    free(sp->pixels);
+    free(sp);
+}
@@ -0,0 +1,124 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sdl_startup.h"
+#include "sdl_context.h"
+#include "sdl_dpi.h"
+
+// Library-wide driver preference; NULL = DEFAULT_RENDER_DRIVERS
+static char g_render_drivers[128];
+
+/**
+ * @brief Chooses the render drivers new figures try, in order of preference.
+ * * @param drivers Comma-separated SDL driver names (e.g. "vulkan,opengl"), or NULL
+ * to go back to the platform default (DEFAULT_RENDER_DRIVERS).
+ * * @note If none of them works, SDL's default choice is tried, then "software".
+ * Figures that already have a renderer keep it.
+ */
+void set_render_driver(const char* drivers) {
+    snprintf(g_render_drivers, sizeof(g_render_drivers), "%s", drivers ? drivers : "");
+}
+
+// Preference, then SDL's pick (which honors SDL_HINT_RENDER_DRIVER), then software
+static SDL_Renderer* create_renderer(SDL_Window* window) {
+    const char* preferred = g_render_drivers[0] ? g_render_drivers : DEFAULT_RENDER_DRIVERS;
+    // An explicit hint from the environment wins over the built-in default
+    if (!g_render_drivers[0] && SDL_GetHint(SDL_HINT_RENDER_DRIVER)) preferred = NULL;
+
+    SDL_Renderer* renderer = NULL;
+    if (preferred) {
+        renderer = SDL_CreateRenderer(window, preferred);
+        if (!renderer) fprintf(stderr, "Render drivers \"%s\" unavailable (%s), falling back\n", preferred, SDL_GetError());
+    }
+    if (!renderer) renderer = SDL_CreateRenderer(window, NULL);
+    if (!renderer) renderer = SDL_CreateRenderer(window, SDL_SOFTWARE_RENDERER);
+    return renderer;
+}
+
+/**
+ * @brief Opens the figure's font if it hasn't been yet.
+ * * Exports that don't need a window (SVG, software PNG) call this instead of
+ * figure_realize().
+ */
+bool figure_ensure_font(Figure* fig) {
+    if (!fig) return false;
+    if (!fig->font) {
+        Uint64 t0 = SDL_GetTicksNS();
+        fig->font = context_font(CONTEXT_DEFAULT_SIZE); // Shared by all figures, owned by the context
+        fig->timing.font_ns = SDL_GetTicksNS() - t0;
+    }
+    return fig->font != NULL;
+}
+
+/**
+ * @brief Creates the figure's window and renderer on first use.
+ * * subplots() only sets up axes and layout, so programs that just plot and export
+ * never pay for a window they don't need. figure_render() (and so show() and the
+ * FigureManager) realizes figures visibly. Exports that need the GPU renderer
+ * realize them hidden, and the window appears on the first render.
+ * * @param fig     Pointer to the Figure.
+ * @param visible Show the window (a hidden one is shown now).
+ * @return true if the figure has a renderer.
+ */
+bool figure_realize(Figure* fig, bool visible) {
+    if (!fig) return false;
+    if (!fig->window) {
+        figure_ensure_font(fig);
+
+        Uint64 t0 = SDL_GetTicksNS();
+        // Native-resolution framebuffer; at 100% display scale it is the same size anyway
+        SDL_WindowFlags flags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY | (visible ? 0 : SDL_WINDOW_HIDDEN);
+        fig->window = SDL_CreateWindow(fig->title, fig->width, fig->height, flags);
+        Uint64 t1 = SDL_GetTicksNS();
+        fig->timing.window_ns = t1 - t0;
+        if (!fig->window) {
+            fprintf(stderr, "Failed to create window: %s\n", SDL_GetError());
+            return false;
+        }
+        fig->window_id = SDL_GetWindowID(fig->window);
+        fig->window_shown = visible;
+        figure_fit_window(fig);
+
+        fig->renderer = create_renderer(fig->window);
+        fig->timing.renderer_ns = SDL_GetTicksNS() - t1;
+        if (!fig->renderer) {
+            fprintf(stderr, "Failed to create renderer: %s\n", SDL_GetError());
+            return false;
+        }
+        fig->timing.driver = SDL_GetRendererName(fig->renderer);
+        SDL_SetRenderDrawBlendMode(fig->renderer, SDL_BLENDMODE_BLEND); // Ensure it to be true
+        if (fig->vsync != 0) SDL_SetRenderVSync(fig->renderer, fig->vsync);
+        fig->dirty = true;
+    }
+    if (visible && !fig->window_shown) {
+        SDL_ShowWindow(fig->window);
+        fig->window_shown = true;
+    }
+    return fig->renderer != NULL;
+}
+
+/**
+ * @brief Gets the figure's size in layout pixels, with or without a window.
+ * * On HiDPI displays this is smaller than the window's pixel size by the display
+ * scale (see figure_update_scale()).
+ */
+void figure_size(const Figure* fig, int* width, int* height) {
+    *width = *height = 0;
+    if (!fig) return;
+    *width = fig->width;
+    *height = fig->height;
+}
+
+/**
+ * @brief Prints where a figure's startup time went.
+ * * Printed automatically after the first frame when the SDL_GRAPHS_TIMING
+ * environment variable is set. Phases that haven't happened yet print as 0.
+ */
+void figure_print_timing(const Figure* fig) {
+    if (!fig) return;
+    const FigureTiming* t = &fig->timing;
+    printf("Startup: setup %.2f ms, font %.2f ms, window %.2f ms, renderer %.2f ms (%s), first frame at %.2f ms\n",
+           t->setup_ns / 1e6, t->font_ns / 1e6, t->window_ns / 1e6, t->renderer_ns / 1e6,
+           t->driver ? t->driver : "none", t->first_frame_ns / 1e6);
+}
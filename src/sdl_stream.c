@@ -0,0 +1,217 @@
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdl_stream.h"
+#include "sdl_hist.h"
+#include "sdl_spectrogram.h"
+
+// The ring always has room for at least this many samples between two frames
+#define STREAM_MIN_RING 4096
+
+static Uint32 next_pow2(Uint32 n) {
+    Uint32 p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+// Allocates a stream with a ring of at least @p ring samples and registers its series.
+// With values_only there is no x ring and no rolling history: the series consumes
+// the values itself (histograms).
+static SeriesStream* stream_create(Axes* ax, int history, int ring, bool values_only, SDL_Color color) {
+    SeriesStream* st = calloc(1, sizeof(SeriesStream));
+    if (!st) return NULL;
+
+    Uint32 capacity = next_pow2((Uint32)(ring > STREAM_MIN_RING ? ring : STREAM_MIN_RING));
+    st->ring_y = malloc(sizeof(float) * capacity);
+    if (!values_only) {
+        st->ring_x = malloc(sizeof(float) * capacity);
+        st->hist_x = malloc(sizeof(float) * history * 2);
+        st->hist_y = malloc(sizeof(float) * history * 2);
+    }
+    if (!st->ring_y || (!values_only && (!st->ring_x || !st->hist_x || !st->hist_y))) {
+        destroy_stream(st);
+        return NULL;
+    }
+    st->ring_mask = capacity - 1;
+    st->history = values_only ? 0 : history;
+    SDL_SetAtomicU32(&st->head, 0);
+    SDL_SetAtomicU32(&st->tail, 0);
+    SDL_SetAtomicInt(&st->dropped, 0);
+
+    // Register an empty line series and attach the stream to it
+    plot(ax, st->hist_x, st->hist_y, 0, color);
+    ax->lines[ax->line_count - 1].stream = st;
+    return st;
+}
+
+/**
+ * @brief Adds a line series whose data is fed from another thread.
+ * * The returned stream owns the series' sample storage: the Series x/y pointers are 
+ * repointed into its rolling history every time the render thread drains it 
+ * (see figure_render()). Only the most recent @p history samples are displayed.
+ * * @param ax      Pointer to the Axes to add the series to.
+ * @param history Number of samples kept for display (rolling window).
+ * @param color   The SDL_Color of the line.
+ * @return A pointer to the stream that producers push into, or NULL on failure.
+ * * @note Exactly one thread may push into a given stream. The stream is destroyed 
+ * by destroy_figure(); stop the producer thread before that.
+ */
+SeriesStream* plot_stream(Axes* ax, int history, SDL_Color color) {
+    if (!ax || history <= 0) return NULL;
+    return stream_create(ax, history, history, false, color);
+}
+
+/**
+ * @brief Adds a series fed with bare values (no x) from another thread.
+ * * For series that consume the values on the render thread instead of displaying 
+ * them (see hist_stream()). Nothing is kept between frames, so the ring must hold 
+ * everything pushed during one frame.
+ * * @param ax       Pointer to the Axes to add the series to.
+ * @param capacity Values the ring holds between two drains (rounded up to a power of two).
+ * @param color    The SDL_Color of the series.
+ * @return A pointer to the stream to push into with stream_push_values(), or NULL on failure.
+ */
+SeriesStream* plot_value_stream(Axes* ax, int capacity, SDL_Color color) {
+    if (!ax || capacity <= 0) return NULL;
+    return stream_create(ax, 0, capacity, true, color);
+}
+
+// Copies up to @p count samples into the ring and publishes them (x may be NULL)
+static int ring_push(SeriesStream* stream, const float* x, const float* y, int count) {
+    Uint32 capacity = stream->ring_mask + 1;
+    Uint32 head = SDL_GetAtomicU32(&stream->head);
+    Uint32 tail = SDL_GetAtomicU32(&stream->tail);
+    Uint32 space = capacity - (head - tail);
+    Uint32 n = (Uint32)count < space ? (Uint32)count : space;
+
+    // Copy in at most two pieces (before and after the wrap point)
+    Uint32 pos = head & stream->ring_mask;
+    Uint32 first = (n < capacity - pos) ? n : capacity - pos;
+    if (x) {
+        memcpy(stream->ring_x + pos, x, sizeof(float) * first);
+        memcpy(stream->ring_x, x + first, sizeof(float) * (n - first));
+    }
+    memcpy(stream->ring_y + pos, y, sizeof(float) * first);
+    memcpy(stream->ring_y, y + first, sizeof(float) * (n - first));
+
+    // Publish the samples only after they are fully written
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicU32(&stream->head, head + n);
+
+    if (n < (Uint32)count) SDL_AddAtomicInt(&stream->dropped, (int)((Uint32)count - n));
+    return (int)n;
+}
+
+/**
+ * @brief Pushes a batch of samples from the producer thread. Never blocks.
+ * * @param stream Pointer to the SeriesStream.
+ * @param x      Array of x-coordinates.
+ * @param y      Array of y-coordinates.
+ * @param count  Number of samples.
+ * @return The number of samples accepted. If the render thread has fallen behind and 
+ * the ring is full, the remainder is dropped and counted in `stream->dropped`.
+ */
+int stream_push(SeriesStream* stream, const float* x, const float* y, int count) {
+    if (!stream || !stream->ring_x || !x || !y || count <= 0) return 0;
+    return ring_push(stream, x, y, count);
+}
+
+/**
+ * @brief Pushes bare values into a stream from plot_value_stream(). Never blocks.
+ * * @return The number of values accepted; the rest is dropped as in stream_push().
+ */
+int stream_push_values(SeriesStream* stream, const float* values, int count) {
+    if (!stream || !values || count <= 0) return 0;
+    return ring_push(stream, NULL, values, count);
+}
+
+/**
+ * @brief Pushes a single sample from the producer thread. Never blocks.
+ * * @return true if the sample was accepted, false if the ring was full.
+ */
+bool stream_push_sample(SeriesStream* stream, float x, float y) {
+    return stream_push(stream, &x, &y, 1) == 1;
+}
+
+// Appends samples to the rolling history. The backing store holds 2 * history
+// samples so the window only needs to be slid back to the front once every
+// 'history' samples, keeping appends amortized O(1) and the window contiguous.
+static void stream_append(SeriesStream* st, const float* x, const float* y, int n) {
+    if (n >= st->history) {
+        memcpy(st->hist_x, x + (n - st->history), sizeof(float) * st->history);
+        memcpy(st->hist_y, y + (n - st->history), sizeof(float) * st->history);
+        st->start = 0;
+        st->len = st->history;
+        return;
+    }
+    if (st->start + st->len + n > st->history * 2) {
+        memmove(st->hist_x, st->hist_x + st->start, sizeof(float) * st->len);
+        memmove(st->hist_y, st->hist_y + st->start, sizeof(float) * st->len);
+        st->start = 0;
+    }
+    memcpy(st->hist_x + st->start + st->len, x, sizeof(float) * n);
+    memcpy(st->hist_y + st->start + st->len, y, sizeof(float) * n);
+    st->len += n;
+    if (st->len > st->history) {
+        st->start += st->len - st->history;
+        st->len = st->history;
+    }
+}
+
+/**
+ * @brief Drains every pending sample of a streamed series (render thread only).
+ * * Consumes the whole batch published since the last call and repoints the 
+ * Series' x/y/count at the updated rolling window.
+ * * @param s Pointer to a Series created by plot_stream().
+ * @return The number of samples consumed (0 if nothing new arrived).
+ */
+int series_consume_stream(Series* s) {
+    if (!s || !s->stream) return 0;
+    SeriesStream* st = s->stream;
+
+    Uint32 tail = SDL_GetAtomicU32(&st->tail);
+    Uint32 head = SDL_GetAtomicU32(&st->head);
+    SDL_MemoryBarrierAcquire();
+    Uint32 n = head - tail;
+    if (n == 0) return 0;
+
+    Uint32 capacity = st->ring_mask + 1;
+    Uint32 pos = tail & st->ring_mask;
+    Uint32 first = (n < capacity - pos) ? n : capacity - pos;
+    if (s->hist) {
+        // Histogram streams bin the new values straight out of the ring
+        hist_add(s->hist, st->ring_y + pos, first);
+        if (n > first) hist_add(s->hist, st->ring_y, n - first);
+    } else if (s->spectro) {
+        // Spectrogram streams run the FFTs on the new signal; only columns are kept
+        spectrogram_feed(s->spectro, st->ring_y + pos, first);
+        if (n > first) spectrogram_feed(s->spectro, st->ring_y, n - first);
+    } else {
+        stream_append(st, st->ring_x + pos, st->ring_y + pos, (int)first);
+        if (n > first) stream_append(st, st->ring_x, st->ring_y, (int)(n - first));
+    }
+
+    // Hand the slots back to the producer only after we are done reading them
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicU32(&st->tail, tail + n);
+
+    if (!s->hist && !s->spectro) {
+        s->x = st->hist_x + st->start;
+        s->y = st->hist_y + st->start;
+        s->count = st->len;
+    }
+    return (int)n;
+}
+
+/**
+ * @brief Frees a stream and its buffers. Called by destroy_figure().
+ * * @param stream Pointer to the SeriesStream to destroy.
+ */
+void destroy_stream(SeriesStream* stream) {
+    if (!stream) return;
+    free(stream->ring_x);
+    free(stream->ring_y);
+    free(stream->hist_x);
+    free(stream->hist_y);
+    free(stream);
+}
@@ -0,0 +1,203 @@
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdio.h>
+#include "sdl_canvas.h"
+#include "sdl_startup.h"
+
+// SVG backend: every draw command is streamed straight to the output file, so
+// memory use does not depend on the size of the figure's data.
+
+static void svg_paint(FILE* out, const char* attr, SDL_Color c) {
+    fprintf(out, " %s=\"rgb(%d,%d,%d)\"", attr, c.r, c.g, c.b);
+    if (c.a < 255) fprintf(out, " %s-opacity=\"%.3f\"", attr, c.a / 255.0f);
+}
+
+static void svg_set_color(Canvas* cv, SDL_Color color) {
+    (void)cv; (void)color; // Color is emitted per element from cv->color
+}
+
+static void svg_line(Canvas* cv, float x1, float y1, float x2, float y2) {
+    fprintf(cv->out, "<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\"", x1, y1, x2, y2);
+    svg_paint(cv->out, "stroke", cv->color);
+    fputs("/>\n", cv->out);
+}
+
+// One <polyline> element per call (i.e. per series), never one element per segment
+static void svg_polyline(Canvas* cv, const SDL_FPoint* pts, int count, float thickness, LineStyle style) {
+    FILE* out = cv->out;
+    fputs("<polyline fill=\"none\" stroke-linejoin=\"round\" stroke-linecap=\"round\"", out);
+    svg_paint(out, "stroke", cv->color);
+    fprintf(out, " stroke-width=\"%.2f\"", thickness > 1.0f ? thickness : 1.0f);
+    if (style == STYLE_DASHED) fputs(" stroke-dasharray=\"10,5\"", out);
+    if (style == STYLE_DOTTED) fputs(" stroke-dasharray=\"3,3\"", out);
+    fputs(" points=\"", out);
+    for (int i = 0; i < count; i++) {
+        fprintf(out, "%.2f,%.2f%s", pts[i].x, pts[i].y, (i % 8 == 7) ? "\n" : " ");
+    }
+    fputs("\"/>\n", out);
+}
+
+static void svg_rect(Canvas* cv, const SDL_FRect* r, bool filled) {
+    fprintf(cv->out, "<rect x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\"", r->x, r->y, r->w, r->h);
+    if (filled) {
+        svg_paint(cv->out, "fill", cv->color);
+    } else {
+        fputs(" fill=\"none\"", cv->out);
+        svg_paint(cv->out, "stroke", cv->color);
+    }
+    fputs("/>\n", cv->out);
+}
+
+// All markers of a series become sub-paths of a single <path>
+static void svg_markers(Canvas* cv, const SDL_FPoint* centers, int count, float size) {
+    FILE* out = cv->out;
+    float half = size / 2.0f;
+    fputs("<path", out);
+    svg_paint(out, "fill", cv->color);
+    fputs(" d=\"", out);
+    for (int i = 0; i < count; i++) {
+        fprintf(out, "M%.2f %.2fh%.2fv%.2fh%.2fz%s", centers[i].x - half, centers[i].y - half,
+                size, size, -size, (i % 8 == 7) ? "\n" : "");
+    }
+    fputs("\"/>\n", out);
+}
+
+// Triangles are grouped into one <path> per run of identically colored vertices
+static void svg_geometry(Canvas* cv, const SDL_Vertex* v, int num_vertices, const int* indices, int num_indices) {
+    FILE* out = cv->out;
+    int tri_count = indices ? num_indices / 3 : num_vertices / 3;
+    SDL_FColor current = { -1, -1, -1, -1 };
+    bool open = false;
+
+    for (int t = 0; t < tri_count; t++) {
+        int a = indices ? indices[t * 3] : t * 3;
+        int b = indices ? indices[t * 3 + 1] : t * 3 + 1;
+        int c = indices ? indices[t * 3 + 2] : t * 3 + 2;
+        SDL_FColor fc = v[a].color;
+        if (fc.r != current.r || fc.g != current.g || fc.b != current.b || fc.a != current.a) {
+            if (open) fputs("\"/>\n", out);
+            SDL_Color col = { (Uint8)(fc.r * 255.0f), (Uint8)(fc.g * 255.0f), (Uint8)(fc.b * 255.0f), (Uint8)(fc.a * 255.0f) };
+            fputs("<path", out);
+            svg_paint(out, "fill", col);
+            fputs(" d=\"", out);
+            current = fc;
+            open = true;
+        }
+        fprintf(out, "M%.2f %.2fL%.2f %.2fL%.2f %.2fz",
+                v[a].position.x, v[a].position.y, v[b].position.x, v[b].position.y,
+                v[c].position.x, v[c].position.y);
+    }
+    if (open) fputs("\"/>\n", out);
+}
+
+static void svg_image(Canvas* cv, SDL_Texture* texture, const SDL_Vertex* v, int num_vertices, const int* indices, int num_indices) {
+    (void)cv; (void)texture; (void)v; (void)num_vertices; (void)indices; (void)num_indices; // GPU-only content
+}
+
+static void svg_text(Canvas* cv, const char* text, float x, float y, bool right_align, SDL_Color color) {
+    FILE* out = cv->out;
+    float size = cv->font ? TTF_GetFontSize(cv->font) : 16.0f;
+    fprintf(out, "<text x=\"%.2f\" y=\"%.2f\" font-size=\"%.1f\" text-anchor=\"%s\" dominant-baseline=\"central\"",
+            x, y, size, right_align ? "end" : "middle");
+    svg_paint(out, "fill", color);
+    fputc('>', out);
+    for (const char* p = text; *p; p++) {
+        switch (*p) {
+            case '&': fputs("&amp;", out); break;
+            case '<': fputs("&lt;", out); break;
+            case '>': fputs("&gt;", out); break;
+            case '"': fputs("&quot;", out); break;
+            default: fputc(*p, out); break;
+        }
+    }
+    fputs("</text>\n", out);
+}
+
+static void svg_tick_label(Canvas* cv, TickCache* tc, int i, float x, float y, bool right_align, SDL_Color color) {
+    svg_text(cv, tc->labels[i], x, y, right_align, color);
+}
+
+static const CanvasOps svg_canvas_ops = {
+    svg_set_color, svg_line, svg_polyline, svg_rect, svg_markers, svg_geometry, svg_image, svg_text, svg_tick_label
+};
+
+/**
+ * @brief Starts an SVG document and prepares a Canvas that streams into it.
+ * * @param cv     Pointer to the Canvas to initialize.
+ * @param out    An open, writable file.
+ * @param width  Document width in pixels.
+ * @param height Document height in pixels.
+ * @param font   Font used for text metrics (its point size is used for <text>).
+ * @param arena  Scratch memory used by the shared render path.
+ * @return true if the header was written.
+ */
+bool canvas_begin_svg(Canvas* cv, FILE* out, float width, float height, TTF_Font* font, FrameArena* arena) {
+    if (!cv || !out) return false;
+    cv->ops = &svg_canvas_ops;
+    cv->color = (SDL_Color){0, 0, 0, 255};
+    cv->font = font;
+    cv->arena = arena;
+    cv->renderer = NULL;
+    cv->out = out;
+    cv->raster = NULL;
+    cv->width = width;
+    cv->height = height;
+    cv->scale = 1.0f;
+    cv->origin_x = cv->origin_y = 0.0f;
+    cv->text_font = NULL;
+    fprintf(out, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                 "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.0f\" height=\"%.0f\" viewBox=\"0 0 %.0f %.0f\" "
+                 "font-family=\"PT Sans Caption, PT Sans, sans-serif\">\n", width, height, width, height);
+    return fprintf(out, "<rect width=\"100%%\" height=\"100%%\" fill=\"white\"/>\n") > 0;
+}
+
+/**
+ * @brief Closes the SVG document started by canvas_begin_svg().
+ * * @param cv Pointer to the SVG Canvas. The output file is not closed.
+ */
+void canvas_end_svg(Canvas* cv) {
+    if (!cv || !cv->out) return;
+    fputs("</svg>\n", cv->out);
+    cv->out = NULL;
+}
+
+/**
+ * @brief Exports the figure as a scalable SVG file.
+ * * Renders every Axes through the same draw-command path as the window, but into
+ * the streaming SVG backend. Each line series becomes a single <polyline> and each
+ * scatter series a single <path>; long series are decimated to at most a few points
+ * per pixel column first, so file size tracks the figure size rather than the
+ * number of samples.
+ * * @param fig      Pointer to the Figure to export.
+ * @param filename Destination path (e.g. "figure.svg").
+ * @return true on success.
+ */
+bool save_figure_as_svg(Figure* fig, const char* filename) {
+    if (!fig || !filename) return false;
+
+    FILE* out = fopen(filename, "w");
+    if (!out) {
+        fprintf(stderr, "Failed to open %s for writing\n", filename);
+        return false;
+    }
+
+    int w = 0, h = 0;
+    figure_size(fig, &w, &h);
+    update_layout(fig, w, h); // No window needed: the figure may never have been drawn
+
+    Canvas cv;
+    canvas_begin_svg(&cv, out, (float)w, (float)h, fig->font, &fig->frame_arena);
+    for (int i = 0; i < fig->axes_count; i++) {
+        render_axes_canvas(&cv, &fig->axes[i]);
+    }
+    canvas_end_svg(&cv);
+
+    bool ok = !ferror(out);
+    if (fclose(out) != 0) ok = false;
+    if (ok) {
+        printf("Graph saved successfully to %s\n", filename);
+    } else {
+        fprintf(stderr, "Failed to write SVG to %s\n", filename);
+    }
+    return ok;
+}
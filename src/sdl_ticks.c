@@ -0,0 +1,383 @@
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include "sdl_ticks.h"
+
+// Minimum horizontal room for one "HH:MM:SS.mmm" style label, in pixels
+#define TIME_TICK_MIN_SPACING 100.0f
+
+#define SECONDS_PER_DAY 86400.0
+
+// Calendar-friendly steps (seconds): ms, s, min, h and day multiples
+static const double time_steps[] = {
+    0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5,
+    1, 2, 5, 10, 15, 30,
+    60, 120, 300, 600, 900, 1800,
+    3600, 7200, 10800, 21600, 43200,
+    86400, 172800, 604800
+};
+
+static int max_ticks_for_extent(float extent_px, float min_spacing) {
+    int n = (int)(extent_px / min_spacing) + 1;
+    if (n < 2) n = 2;
+    if (n > MAX_TICKS) n = MAX_TICKS;
+    return n;
+}
+
+/**
+ * @brief Destroys the cached label textures but keeps the ticks (e.g. when the font changes).
+ */
+void ticks_release_textures(TickCache* tc) {
+    for (int i = 0; i < MAX_TICKS; i++) {
+        if (tc->textures[i]) {
+            SDL_DestroyTexture(tc->textures[i]);
+            tc->textures[i] = NULL;
+        }
+    }
+}
+
+// Starts a regeneration: records the new cache key and drops stale labels
+static void ticks_begin(TickCache* tc, float view_min, float view_max, float extent_px, double origin) {
+    ticks_release_textures(tc);
+    tc->valid = true;
+    tc->key_min = view_min;
+    tc->key_max = view_max;
+    tc->key_extent = extent_px;
+    tc->key_origin = origin;
+    tc->count = 0;
+}
+
+/**
+ * @brief Puts a freshly allocated TickCache into a known empty state.
+ * * @param tc Pointer to the TickCache to initialize (contents may be uninitialized).
+ */
+void ticks_init(TickCache* tc) {
+    if (!tc) return;
+    memset(tc, 0, sizeof(*tc));
+}
+
+/**
+ * @brief Marks a tick cache as stale so the next update recomputes it.
+ * * Any cached label textures are destroyed, so this must be called before the 
+ * renderer that created them is destroyed.
+ * * @param tc Pointer to the TickCache to invalidate.
+ */
+void ticks_invalidate(TickCache* tc) {
+    if (!tc) return;
+    ticks_release_textures(tc);
+    tc->valid = false;
+    tc->count = 0;
+}
+
+// Fills 1/2/5 x 10^k ticks over [view_min, view_max] (the cache key is set by the caller)
+static void fill_numeric(TickCache* tc, double view_min, double view_max, float extent_px, float min_spacing_px) {
+    double span = view_max - view_min;
+    if (!(span > 0) || !isfinite(span)) return;
+
+    int max_ticks = max_ticks_for_extent(extent_px, min_spacing_px > 1.0f ? min_spacing_px : 1.0f);
+    double raw = span / (max_ticks - 1);
+    double mag = pow(10.0, floor(log10(raw)));
+    double norm = raw / mag;
+    double nice = (norm <= 1.0) ? 1.0 : (norm <= 2.0) ? 2.0 : (norm <= 5.0) ? 5.0 : 10.0;
+    double step = nice * mag;
+    tc->step = step;
+
+    // Enough decimals to resolve the step, e.g. step 0.25 -> 2 decimals
+    int decimals = (int)ceil(-log10(step) - 1e-9);
+    if (decimals < 0) decimals = 0;
+    if (decimals > 9) decimals = 9;
+    double largest = fabs(view_min) > fabs(view_max) ? fabs(view_min) : fabs(view_max);
+    bool scientific = largest >= 1e7 || step < 1e-6;
+
+    double first = ceil(view_min / step) * step;
+    double last = view_max + step * 1e-6;
+    for (int i = 0; tc->count < MAX_TICKS; i++) {
+        double v = first + i * step;
+        if (v > last) break;
+        if (fabs(v) < step * 1e-6) v = 0.0; // Avoid "-0.0"
+        tc->values[tc->count] = (float)v;
+        if (scientific) {
+            snprintf(tc->labels[tc->count], TICK_LABEL_LEN, "%.3g", v);
+        } else {
+            snprintf(tc->labels[tc->count], TICK_LABEL_LEN, "%.*f", decimals, v);
+        }
+        tc->count++;
+    }
+}
+
+/**
+ * @brief Recomputes numeric tick positions and labels if the view has changed.
+ * * Picks the smallest "nice" step (1, 2 or 5 x 10^k) that keeps ticks at least 
+ * @p min_spacing_px apart, so labels read 0/0.5/1.0 rather than 1.3/2.6/3.9. 
+ * Labels are formatted with just enough decimals to distinguish neighbouring ticks.
+ * * @param tc             Pointer to the TickCache to fill.
+ * @param view_min       Smallest visible data value.
+ * @param view_max       Largest visible data value.
+ * @param extent_px      Length of the axis in pixels.
+ * @param min_spacing_px Minimum distance between ticks (derived from font metrics by the caller).
+ * @return true if the ticks were regenerated, false if the cached ticks were reused.
+ */
+bool ticks_update_numeric(TickCache* tc, float view_min, float view_max, float extent_px, float min_spacing_px) {
+    if (!tc) return false;
+    if (tc->valid && tc->key_min == view_min && tc->key_max == view_max &&
+        tc->key_extent == extent_px && tc->key_origin == 0.0) {
+        return false;
+    }
+    ticks_begin(tc, view_min, view_max, extent_px, 0.0);
+    fill_numeric(tc, view_min, view_max, extent_px, min_spacing_px);
+    return true;
+}
+
+// "1000", "0.01" for moderate exponents, "1e6" / "2e-5" beyond
+static void format_log_label(char* buf, int mantissa, int exponent) {
+    if (exponent >= -3 && exponent <= 4) {
+        snprintf(buf, TICK_LABEL_LEN, "%g", mantissa * pow(10.0, exponent));
+    } else {
+        snprintf(buf, TICK_LABEL_LEN, "%de%d", mantissa, exponent);
+    }
+}
+
+// Ticks at m * 10^k for the given mantissas, every 'stride' decades
+static void fill_log(TickCache* tc, double lo, double hi, const int* mantissas, int n_mant, int stride) {
+    int k0 = (int)floor(lo);
+    k0 -= ((k0 % stride) + stride) % stride; // Keep strided decades aligned (1, 1e3, 1e6, ...)
+    for (int k = k0; k <= (int)ceil(hi) && tc->count < MAX_TICKS; k += stride) {
+        for (int j = 0; j < n_mant && tc->count < MAX_TICKS; j++) {
+            double t = k + log10((double)mantissas[j]);
+            if (t < lo - 1e-9 || t > hi + 1e-9) continue;
+            tc->values[tc->count] = (float)(mantissas[j] * pow(10.0, k));
+            format_log_label(tc->labels[tc->count], mantissas[j], k);
+            tc->count++;
+        }
+    }
+}
+
+/**
+ * @brief Recomputes ticks for a log10 axis if the view has changed.
+ * * Ticks sit on whole decades (every 2nd, 3rd, ... decade when the axis is 
+ * short), on 1/2/5 multiples when less than two decades are visible, and fall 
+ * back to the linear locator within a single decade. Tick values are data values; 
+ * the renderer maps them through the scale like any other point.
+ * * @param tc             Pointer to the TickCache to fill.
+ * @param view_min       Bottom of the view, in log10 units.
+ * @param view_max       Top of the view, in log10 units.
+ * @param extent_px      Length of the axis in pixels.
+ * @param min_spacing_px Minimum distance between ticks.
+ * @return true if the ticks were regenerated.
+ */
+bool ticks_update_log(TickCache* tc, float view_min, float view_max, float extent_px, float min_spacing_px) {
+    if (!tc) return false;
+    if (tc->valid && tc->key_min == view_min && tc->key_max == view_max &&
+        tc->key_extent == extent_px && tc->key_origin == TICKS_KEY_LOG) {
+        return false;
+    }
+    ticks_begin(tc, view_min, view_max, extent_px, TICKS_KEY_LOG);
+
+    double span = (double)view_max - (double)view_min;
+    if (!(span > 0) || !isfinite(span)) return true;
+    int max_ticks = max_ticks_for_extent(extent_px, min_spacing_px > 1.0f ? min_spacing_px : 1.0f);
+    int decades = (int)floor(view_max) - (int)ceil(view_min) + 1;
+
+    if (decades >= 2) {
+        int stride = (decades + max_ticks - 1) / max_ticks;
+        static const int one[] = { 1 };
+        fill_log(tc, view_min, view_max, one, 1, stride > 0 ? stride : 1);
+        tc->step = stride;
+        return true;
+    }
+    static const int one_two_five[] = { 1, 2, 5 };
+    fill_log(tc, view_min, view_max, one_two_five, 3, 1);
+    if (tc->count < 2 || tc->count > max_ticks) {
+        tc->count = 0;
+        fill_numeric(tc, pow(10.0, view_min), pow(10.0, view_max), extent_px, min_spacing_px);
+    }
+    return true;
+}
+
+/**
+ * @brief Recomputes ticks for a symlog axis if the view has changed.
+ * * Ticks go at 0 and at +-linthresh * 10^k, thinned to every n-th decade so they 
+ * stay @p min_spacing_px apart.
+ * * @param tc        Pointer to the TickCache to fill.
+ * @param linthresh Linear half-width of the scale.
+ * @param view_min  Bottom of the view, in symlog units.
+ * @param view_max  Top of the view, in symlog units.
+ * @return true if the ticks were regenerated.
+ */
+bool ticks_update_symlog(TickCache* tc, float linthresh, float view_min, float view_max, float extent_px, float min_spacing_px) {
+    if (!tc) return false;
+    if (tc->valid && tc->key_min == view_min && tc->key_max == view_max &&
+        tc->key_extent == extent_px && tc->key_origin == TICKS_KEY_SYMLOG - linthresh) {
+        return false;
+    }
+    ticks_begin(tc, view_min, view_max, extent_px, TICKS_KEY_SYMLOG - linthresh);
+
+    double span = (double)view_max - (double)view_min;
+    if (!(span > 0) || !isfinite(span) || !(linthresh > 0)) return true;
+    int max_ticks = max_ticks_for_extent(extent_px, min_spacing_px > 1.0f ? min_spacing_px : 1.0f);
+
+    // Candidate ticks in view units: t(v) = sign(v) * log10(1 + |v| / linthresh)
+    double cand_v[2 * 40 + 1];
+    int n = 0;
+    for (int k = 39; k >= 0; k--) {
+        double v = linthresh * pow(10.0, k);
+        double t = log10(1.0 + v / linthresh);
+        if (-t >= view_min - 1e-9 && -t <= view_max + 1e-9) cand_v[n++] = -v;
+    }
+    if (view_min <= 0.0f && view_max >= 0.0f) cand_v[n++] = 0.0;
+    for (int k = 0; k < 40; k++) {
+        double v = linthresh * pow(10.0, k);
+        double t = log10(1.0 + v / linthresh);
+        if (t >= view_min - 1e-9 && t <= view_max + 1e-9) cand_v[n++] = v;
+    }
+
+    int stride = (n + max_ticks - 1) / max_ticks;
+    if (stride < 1) stride = 1;
+    tc->step = stride;
+    for (int i = 0; i < n && tc->count < MAX_TICKS; i++) {
+        // Thin by decade, keeping 0 and whatever is aligned with it
+        int decade = (cand_v[i] == 0.0) ? 0 : (int)lround(log10(fabs(cand_v[i]) / linthresh));
+        if (decade % stride != 0) continue;
+        tc->values[tc->count] = (float)cand_v[i];
+        snprintf(tc->labels[tc->count], TICK_LABEL_LEN, "%g", cand_v[i]);
+        tc->count++;
+    }
+    return true;
+}
+
+static double choose_time_step(double span, int max_ticks) {
+    int n = (int)(sizeof(time_steps) / sizeof(time_steps[0]));
+    for (int i = 0; i < n; i++) {
+        if (span / time_steps[i] <= max_ticks - 1) return time_steps[i];
+    }
+
+    // Longer than a few weeks: fall back to 1/2/5 x 10^k days
+    double days = span / SECONDS_PER_DAY / (max_ticks - 1);
+    double mag = pow(10.0, floor(log10(days)));
+    double norm = days / mag;
+    double nice = (norm <= 1.0) ? 1.0 : (norm <= 2.0) ? 2.0 : (norm <= 5.0) ? 5.0 : 10.0;
+    return nice * mag * SECONDS_PER_DAY;
+}
+
+/**
+ * @brief Recomputes time-axis tick positions and labels if the view has changed.
+ * * Ticks land on calendar boundaries (whole milliseconds, seconds, minutes, hours or
+ * UTC days) chosen so that labels never get closer than TIME_TICK_MIN_SPACING pixels.
+ * The result is cached in @p tc; while the view limits, pixel extent and origin stay
+ * the same this function returns immediately without formatting anything.
+ * * @param tc        Pointer to the TickCache to fill.
+ * @param origin    Epoch time (seconds, UTC) that a data value of 0 corresponds to.
+ * @param view_min  Smallest visible data value (seconds relative to origin).
+ * @param view_max  Largest visible data value (seconds relative to origin).
+ * @param extent_px Length of the axis in pixels.
+ * @return true if the ticks were regenerated, false if the cached ticks were reused.
+ */
+bool ticks_update_time(TickCache* tc, double origin, float view_min, float view_max, float extent_px) {
+    if (!tc) return false;
+    if (tc->valid && tc->key_min == view_min && tc->key_max == view_max &&
+        tc->key_extent == extent_px && tc->key_origin == origin) {
+        return false;
+    }
+
+    ticks_begin(tc, view_min, view_max, extent_px, origin);
+
+    double span = (double)view_max - (double)view_min;
+    if (!(span > 0) || !isfinite(span)) return true;
+
+    double step = choose_time_step(span, max_ticks_for_extent(extent_px, TIME_TICK_MIN_SPACING));
+    tc->step = step;
+
+    // Align to absolute time so that e.g. hourly ticks sit on the hour
+    double first = ceil((origin + view_min) / step) * step;
+    double last = origin + view_max + step * 1e-6;
+    for (int i = 0; tc->count < MAX_TICKS; i++) {
+        double t = first + i * step;
+        if (t > last) break;
+        tc->values[tc->count] = (float)(t - origin);
+        format_time_label(tc->labels[tc->count], TICK_LABEL_LEN, t, step);
+        tc->count++;
+    }
+    return true;
+}
+
+// Days since 1970-01-01 -> proleptic Gregorian date (H. Hinnant's civil_from_days)
+static void civil_from_days(long long z, int* year, int* month, int* day) {
+    z += 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    *day = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *month = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *year = (int)((long long)yoe + era * 400 + (*month <= 2));
+}
+
+static char* put_digits(char* p, int value, int width) {
+    for (int i = width - 1; i >= 0; i--) {
+        p[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    return p + width;
+}
+
+/**
+ * @brief Formats an epoch timestamp as a tick label without allocating or calling printf.
+ * * The precision follows the tick spacing:
+ * - step < 1 s:    "HH:MM:SS.mmm"
+ * - step < 1 min:  "HH:MM:SS"
+ * - step < 1 day:  "HH:MM" (or "MM-DD" for ticks that fall exactly on midnight)
+ * - otherwise:     "YYYY-MM-DD"
+ * * @param buf           Destination buffer.
+ * @param cap           Size of the destination buffer in bytes.
+ * @param epoch_seconds Timestamp in seconds since 1970-01-01 UTC.
+ * @param step          Tick spacing in seconds, used to pick the precision.
+ * @return The number of characters written (excluding the terminator).
+ * * @note All times are UTC; no time-zone database is consulted.
+ */
+size_t format_time_label(char* buf, size_t cap, double epoch_seconds, double step) {
+    if (!buf || cap == 0) return 0;
+
+    double whole = floor(epoch_seconds);
+    int ms = (int)((epoch_seconds - whole) * 1000.0 + 0.5);
+    long long secs = (long long)whole;
+    if (ms >= 1000) { secs++; ms -= 1000; }
+
+    long long days = secs / 86400;
+    long long sod = secs % 86400;
+    if (sod < 0) { sod += 86400; days--; }
+    int hh = (int)(sod / 3600), mm = (int)(sod / 60 % 60), ss = (int)(sod % 60);
+
+    char tmp[TICK_LABEL_LEN];
+    char* p = tmp;
+    if (step >= SECONDS_PER_DAY || (step >= 60.0 && sod == 0 && ms == 0)) {
+        int year, month, day;
+        civil_from_days(days, &year, &month, &day);
+        if (step >= SECONDS_PER_DAY) {
+            if (year < 0) { *p++ = '-'; year = -year; }
+            p = put_digits(p, year % 10000, 4);
+            *p++ = '-';
+        }
+        p = put_digits(p, month, 2);
+        *p++ = '-';
+        p = put_digits(p, day, 2);
+    } else {
+        p = put_digits(p, hh, 2);
+        *p++ = ':';
+        p = put_digits(p, mm, 2);
+        if (step < 60.0) {
+            *p++ = ':';
+            p = put_digits(p, ss, 2);
+            if (step < 1.0) {
+                *p++ = '.';
+                p = put_digits(p, ms, 3);
+            }
+        }
+    }
+
+    size_t len = (size_t)(p - tmp);
+    if (len >= cap) len = cap - 1;
+    memcpy(buf, tmp, len);
+    buf[len] = '\0';
+    return len;
+}
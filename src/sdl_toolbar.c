@@ -4,6 +4,9 @@
 #include <stdio.h>
 #include "sdl_toolbar.h"
 #include "sdl_graphs.h"
+#include "sdl_context.h"
+#include "sdl_camera.h"
+#include "sdl_fill.h"
 #include <math.h>
 
 /**
@@ -222,14 +225,17 @@ void render_toolbar(Toolbar* tb, TTF_Font* font) {
  * - **Actions**: Triggering the "Save as PNG" functionality.
  * * @param tb Pointer to the Toolbar instance.
  * @param event Pointer to the SDL_Event to be processed.
+ * @return true if an axes or series was restyled (its cached images are dropped here).
  * * @note This function filters events by window ID to ensure the toolbar only 
  * responds to interactions within its own window.
  */
-void handle_toolbar_events(Toolbar* tb, SDL_Event* event) {
-    if (!tb || !event) return;
+bool handle_toolbar_events(Toolbar* tb, SDL_Event* event) {
+    if (!tb || !event) return false;
+    Axes* edited_ax = NULL;      // Axes whose look changed
+    Series* edited = NULL;       // Series whose look changed
     // 1. BUTTON CLICKS (Style)
     if (event->type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
-        if (event->button.windowID != SDL_GetWindowID(tb->window)) return;
+        if (event->button.windowID != SDL_GetWindowID(tb->window)) return false;
         
         float mx = event->button.x;
         float my = event->button.y;
@@ -270,6 +276,7 @@ void handle_toolbar_events(Toolbar* tb, SDL_Event* event) {
                 if (point_in_frect(mx, my, tb->color_swatches[i].rect)){
                     if (current_ax->line_count > 0) {
                         tb->target_fig->axes[tb->active_axes_idx].lines[tb->active_line_idx].color = tb->color_swatches[i].color;
+                        edited = &current_ax->lines[tb->active_line_idx];
                     }
                 }                
             }
@@ -280,6 +287,7 @@ void handle_toolbar_events(Toolbar* tb, SDL_Event* event) {
                 if (point_in_frect(mx, my, tb->buttons[i].rect)){
                     if (current_ax->line_count > 0) {
                         current_ax->lines[tb->active_line_idx].style = tb->buttons[i].action_id;
+                        edited = &current_ax->lines[tb->active_line_idx];
                     }
                 }
             }
@@ -297,6 +305,7 @@ void handle_toolbar_events(Toolbar* tb, SDL_Event* event) {
         // Grid
         if (point_in_frect(mx, my, tb->grid_toggle.rect)){
             current_ax->show_grid = !current_ax->show_grid;
+            edited_ax = current_ax;
         }
         // 2. Save Button
         if (point_in_frect(mx, my, tb->save_button.rect)){
@@ -319,12 +328,22 @@ void handle_toolbar_events(Toolbar* tb, SDL_Event* event) {
             
             float new_thickness = 1.0f + (s->value * 9.0f);
             current_ax->lines[tb->active_line_idx].thickness = new_thickness;
+            edited = &current_ax->lines[tb->active_line_idx];
         }
     }
 
     if (event->type == SDL_EVENT_MOUSE_BUTTON_UP) {
         tb->thickness_slider.is_dragging = false;
     }
+
+    // Only what was restyled is rebuilt: colors are baked into fill batches and 3D
+    // images, while pick/run/scale indexes depend on the data alone and are kept
+    if (edited) {
+        edited_ax = &tb->target_fig->axes[tb->active_axes_idx];
+        fill_invalidate(edited->fill);
+    }
+    if (edited_ax) axes_invalidate_cache(edited_ax);
+    return edited_ax != NULL;
 }
 
 /**
@@ -341,6 +360,7 @@ void destroy_toolbar(Toolbar* tb) {
 
     // 1. Destroy the SDL objects for the toolbar window
     if (tb->renderer) {
+        context_release_renderer(tb->renderer); // Glyph atlases live on this renderer
         SDL_DestroyRenderer(tb->renderer);
     }
     if (tb->window) {